@@ -0,0 +1,156 @@
+#pragma once
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+
+/**
+* @brief Thread pool that runs small jobs on all cores.
+*
+* Every worker has its own job queue. A worker runs the newest job of its own queue first
+* and steals the oldest job of another queue when its own is empty, so jobs that spawn
+* jobs stay on the same worker and idle workers take the large, old chunks of work.
+* Jobs scheduled from other threads (main thread) go into a shared queue.
+*
+* Jobs can be grouped with a Counter, waited on and used as dependency of other jobs.
+* A thread that waits helps running jobs instead of blocking, a worker runs any job,
+* other threads only the jobs of the counter they wait for.
+*
+* Example:
+* 
+*   JobSystem::Counter counter;
+* 
+*   jobs.Schedule([]() { BuildPaths(); }, &counter);
+* 
+*   jobs.ScheduleAfter(counter, []() { MoveUnits(); });
+* 
+*   jobs.Wait(counter);
+*/
+class JobSystem {
+public:
+    using JobFunc = std::function<void()>;
+
+private:
+    struct Job;
+
+public:
+    /**
+    * @brief Counts the unfinished jobs that were scheduled with it.
+    *
+    * The counter has to outlive its jobs. It can be reused once it is done.
+    */
+    class Counter {
+        friend class JobSystem;
+    public:
+        Counter() = default;
+        Counter(const Counter&) = delete;
+        Counter& operator=(const Counter&) = delete;
+
+        /**
+        * @brief Returns true if all jobs of this counter are finished
+        */
+        bool IsDone() const;
+
+        /**
+        * @brief Returns the number of unfinished jobs
+        */
+        uint32_t GetCount() const;
+
+    private:
+        std::atomic<uint32_t> m_count = 0;
+        std::atomic<uint32_t> m_finishing = 0;// jobs that still access the counter after their decrement
+        std::mutex m_mutex;
+        std::vector<Job> m_continuations;// jobs that wait for this counter
+    };
+
+    JobSystem();
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+    * @brief Starts the worker threads, a running pool is shut down first.
+    * Must not be called while jobs are scheduled from other threads
+    * @param workerCount number of threads, 0 = jobs only run in Wait and RunPendingJob
+    */
+    void Init(size_t workerCount);
+
+    /**
+    * @brief Runs all remaining jobs and stops the worker threads
+    */
+    void Shutdown();
+
+    bool IsRunning() const;
+    size_t GetWorkerCount() const;
+
+    /**
+    * @brief Returns true if the calling thread is a worker of this job system
+    */
+    bool IsWorkerThread() const;
+
+    /**
+    * @brief Schedules a job
+    * @param counter optional, is incremented now and decremented when the job is done
+    */
+    void Schedule(JobFunc job, Counter* counter = nullptr);
+
+    /**
+    * @brief Schedules a job that starts once all jobs of dependency are done
+    * @param counter optional, is incremented now and decremented when the job is done
+    */
+    void ScheduleAfter(Counter& dependency, JobFunc job, Counter* counter = nullptr);
+
+    /**
+    * @brief Calls func(begin, end) for batches of [0, count) in parallel and waits until all are done.
+    * The calling thread runs batches as well
+    * @param batchSize number of indices per job, at least 1
+    */
+    void ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t begin, size_t end)>& func);
+
+    /**
+    * @brief Waits until all jobs of the counter are done, the calling thread runs pending jobs in the meantime.
+    * A non worker thread only runs jobs of the counter (any job if the pool has no workers)
+    */
+    void Wait(Counter& counter);
+
+    /**
+    * @brief Runs one pending job on the calling thread
+    * @return false if no job was pending
+    */
+    bool RunPendingJob();
+
+private:
+    struct Job {
+        JobFunc func;
+        Counter* counter = nullptr;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // 0 = shared queue of non worker threads, 1..n = worker queues
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_workers;
+
+    std::atomic<size_t> m_pendingJobs = 0;
+    std::atomic<size_t> m_sleepingWorkers = 0;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeCV;
+    bool m_quit = false;
+
+    void Run(size_t queueIndex);
+    size_t GetQueueIndex() const;
+    void Push(Job job);
+    bool Pop(size_t queueIndex, Job& outJob);
+    bool PopCounterJob(const Counter& counter, Job& outJob);
+    void Execute(Job& job);
+    void FinishJob(Counter* counter);
+};
@@ -0,0 +1,252 @@
+#include <algorithm>
+
+#include "CoreLib/JobSystem.h"
+
+namespace {
+    // queue of the current thread, only valid while s_currentSystem is the job system that asks
+    thread_local const JobSystem* s_currentSystem = nullptr;
+    thread_local size_t s_currentQueue = 0;
+}
+
+bool JobSystem::Counter::IsDone() const {
+    // a counter is only done once no finishing job touches it anymore, it may be destroyed right after
+    return m_count.load() == 0 && m_finishing.load() == 0;
+}
+
+uint32_t JobSystem::Counter::GetCount() const {
+    return m_count.load();
+}
+
+JobSystem::JobSystem() {
+    m_queues.push_back(std::make_unique<Queue>());
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+void JobSystem::Init(size_t workerCount) {
+    Shutdown();
+
+    m_quit = false;
+    m_queues.resize(1);
+    for (size_t i = 0; i < workerCount; i++)
+        m_queues.push_back(std::make_unique<Queue>());
+
+    m_workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; i++)
+        m_workers.emplace_back(&JobSystem::Run, this, i + 1);
+}
+
+void JobSystem::Shutdown() {
+    if (m_workers.empty()) {
+        // without workers the remaining jobs run on the calling thread
+        while (RunPendingJob()) {}
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_sleepMutex);
+        m_quit = true;
+    }
+    m_wakeCV.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable())
+            worker.join();
+    }
+    m_workers.clear();
+
+    while (RunPendingJob()) {}
+}
+
+bool JobSystem::IsRunning() const {
+    return !m_workers.empty();
+}
+
+size_t JobSystem::GetWorkerCount() const {
+    return m_workers.size();
+}
+
+bool JobSystem::IsWorkerThread() const {
+    return s_currentSystem == this && s_currentQueue != 0;
+}
+
+void JobSystem::Schedule(JobFunc job, Counter* counter) {
+    if (counter)
+        counter->m_count.fetch_add(1);
+    Push(Job{ std::move(job), counter });
+}
+
+void JobSystem::ScheduleAfter(Counter& dependency, JobFunc job, Counter* counter) {
+    if (counter)
+        counter->m_count.fetch_add(1);
+
+    Job newJob{ std::move(job), counter };
+    {
+        // FinishJob takes the continuations under the same lock after the count reached 0
+        std::lock_guard lock(dependency.m_mutex);
+        if (dependency.m_count.load() != 0) {
+            dependency.m_continuations.push_back(std::move(newJob));
+            return;
+        }
+    }
+    Push(std::move(newJob));
+}
+
+void JobSystem::ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t begin, size_t end)>& func) {
+    if (count == 0)
+        return;
+    if (batchSize == 0)
+        batchSize = 1;
+
+    Counter counter;
+    for (size_t begin = 0; begin < count; begin += batchSize) {
+        size_t end = (count - begin > batchSize) ? begin + batchSize : count;
+        Schedule([&func, begin, end]() { func(begin, end); }, &counter);
+    }
+    Wait(counter);
+}
+
+void JobSystem::Wait(Counter& counter) {
+    // other threads only help with jobs of the counter, an unrelated long job would stall them (main thread).
+    // Workers run every job so nested waits always make progress, without workers every job has to run here
+    const bool runAnyJob = IsWorkerThread() || m_workers.empty();
+    while (!counter.IsDone()) {
+        Job job;
+        bool popped = (runAnyJob) ? Pop(GetQueueIndex(), job) : PopCounterJob(counter, job);
+        if (popped)
+            Execute(job);
+        else
+            std::this_thread::yield();
+    }
+}
+
+bool JobSystem::RunPendingJob() {
+    Job job;
+    if (!Pop(GetQueueIndex(), job))
+        return false;
+
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Run(size_t queueIndex) {
+    s_currentSystem = this;
+    s_currentQueue = queueIndex;
+
+    Job job;
+    while (true) {
+        if (Pop(queueIndex, job)) {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock lock(m_sleepMutex);
+        m_sleepingWorkers.fetch_add(1);
+        m_wakeCV.wait(lock, [this]() { return m_quit || m_pendingJobs.load() > 0; });
+        m_sleepingWorkers.fetch_sub(1);
+
+        if (m_quit && m_pendingJobs.load() == 0)
+            break;
+    }
+
+    s_currentSystem = nullptr;
+    s_currentQueue = 0;
+}
+
+size_t JobSystem::GetQueueIndex() const {
+    return (s_currentSystem == this) ? s_currentQueue : 0;
+}
+
+void JobSystem::Push(Job job) {
+    // counted before the job is visible, a Pop of it can not decrement below 0.
+    // A worker that goes to sleep increments m_sleepingWorkers before it checks m_pendingJobs,
+    // either it sees the job or the wake up is sent
+    m_pendingJobs.fetch_add(1);
+
+    Queue& queue = *m_queues[GetQueueIndex()];
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+
+    if (m_sleepingWorkers.load() > 0) {
+        std::lock_guard lock(m_sleepMutex);
+        m_wakeCV.notify_one();
+    }
+}
+
+bool JobSystem::Pop(size_t queueIndex, Job& outJob) {
+    if (m_pendingJobs.load() == 0)
+        return false;
+
+    // newest job of the own queue, it is most likely still in the cache
+    {
+        Queue& queue = *m_queues[queueIndex];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            outJob = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            m_pendingJobs.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // oldest job of another queue
+    const size_t queueCount = m_queues.size();
+    for (size_t i = 1; i < queueCount; i++) {
+        Queue& queue = *m_queues[(queueIndex + i) % queueCount];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            outJob = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            m_pendingJobs.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JobSystem::PopCounterJob(const Counter& counter, Job& outJob) {
+    if (m_pendingJobs.load() == 0)
+        return false;
+
+    for (auto& queue : m_queues) {
+        std::lock_guard lock(queue->mutex);
+        auto it = std::find_if(queue->jobs.begin(), queue->jobs.end(),
+            [&counter](const Job& job) { return job.counter == &counter; });
+        if (it == queue->jobs.end())
+            continue;
+
+        outJob = std::move(*it);
+        queue->jobs.erase(it);
+        m_pendingJobs.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Execute(Job& job) {
+    if (job.func)
+        job.func();
+    job.func = nullptr;
+    FinishJob(job.counter);
+}
+
+void JobSystem::FinishJob(Counter* counter) {
+    if (!counter)
+        return;
+
+    counter->m_finishing.fetch_add(1);
+    std::vector<Job> continuations;
+    if (counter->m_count.fetch_sub(1) == 1) {
+        std::lock_guard lock(counter->m_mutex);
+        continuations.swap(counter->m_continuations);
+    }
+    // last access, a waiting thread can destroy the counter after this
+    counter->m_finishing.fetch_sub(1);
+
+    for (auto& job : continuations)
+        Push(std::move(job));
+}
@@ -1,12 +1,16 @@
 #pragma once
+#include <atomic>
 #include <string>
 #include <vector>
+#include <CoreLib/JobSystem.h>
 
 #include "SDLCoreTypes.h"
 #include "SDLCoreError.h"
 #include "SDLCoreRenderer.h"
 #include "SDLCoreTime.h"
 #include "SDLCoreInput.h"
+#include "AssetLoader.h"
+#include "Internal/FramePacer.h"
 #include "types/Version.h"
 #include "Window.h"
 
@@ -36,6 +40,7 @@ namespace SDLCore {
 
 	class Application {
 		friend class Window;
+		friend class AssetLoader;
 	public:
 		Application(std::string& name, const Version& version);
 		Application(std::string&& name, const Version& version);
@@ -54,6 +59,37 @@ namespace SDLCore {
 		*/
 		static Platform GetPlatform();
 
+		/**
+		* @brief Enables or disables the headless mode. Has to be called before the application is created.
+		*
+		* In headless mode SDL uses the offscreen video driver (dummy as fallback), the dummy audio driver
+		* and windows get a software renderer. Nothing is shown on screen, but rendering works as usual
+		* and frames can be read back with Render::SaveFrame. Useful for benchmarks and tests on machines without a display.
+		*
+		* @param value true = headless, false = normal windows (default)
+		*/
+		static void SetHeadless(bool value);
+
+		/**
+		* @brief Returns true if the application runs in headless mode.
+		*/
+		static bool IsHeadless();
+
+		/**
+		* @brief Sets how many hardware threads are not used by the job system. Has to be called before the application is created.
+		*
+		* The job system starts hardware_concurrency - count workers (at least 1). The reserved threads are left
+		* for the main thread and the other threads of the application (asset loader, font atlas worker, audio).
+		*
+		* @param count Reserved threads (default 2)
+		*/
+		static void SetReservedThreadCount(int count);
+
+		/**
+		* @brief Returns the number of hardware threads that are not used by the job system
+		*/
+		static int GetReservedThreadCount();
+
 		/**
 		* @brief Starts the main loop of the application
 		* @return returns an error code or 0
@@ -65,6 +101,42 @@ namespace SDLCore {
 		*/
 		void Quit();
 
+		/**
+		* @brief Enables or disables the idle mode for tool-style applications.
+		*
+		* In idle mode the main loop blocks in SDL_WaitEventTimeout until an event arrives,
+		* RequestRedraw is called or a wakeup of ScheduleWakeup is due. Every event still runs a frame
+		* right away, so input latency stays the same while an idle application uses almost no CPU.
+		* Pending AssetLoader loads keep the loop running.
+		*
+		* The time spent waiting is not counted in the delta time, the frame time statistics
+		* and the fixed update, the simulation pauses while the application is idle.
+		*
+		* @param value true = idle mode, false = runs every frame (default)
+		*/
+		void SetIdleMode(bool value);
+
+		/**
+		* @brief Returns true if the idle mode is enabled
+		*/
+		bool IsIdleMode() const;
+
+		/**
+		* @brief Requests another frame in idle mode. Call it every frame while something animates.
+		*
+		* Safe to call from any thread, a waiting main loop wakes up.
+		*/
+		void RequestRedraw();
+
+		/**
+		* @brief Runs a frame after the given time in idle mode (timers, blinking cursors, polling).
+		*
+		* Only the earliest scheduled wakeup is kept, schedule the next one when it is due.
+		*
+		* @param seconds Time from now until the frame runs
+		*/
+		void ScheduleWakeup(double seconds);
+
 		/**
 		* @brief Adds a new Window instance to the application without creating the underlying SDL window or renderer.
 		*
@@ -401,9 +473,94 @@ namespace SDLCore {
 		* - APPLICATION_FPS_VSYNC_ADAPTIVE_ON: Enables adaptive VSync.
 		* 
 		* - Any positive integer: Caps the frame rate to the specified FPS value.
+		*   Frames are paced with nanosecond deadlines (sleep, then spin until the deadline),
+		*   see GetFramePacingStats.
 		*/
 		void SetFPSCap(int value);
 
+		/**
+		* @brief Returns the job system of the application.
+		*
+		* It is started with the application and shut down before SDL quits, all remaining jobs run before.
+		* Use it for work that is not bound to a frame, jobs must not call render functions.
+		*/
+		JobSystem& GetJobSystem();
+
+		/**
+		* @brief Runs a job in parallel that has to be done before the end of the frame.
+		*
+		* Can be called in OnUpdate and OnFixedUpdate. The main loop waits for all frame jobs after OnUpdate,
+		* call WaitForFrameJobs to wait earlier (e.g. before the results are rendered).
+		* Jobs must not call render functions.
+		*/
+		void ScheduleFrameJob(JobSystem::JobFunc job);
+
+		/**
+		* @brief Waits until all jobs of ScheduleFrameJob are done, the main thread runs frame jobs while it waits.
+		* Jobs of GetJobSystem are not run by the main thread
+		*/
+		void WaitForFrameJobs();
+
+		/**
+		* @brief Returns how exactly the FPS cap was met since the cap was set or the stats were reset.
+		*
+		* Only frames paced by a positive FPS cap are counted (not VSync).
+		*/
+		const FramePacingStats& GetFramePacingStats() const;
+
+		/**
+		* @brief Resets the frame pacing statistics
+		*/
+		void ResetFramePacingStats();
+
+		/**
+		* @brief Sets how often OnFixedUpdate is called per second, independent of the frame rate.
+		*
+		* Every frame the elapsed time is added to an accumulator and OnFixedUpdate runs once for every
+		* full tick in it, before OnUpdate. Use Time::GetFixedDeltaTimeSecF inside OnFixedUpdate and
+		* Time::GetInterpolationAlphaF to interpolate the rendering between the last two ticks.
+		*
+		* @param hz Ticks per second (default 60). 0 disables OnFixedUpdate
+		*/
+		void SetFixedTickRate(double hz);
+
+		/**
+		* @brief Returns the ticks per second of OnFixedUpdate, 0 if disabled
+		*/
+		double GetFixedTickRate() const;
+
+		/**
+		* @brief Sets the max number of OnFixedUpdate calls in one frame.
+		*
+		* If a frame took longer than steps ticks, the remaining backlog is dropped
+		* (see Time::GetDroppedFixedTickCount) so a slow simulation can not stall the application.
+		* In the run-as-fast-as-possible mode this is the number of ticks every frame.
+		*
+		* @param steps Max ticks per frame (default 8), at least 1
+		*/
+		void SetMaxFixedStepsPerFrame(int steps);
+
+		/**
+		* @brief Returns the max number of OnFixedUpdate calls in one frame
+		*/
+		int GetMaxFixedStepsPerFrame() const;
+
+		/**
+		* @brief Runs the fixed update ticks back-to-back without waiting for the real time.
+		*
+		* Every frame runs the max fixed steps per frame and the FPS cap is ignored.
+		* Used for offline simulations, replays and tests that should run faster than real time.
+		* Time::GetFixedTimeSecD gives the simulated time.
+		*
+		* @param value true = as fast as possible, false = real time (default)
+		*/
+		void SetRunAsFastAsPossible(bool value);
+
+		/**
+		* @brief Returns true if the fixed update runs as fast as possible
+		*/
+		bool IsRunAsFastAsPossible() const;
+
 		/**
 		* @brief Enables or disables cursor locking for a specific window.
 		* 
@@ -623,6 +780,11 @@ namespace SDLCore {
 		*/
 		virtual void OnStart() = 0;
 
+		/*
+		* @brief called with a fixed time step before OnUpdate, zero or more times per frame (see SetFixedTickRate)
+		*/
+		virtual void OnFixedUpdate() {}
+
 		/*
 		* @brief called every frame of the programm
 		*/
@@ -645,8 +807,20 @@ namespace SDLCore {
 		SDLCoreIDManager m_windowIDManager;
 		std::string m_renderDriver;
 
+		JobSystem m_jobSystem;
+		JobSystem::Counter m_frameJobs;
+
 		int m_vsync = 0;
 		int m_fpsCap = 0;
+		FramePacer m_framePacer;
+
+		int m_maxFixedStepsPerFrame = 8;
+		bool m_runAsFastAsPossible = false;
+
+		bool m_idleMode = false;
+		std::atomic<bool> m_redrawRequested = true;
+		std::atomic<bool> m_idleWaiting = false;
+		uint64_t m_nextWakeupNS = 0;// 0 = no wakeup scheduled
 
 		WindowID m_cursorLockWinID;
 		WindowCallbackID m_cursorLockResizeCallbackID;
@@ -663,8 +837,20 @@ namespace SDLCore {
 		void InitInternal();
 		void QuitInternal();
 		void ProcessSDLPollEvents();
+		/**
+		* @brief Forwards m_sdlEvent to every window
+		*/
+		void ProcessSDLEvent();
 		void ProcessSDLPollEventWindow(const std::unique_ptr<Window>& window);
 		/**
+		* @brief Blocks until the next frame should run if the idle mode is enabled
+		*/
+		void WaitWhileIdle();
+		/**
+		* @brief Wakes up a main loop that waits in WaitWhileIdle
+		*/
+		void WakeUp();
+		/**
 		* @brief Processes and removes windows that were marked for closure.
 		* Should be called after the complete render cycle to ensure no rendering
 		* happens on deleted windows.
@@ -672,7 +858,14 @@ namespace SDLCore {
 		* Called at the end of each frame in the main loop.
 		*/
 		void ProcessWindowClosureRequests();
-		void FPSCapDelay(uint64_t frameStartTime) const;
+		/**
+		* @brief Waits until the frame deadline of the FPS cap
+		*/
+		void PaceFrame();
+		/**
+		* @brief Calls OnFixedUpdate for every fixed tick of this frame
+		*/
+		void RunFixedUpdates();
 		void LockCursor();
 		/*
 		* @brief Sets every var that is used for cursorlock to its default values.
@@ -0,0 +1,342 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <thread>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+#include "Types/Types.h"
+#include "Types/Texture.h"
+#include "Types/Font/Font.h"
+#include "Types/Audio/SoundClip.h"
+
+namespace SDLCore {
+
+	class Application;
+	class AssetLoader;
+	class AssetPack;
+
+	enum class AssetState : uint8_t {
+		PENDING,	/**< queued, decoding or waiting for the upload */
+		READY,		/**< decoded and uploaded, the asset can be used */
+		FAILED,		/**< could not be loaded, see AssetHandle::GetError */
+		CANCELED	/**< was canceled before it was ready */
+	};
+
+	/*
+	* Shared state of one load. Decoded on a loader thread, finished on the main thread
+	*/
+	class AssetRequestBase {
+	friend class AssetLoader;
+	public:
+		virtual ~AssetRequestBase() = default;
+
+		AssetState GetState() const;
+		int GetPriority() const;
+		const SystemFilePath& GetPath() const;
+		/*
+		* @brief only valid once the state is FAILED
+		*/
+		const std::string& GetError() const;
+
+	protected:
+		AssetRequestBase(const SystemFilePath& path, int priority);
+
+		SystemFilePath m_path;
+		std::string m_error;
+		std::atomic<AssetState> m_state{ AssetState::PENDING };
+		std::atomic<bool> m_canceled{ false };
+		int m_priority = 0;
+		uint64_t m_sequence = 0;// load order of requests with the same priority
+		bool m_decodeSucceeded = false;// written by the loader thread before the request is handed to the main thread
+
+		/*
+		* @brief runs on a loader thread, must not call SDL render functions or SetError
+		* @return false if the asset could not be decoded, m_error is set
+		*/
+		virtual bool Decode() = 0;
+
+		/*
+		* @brief runs on the main thread, creates the window textures or registers the asset
+		* @return false if the asset could not be finished, m_error is set
+		*/
+		virtual bool Finish() = 0;
+
+		/*
+		* @brief destroys the decoded asset, runs on the main thread
+		*/
+		virtual void Release() = 0;
+	};
+
+	template<typename T>
+	class AssetRequest : public AssetRequestBase {
+	friend class AssetLoader;
+	template<typename> friend class AssetHandle;
+	public:
+		using DecodeFunc = std::function<std::unique_ptr<T>(const SystemFilePath& path, std::string& outError)>;
+		using FinishFunc = std::function<bool(T& asset, std::string& outError)>;
+
+		AssetRequest(const SystemFilePath& path, int priority, DecodeFunc decode, FinishFunc finish)
+			: AssetRequestBase(path, priority), m_decode(std::move(decode)), m_finish(std::move(finish)) {
+		}
+
+	private:
+		DecodeFunc m_decode;
+		FinishFunc m_finish;
+		std::unique_ptr<T> m_asset;
+
+		bool Decode() override {
+			m_asset = m_decode(m_path, m_error);
+			return m_asset != nullptr;
+		}
+
+		bool Finish() override {
+			bool result = !m_finish || m_finish(*m_asset, m_error);
+			m_decode = nullptr;
+			m_finish = nullptr;
+			return result;
+		}
+
+		void Release() override {
+			m_asset.reset();
+			m_decode = nullptr;
+			m_finish = nullptr;
+		}
+	};
+
+	/**
+	* @brief Refers to an asset that is loaded by the AssetLoader.
+	*
+	* Handles are cheap to copy, all copies refer to the same load.
+	* The asset is owned by the load and lives as long as a handle to it exists.
+	*/
+	template<typename T>
+	class AssetHandle {
+	friend class AssetLoader;
+	public:
+		AssetHandle() = default;
+
+		/**
+		* @brief Returns false for a default constructed handle
+		*/
+		bool IsValid() const {
+			return m_request != nullptr;
+		}
+
+		AssetState GetState() const {
+			return (m_request) ? m_request->GetState() : AssetState::FAILED;
+		}
+
+		bool IsPending() const { return GetState() == AssetState::PENDING; }
+		bool IsReady() const { return GetState() == AssetState::READY; }
+		bool IsFailed() const { return GetState() == AssetState::FAILED; }
+		bool IsCanceled() const { return GetState() == AssetState::CANCELED; }
+
+		/**
+		* @brief Returns the asset once it is ready
+		* @return nullptr while the asset is pending, failed or canceled
+		*/
+		T* Get() const {
+			return (IsReady()) ? m_request->m_asset.get() : nullptr;
+		}
+
+		/**
+		* @brief Returns the asset once it is ready, until then the fallback of the type
+		* (fallback texture, default font, empty sound clip)
+		*/
+		T* GetOrFallback() const;
+
+		/**
+		* @brief Returns the reason why the load failed
+		*/
+		std::string GetError() const {
+			return (m_request) ? m_request->GetError() : "Handle is invalid";
+		}
+
+		SystemFilePath GetPath() const {
+			return (m_request) ? m_request->GetPath() : SystemFilePath();
+		}
+
+		int GetPriority() const {
+			return (m_request) ? m_request->GetPriority() : 0;
+		}
+
+		/**
+		* @brief Changes the priority of a pending load, higher priorities are decoded and uploaded first
+		*/
+		void SetPriority(int priority);
+
+		/**
+		* @brief Cancels the load if it is not ready yet. Loads that are already decoding finish
+		* on their thread, the result is discarded
+		*/
+		void Cancel();
+
+	private:
+		std::shared_ptr<AssetRequest<T>> m_request;
+
+		explicit AssetHandle(std::shared_ptr<AssetRequest<T>> request)
+			: m_request(std::move(request)) {
+		}
+	};
+
+	/**
+	* @brief Loads textures, sound clips and fonts without stalling the main loop.
+	*
+	* Files are decoded on a pool of loader threads in the order of their priority.
+	* The decoded assets are finished on the main thread (window textures are created,
+	* sounds are registered) before OnUpdate, only as many as fit into the upload budget of
+	* a frame. The first asset of a frame is always finished so every frame makes progress.
+	*
+	* All functions have to be called on the main thread
+	*/
+	class AssetLoader {
+	friend class Application;
+	template<typename> friend class AssetHandle;
+	public:
+		static constexpr size_t MAX_WORKER_COUNT = 4;
+		static constexpr float DEFAULT_UPLOAD_BUDGET_MS = 2.0f;
+
+		/**
+		* @brief Loads an image file as texture. The texture is created for every window of the application
+		* @param priority higher priorities are loaded first
+		*/
+		static AssetHandle<Texture> LoadTexture(const SystemFilePath& path, int priority = 0, Texture::Type type = Texture::Type::STATIC);
+
+		/**
+		* @brief Loads an audio file as sound clip
+		* @param priority higher priorities are loaded first
+		*/
+		static AssetHandle<SoundClip> LoadSound(const SystemFilePath& path, int priority = 0, SoundType type = SoundType::AUTO);
+
+		/**
+		* @brief Loads a font file, the atlases of the given sizes are generated on the loader thread
+		* @param priority higher priorities are loaded first
+		*/
+		static AssetHandle<Font> LoadFont(const SystemFilePath& path, std::vector<float> sizes = {}, int priority = 0);
+
+		/**
+		* @brief Loads an image entry of an asset pack as texture. The pack has to stay open until the load is done
+		* @param priority higher priorities are loaded first
+		*/
+		static AssetHandle<Texture> LoadTexture(const AssetPack& pack, std::string_view path, int priority = 0, Texture::Type type = Texture::Type::STATIC);
+
+		/**
+		* @brief Loads an audio entry of an asset pack as sound clip. The pack has to stay open as long as the clip is used
+		* @param priority higher priorities are loaded first
+		*/
+		static AssetHandle<SoundClip> LoadSound(const AssetPack& pack, std::string_view path, int priority = 0, SoundType type = SoundType::AUTO);
+
+		/**
+		* @brief Loads a font entry of an asset pack. The pack has to stay open as long as the font is used
+		* @param priority higher priorities are loaded first
+		*/
+		static AssetHandle<Font> LoadFont(AssetPack& pack, std::string_view path, std::vector<float> sizes = {}, int priority = 0);
+
+		/**
+		* @brief Sets the time the main thread spends per frame to finish decoded assets
+		* @param ms budget in milliseconds (default DEFAULT_UPLOAD_BUDGET_MS)
+		*/
+		static void SetUploadBudget(float ms);
+		static float GetUploadBudget();
+
+		/**
+		* @brief Returns the number of loads that are not ready, failed or canceled yet
+		*/
+		static size_t GetPendingCount();
+
+		/**
+		* @brief Cancels every pending load
+		*/
+		static void CancelAll();
+
+		static Texture* GetFallbackTexture();
+		static Font* GetFallbackFont();
+		static SoundClip* GetFallbackSound();
+
+	private:
+		std::vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::vector<std::shared_ptr<AssetRequestBase>> m_queue;// heap, highest priority on top
+		std::vector<std::shared_ptr<AssetRequestBase>> m_decoded;// waits for the main thread
+		bool m_shutdown = false;
+		uint64_t m_nextSequence = 0;
+
+		// main thread only
+		std::vector<std::shared_ptr<AssetRequestBase>> m_uploads;
+		std::vector<std::shared_ptr<AssetRequestBase>> m_requests;// all pending loads
+		uint64_t m_uploadBudgetNS = static_cast<uint64_t>(DEFAULT_UPLOAD_BUDGET_MS * 1000000.0f);
+
+		std::unique_ptr<Texture> m_fallbackTexture;
+		std::unique_ptr<Font> m_fallbackFont;
+		std::unique_ptr<SoundClip> m_fallbackSound;
+
+		AssetLoader() = default;
+		~AssetLoader();
+
+		static AssetLoader& GetInstance();
+
+		void Schedule(std::shared_ptr<AssetRequestBase> request);
+		void SetPriority(AssetRequestBase& request, int priority);
+		void Cancel(AssetRequestBase& request);
+
+		/*
+		* @brief finishes decoded assets within the upload budget, called once per frame
+		*/
+		void Update();
+
+		/*
+		* @brief stops the loader threads and releases every asset that is not handed out.
+		* Has to be called before the SDL subsystems are closed
+		*/
+		void Shutdown();
+
+		using OpenIOFunc = std::function<SDL_IOStream*(std::string& outError)>;
+		using DecodeAudioFunc = std::function<MIX_Audio*(SoundClip& clip, std::string& outError)>;
+		using CreateFontFunc = std::function<std::unique_ptr<Font>(std::string& outError)>;
+
+		static AssetHandle<Texture> LoadTexture(const SystemFilePath& name, OpenIOFunc openIO, int priority, Texture::Type type);
+		static AssetHandle<SoundClip> LoadSound(const SystemFilePath& name, DecodeAudioFunc decodeAudio, int priority);
+		static AssetHandle<Font> LoadFont(const SystemFilePath& name, CreateFontFunc createFont, std::vector<float> sizes, int priority);
+
+		void Run();
+		void FinishRequest(AssetRequestBase& request);
+		void RemoveRequest(const AssetRequestBase& request);
+
+		static bool ComparePriority(const std::shared_ptr<AssetRequestBase>& a, const std::shared_ptr<AssetRequestBase>& b);
+	};
+
+	template<typename T>
+	T* AssetHandle<T>::GetOrFallback() const {
+		if (T* asset = Get())
+			return asset;
+
+		if constexpr (std::is_same_v<T, Texture>)
+			return AssetLoader::GetFallbackTexture();
+		else if constexpr (std::is_same_v<T, Font>)
+			return AssetLoader::GetFallbackFont();
+		else if constexpr (std::is_same_v<T, SoundClip>)
+			return AssetLoader::GetFallbackSound();
+		else
+			return nullptr;
+	}
+
+	template<typename T>
+	void AssetHandle<T>::SetPriority(int priority) {
+		if (m_request)
+			AssetLoader::GetInstance().SetPriority(*m_request, priority);
+	}
+
+	template<typename T>
+	void AssetHandle<T>::Cancel() {
+		if (m_request)
+			AssetLoader::GetInstance().Cancel(*m_request);
+	}
+
+}
@@ -2,7 +2,12 @@
 
 #include "Types/Version.h"
 #include "Types/Vertex.h"
+#include "Types/Mesh.h"
 #include "Types/Texture.h"
+#include "Types/TextureAtlas.h"
+#include "Types/RenderLayer.h"
+#include "Types/AssetPack.h"
+#include "Types/AssetPackWriter.h"
 
 #include "Types/Audio/SoundManager.h"
 #include "Types/Font/Font.h"
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+/*
+* File layout of an asset pack (all values little endian):
+*
+* [Header][entry data, 16 byte aligned][Entry index, sorted by path hash][path strings]
+*
+* The index and the path strings are read directly from the memory mapping.
+* Entry checksums cover the stored (possibly compressed) bytes, so a pack
+* can be verified without decompressing it
+*/
+namespace SDLCore::AssetPackFormat {
+
+	constexpr uint32_t MAGIC = 0x4B504453;// "SDPK"
+	constexpr uint32_t VERSION = 1;
+	constexpr uint64_t DATA_ALIGNMENT = 16;
+
+	enum EntryFlags : uint32_t {
+		ENTRY_COMPRESSED = 1 << 0
+	};
+
+	struct Header {
+		uint32_t magic = MAGIC;
+		uint32_t version = VERSION;
+		uint32_t entryCount = 0;
+		uint32_t reserved = 0;
+		uint64_t indexOffset = 0;
+		uint64_t pathsOffset = 0;
+		uint64_t pathsSize = 0;
+		uint64_t indexChecksum = 0;// covers the index and the path strings
+	};
+
+	struct Entry {
+		uint64_t pathHash = 0;
+		uint64_t offset = 0;
+		uint64_t storedSize = 0;
+		uint64_t size = 0;// decompressed size
+		uint64_t checksum = 0;// of the stored bytes
+		uint32_t pathOffset = 0;// into the path strings
+		uint32_t pathLength = 0;
+		uint32_t flags = 0;
+		uint32_t reserved = 0;
+	};
+
+	static_assert(sizeof(Header) == 48, "AssetPackFormat::Header layout changed");
+	static_assert(sizeof(Entry) == 56, "AssetPackFormat::Entry layout changed");
+
+	/*
+	* @brief entry names use '/' as separator and are relative to the pack root
+	*/
+	std::string NormalizePath(std::string_view path);
+
+	/*
+	* @brief hash of a normalized entry name
+	*/
+	uint64_t HashPath(std::string_view path);
+
+	/*
+	* @brief fast non cryptographic checksum, detects corrupted or truncated data
+	*/
+	uint64_t Checksum(const void* data, size_t size);
+
+	/*
+	* @brief compresses with a byte oriented LZ77 codec (LZ4 like sequences, 64 KiB window)
+	*/
+	void Compress(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+
+	/*
+	* @return false if the data is corrupted or does not decompress to exactly dstSize bytes
+	*/
+	bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <mutex>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "Types/Types.h"
+
+struct TTF_Font;
+namespace SDLCore {
+
+	class Application;
+	class Font;
+	class FontAsset;
+
+	/*
+	* Identifies the glyph data of a font asset. Fonts from files are identified by the path,
+	* fonts from memory by the data pointer
+	*/
+	struct FontAssetKey {
+		std::string path;
+		const unsigned char* data = nullptr;
+		size_t dataSize = 0;
+		float size = 0.0f;
+		Uint32 style = 0;// TTF_STYLE_* flags
+		bool sdf = false;
+
+		bool operator==(const FontAssetKey& o) const;
+	};
+
+	struct FontAssetKeyHash {
+		size_t operator()(const FontAssetKey& k) const noexcept;
+	};
+
+	/*
+	* Process wide cache of font assets shared by all Font objects.
+	* Assets are reference counted, unused assets stay cached until the memory budget is exceeded
+	* and are then destroyed least recently used first
+	*/
+	class FontAssetCache {
+	friend class Application;
+	friend class Font;
+	private:
+		struct CacheEntry {
+			std::shared_ptr<FontAsset> asset;
+			size_t lastUseTick = 0;
+		};
+
+		std::unordered_map<FontAssetKey, CacheEntry, FontAssetKeyHash> m_entries;
+		size_t m_budgetBytes = 64 * 1024 * 1024;// 0 = no limit
+		size_t m_useTick = 0;
+		mutable std::mutex m_mutex;
+
+		FontAssetCache() = default;
+		~FontAssetCache() = default;
+
+		static FontAssetCache& GetInstance();
+
+		/*
+		* @return the cached asset or nullptr if no asset with this key exists
+		*/
+		std::shared_ptr<FontAsset> Get(const FontAssetKey& key);
+		bool Contains(const FontAssetKey& key) const;
+
+		/*
+		* @brief creates an asset with a deferred atlas without adding it, takes ownership of the font.
+		* Does not touch the cache entries and can be called on any thread
+		*/
+		static std::shared_ptr<FontAsset> CreateAsset(const FontAssetKey& key, TTF_Font* font);
+
+		/*
+		* @brief creates a new asset, takes ownership of the font
+		* @param deferred true = the atlas is generated on the FontAtlasWorker thread
+		*/
+		std::shared_ptr<FontAsset> Add(const FontAssetKey& key, TTF_Font* font, bool deferred = false);
+
+		/*
+		* @brief adds a created asset, has to be called on the main thread because it trims the cache
+		* @return the asset that is cached with the key, an already cached asset is kept
+		*/
+		std::shared_ptr<FontAsset> Insert(const FontAssetKey& key, std::shared_ptr<FontAsset> asset);
+
+		/*
+		* @brief destroys unused assets until the memory usage fits into the budget
+		*/
+		void Trim();
+
+		void SetBudget(size_t bytes);
+		size_t GetBudget() const;
+		size_t GetMemoryUsage() const;
+		size_t GetAssetCount() const;
+
+		// should only be called at programm end
+		void Clear();
+
+		size_t GetMemoryUsageUnlocked() const;
+
+		/*
+		* @brief releases the disk cache hash of the font data if no entry uses it anymore
+		*/
+		void ReleaseDataUnlocked(const unsigned char* data, size_t dataSize);
+	};
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+
+#include "Types/Types.h"
+
+namespace SDLCore {
+
+	struct FontAssetKey;
+
+	/*
+	* Location and naming of the glyph atlas cache files.
+	* A file is identified by the hash of the font data, the size, the style, the SDF mode
+	* and the cache version, a changed font file results in a new file name
+	*/
+	namespace FontAtlasDiskCache {
+
+		constexpr uint32_t VERSION = 1;
+
+		/*
+		* @brief sets the cache directory, an empty path disables the disk cache.
+		* Default is '<pref path>/FontAtlasCache' of the application
+		*/
+		void SetDirectory(const SystemFilePath& dir);
+		SystemFilePath GetDirectory();
+
+		/*
+		* @brief returns the cache file and the id stored in the file header
+		* @return false if the disk cache is disabled or the font data can not be read
+		*/
+		bool GetCacheFile(const FontAssetKey& key, SystemFilePath& outFile, uint64_t& outID);
+
+		/*
+		* @brief forgets the hash of font data in memory, called when no cached asset uses the data anymore.
+		* The memory may be released afterwards and reused for other font data
+		*/
+		void ReleaseData(const unsigned char* data, size_t size);
+
+	}
+
+}
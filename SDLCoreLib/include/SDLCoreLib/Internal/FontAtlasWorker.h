@@ -0,0 +1,50 @@
+#pragma once
+#include <mutex>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <condition_variable>
+
+namespace SDLCore {
+
+	class Application;
+	class FontAsset;
+	class FontAssetCache;
+
+	/*
+	* Background thread that generates the glyph atlas surfaces of new font assets.
+	* Only surface work happens on the worker, window textures are created by the
+	* render thread when the asset is ready
+	*/
+	class FontAtlasWorker {
+	friend class Application;
+	friend class FontAssetCache;
+	private:
+		std::thread m_thread;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		std::deque<std::shared_ptr<FontAsset>> m_queue;
+		bool m_running = false;
+		bool m_shutdown = false;
+
+		FontAtlasWorker() = default;
+		~FontAtlasWorker();
+
+		static FontAtlasWorker& GetInstance();
+
+		/*
+		* @brief queues the atlas generation of the asset, the worker keeps the asset alive until it is done.
+		* After Shutdown the atlas is generated on the calling thread
+		*/
+		void Schedule(std::shared_ptr<FontAsset> asset);
+
+		/*
+		* @brief stops the worker, queued assets that were not started stay pending.
+		* Has to be called before SDL_ttf is closed
+		*/
+		void Shutdown();
+
+		void Run();
+	};
+
+}
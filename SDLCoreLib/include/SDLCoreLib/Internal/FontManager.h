@@ -1,5 +1,6 @@
 #pragma once
 #include <mutex>
+#include <string>
 #include <unordered_map>
 #include <SDL3_ttf/SDL_ttf.h>
 
@@ -9,6 +10,7 @@ namespace SDLCore {
 
 	class Application;
 	class FontResource;
+	class Font;
 
 	/*
 	* Manages how many refs to an TTF_Font exist and deletes it if none exist anymore
@@ -16,6 +18,7 @@ namespace SDLCore {
 	class FontManager {
 	friend class Application;
 	friend class FontResource;
+	friend class Font;
 	private:
 		struct FontEntry {
 			TTF_Font* font = nullptr;
@@ -39,6 +42,14 @@ namespace SDLCore {
 
 		static FontManager& GetInstance();
 
+		/*
+		* @brief opens a font under the same lock fonts are closed with. FreeType is not thread safe
+		* while faces are created or destroyed, fonts are also opened on the AssetLoader threads
+		* @return nullptr on failure, the SDL error is set
+		*/
+		TTF_Font* OpenFont(const std::string& path, float size);
+		TTF_Font* OpenFontFromMem(const unsigned char* data, size_t dataSize, float size);
+
 		FontID RegisterFont(TTF_Font* font);
 		void IncreaseRef(FontID id);
 		void DecreaseRef(FontID id);
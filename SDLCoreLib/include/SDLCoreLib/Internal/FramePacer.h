@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+
+namespace SDLCore {
+
+	/**
+	* @brief Pacing statistics of the FPS cap, see Application::GetFramePacingStats
+	*/
+	struct FramePacingStats {
+		uint64_t frameCount = 0;		/**< frames that were paced */
+		uint64_t lateFrameCount = 0;	/**< frames that took longer than the frame time, no wait was possible */
+		uint64_t resyncCount = 0;		/**< frames that were more than one frame late, the deadline was reset */
+		double averageErrorMS = 0.0;	/**< mean absolute difference between the end of the wait and the deadline */
+		double maxErrorMS = 0.0;		/**< largest absolute difference between the end of the wait and the deadline */
+		double lastErrorMS = 0.0;		/**< difference of the last frame, > 0 = late, < 0 = early */
+		double averageSpinMS = 0.0;		/**< mean busy wait per frame after the sleep */
+	};
+
+	/*
+	* Waits until the next frame deadline of a target frame rate.
+	*
+	* The deadline advances by exactly one frame time every frame, so a frame that
+	* ends late shortens the wait of the next one and the error does not add up.
+	* The wait sleeps until shortly before the deadline and spins the rest, the
+	* sleep margin adapts to how much the OS oversleeps.
+	*/
+	class FramePacer {
+	public:
+		FramePacer() = default;
+
+		/*
+		* @brief sets the target frame rate, 0 = disabled. Restarts the deadline
+		*/
+		void SetTargetFrameRate(int fps);
+		int GetTargetFrameRate() const;
+		bool IsEnabled() const;
+
+		/*
+		* @brief waits until the deadline of the current frame. Does nothing if disabled
+		*/
+		void Wait();
+
+		/*
+		* @brief the next Wait starts a new deadline sequence, used after a long pause
+		*/
+		void Restart();
+
+		const FramePacingStats& GetStats() const;
+		void ResetStats();
+
+	private:
+		static constexpr uint64_t MIN_SLEEP_MARGIN_NS = 200000;// 0.2ms
+		static constexpr uint64_t DEFAULT_SLEEP_MARGIN_NS = 1000000;// 1ms
+		static constexpr uint64_t MAX_SLEEP_MARGIN_NS = 4000000;// 4ms
+
+		int m_targetFrameRate = 0;
+		uint64_t m_frameTimeNS = 0;
+		uint64_t m_deadlineNS = 0;// 0 = no deadline yet
+		uint64_t m_sleepMarginNS = DEFAULT_SLEEP_MARGIN_NS;
+		FramePacingStats m_stats;
+
+		/*
+		* @brief sleeps for ns and adapts the sleep margin to the measured oversleep
+		*/
+		void Sleep(uint64_t ns);
+		void AddStats(int64_t errorNS, uint64_t spinNS, bool late, bool resync);
+	};
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+namespace SDLCore::Render {
+
+	class Layer;
+
+	/*
+	* Registry of all alive layers, used by Render::Clear and Render::Present to composite them
+	*/
+	void RegisterLayer(Layer* layer);
+	void UnregisterLayer(Layer* layer);
+
+	/*
+	* Marks the composite order as outdated, called when the z order of a layer changes
+	*/
+	void InvalidateLayerOrder();
+
+	/*
+	* @brief Draws all visible auto composite layers of the active window in z order
+	* @param background true = layers with a negative z order, false = all others
+	*/
+	void CompositeLayers(bool background);
+
+	/*
+	* @brief Marks the background layers of the active window to be composited, called by Render::Clear.
+	* Compositing in Clear would draw the layers before the application recorded them for this frame
+	*/
+	void RequestBackgroundComposite();
+
+	/*
+	* @brief Composites the requested background layers of the active window if the window itself is the render target.
+	* Called before every draw to the window and by Render::Present
+	*/
+	void CompositePendingBackground();
+
+}
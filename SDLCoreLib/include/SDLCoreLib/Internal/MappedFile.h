@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "Types/Types.h"
+
+namespace SDLCore {
+
+	/*
+	* Read only memory mapping of a file. The mapping is released when the object is destroyed
+	*/
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		/*
+		* @brief maps the whole file, a previous mapping is closed
+		* @return false if the file does not exist, is empty or can not be mapped
+		*/
+		bool Open(const SystemFilePath& path);
+		void Close();
+
+		bool IsOpen() const;
+		const uint8_t* GetData() const;
+		size_t GetSize() const;
+
+	private:
+		const uint8_t* m_data = nullptr;
+		size_t m_size = 0;
+#ifdef _WIN32
+		void* m_fileHandle = nullptr;
+		void* m_mappingHandle = nullptr;
+#endif
+	};
+
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <vector>
+#include <SDL3/SDL.h>
+
+#include "Types/Types.h"
+
+namespace SDLCore {
+
+	/*
+	* Command buffer of a single window used by the batched render mode.
+	* Draw calls are recorded as triangles and merged with earlier draws that share the
+	* same texture, blend mode, scale mode and clip rect, as long as no draw in between overlaps.
+	* The merged batches are submitted with one SDL_RenderGeometry call each on Flush.
+	*/
+	class RenderBatch {
+	public:
+		RenderBatch() = default;
+
+		/**
+		* @brief Records a list of triangles.
+		* @param renderer Renderer the geometry will be submitted to. Used to capture the current clip rect and blend mode.
+		* @param texture Texture sampled by the triangles, nullptr for untextured geometry.
+		* @param vertices Pointer to the first vertex, positions in render coordinates and colors in the range 0-1.
+		* @param vertexCount Number of vertices.
+		* @param indices Optional index buffer (nullptr = vertices are a plain triangle list).
+		* @param indexCount Number of indices.
+		*/
+		void AddGeometry(SDL_Renderer* renderer,
+			SDL_Texture* texture,
+			const SDL_Vertex* vertices,
+			size_t vertexCount,
+			const int* indices = nullptr,
+			size_t indexCount = 0);
+
+		/**
+		* @brief Records an axis aligned, untextured and single colored rectangle.
+		* @param renderer Renderer the geometry will be submitted to.
+		* @param rect Destination rectangle.
+		* @param color Color in the range 0-1.
+		*/
+		void AddRect(SDL_Renderer* renderer, const SDL_FRect& rect, const SDL_FColor& color);
+
+		/**
+		* @brief Submits all recorded batches to the renderer and clears the command buffer.
+		*
+		* The clip rect and draw blend mode of the renderer are restored after the submission.
+		*
+		* @param renderer Renderer to submit to.
+		* @return true on success. Call SDLCore::GetError() for more information
+		*/
+		bool Flush(SDL_Renderer* renderer);
+
+		/**
+		* @brief Discards all recorded draw calls without submitting them.
+		*/
+		void Clear();
+
+		/**
+		* @brief Returns true if no draw call is waiting for submission.
+		*/
+		bool IsEmpty() const;
+
+		/**
+		* @brief Ends the current frame and stores its counters as the last frame stats.
+		*/
+		void EndFrame();
+
+		/**
+		* @brief Number of draw calls recorded in the last finished frame.
+		*/
+		size_t GetLastFrameRecordedDraws() const;
+
+		/**
+		* @brief Number of SDL_RenderGeometry submissions issued in the last finished frame.
+		*/
+		size_t GetLastFrameSubmittedDraws() const;
+
+	private:
+		struct State {
+			SDL_Texture* texture = nullptr;
+			SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+			SDL_ScaleMode scaleMode = SDL_SCALEMODE_INVALID;
+			bool clipEnabled = false;
+			SDL_Rect clipRect{ 0, 0, 0, 0 };
+
+			bool operator==(const State& o) const;
+		};
+
+		struct Batch {
+			State state;
+			SDL_FRect bounds{ 0, 0, 0, 0 };
+			std::vector<SDL_Vertex> vertices;
+			std::vector<int> indices;
+		};
+
+		// how many batches are searched backwards for a compatible one
+		static constexpr size_t MAX_MERGE_LOOKBACK = 16;
+
+		std::vector<Batch> m_batches;// batches are reused between frames to keep their capacity
+		size_t m_batchCount = 0;
+
+		size_t m_recordedDraws = 0;
+		size_t m_submittedDraws = 0;
+		size_t m_lastFrameRecordedDraws = 0;
+		size_t m_lastFrameSubmittedDraws = 0;
+
+		State CaptureState(SDL_Renderer* renderer, SDL_Texture* texture) const;
+
+		/*
+		* @brief Finds a batch the geometry can be appended to or starts a new one
+		*/
+		Batch& GetBatchFor(const State& state, const SDL_FRect& bounds);
+
+		static SDL_FRect CalculateBounds(const SDL_Vertex* vertices, size_t vertexCount);
+		static bool Overlaps(const SDL_FRect& a, const SDL_FRect& b);
+		static void ExtendBounds(SDL_FRect& bounds, const SDL_FRect& other);
+	};
+
+	namespace Render {
+
+		/**
+		* @brief Returns the command buffer of the active window.
+		* @return Pointer to the command buffer, or nullptr if batching is disabled or no window is active.
+		*
+		* Used internally by draw calls that live outside of the renderer (e.g. Texture::Render).
+		*/
+		RenderBatch* GetActiveRenderBatch();
+
+	}
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <SDL3/SDL.h>
+
+namespace SDLCore {
+
+	/*
+	* Shadow copy of the state of one SDL_Renderer.
+	* A setter only forwards to SDL if the value differs from the last value that was set.
+	* Unknown values (after construction or Invalidate) are always forwarded.
+	*/
+	class RenderStateCache {
+	public:
+		RenderStateCache() = default;
+
+		/*
+		* @return false if the SDL call failed. Call SDL_GetError() for more information
+		*/
+		bool SetDrawColor(SDL_Renderer* renderer, const SDL_Color& color);
+		bool SetDrawBlendMode(SDL_Renderer* renderer, SDL_BlendMode mode);
+		bool SetClipRect(SDL_Renderer* renderer, const SDL_Rect* rect);// nullptr = disabled
+		bool SetViewport(SDL_Renderer* renderer, const SDL_Rect* rect);// nullptr = full target
+
+		/*
+		* @brief Returns true if setting this viewport would change the state (or the state is unknown)
+		*/
+		bool IsViewportDifferent(const SDL_Rect* rect) const;
+
+		/*
+		* @brief Marks all values as unknown, used when SDL state was changed without this cache
+		*/
+		void Invalidate();
+
+		/*
+		* @brief Marks the draw color as unknown
+		*/
+		void InvalidateDrawColor();
+
+		/*
+		* @brief Counts state calls that were skipped or issued outside of this class (e.g. texture mods)
+		*/
+		static void CountSkipped(uint64_t count = 1);
+		static void CountIssued(uint64_t count = 1);
+
+		static uint64_t GetSkippedCalls();
+		static uint64_t GetIssuedCalls();
+		static void ResetCounters();
+
+	private:
+		SDL_Color m_drawColor{ 0, 0, 0, 0 };
+		SDL_BlendMode m_blendMode = SDL_BLENDMODE_INVALID;
+		SDL_Rect m_clipRect{ 0, 0, 0, 0 };
+		SDL_Rect m_viewport{ 0, 0, 0, 0 };
+
+		bool m_drawColorValid = false;
+		bool m_blendModeValid = false;
+		bool m_clipValid = false;
+		bool m_clipEnabled = false;
+		bool m_viewportValid = false;
+		bool m_viewportSet = false;
+
+		static uint64_t s_skippedCalls;
+		static uint64_t s_issuedCalls;
+
+		static bool RectEquals(const SDL_Rect& a, const SDL_Rect& b);
+	};
+
+	namespace Render {
+
+		/*
+		* @brief Marks the shadow state of the active window as unknown.
+		* Has to be called after changing the render target, viewport and clip rect are stored per target.
+		*/
+		void InvalidateActiveRenderState();
+
+		/*
+		* @brief AABB test of a draw call against the visible area (viewport and clip rect) of the active target.
+		* Coordinates are render coordinates, the same as the ones passed to the draw functions.
+		* @return true if culling is enabled and the bounds are fully outside, the draw call has to be skipped.
+		* Every call with culling enabled is counted in the cull statistics.
+		*/
+		bool IsCulled(float minX, float minY, float maxX, float maxY);
+
+	}
+
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+#include "Types/Types.h"
+
+namespace SDLCore {
+
+	class FontAsset;
+
+	/*
+	* One positioned glyph of a layout. The code point is stored instead of the metrics,
+	* glyphs that are not ASCII can be evicted from the atlas and are looked up again when drawn
+	*/
+	struct TextLayoutGlyph {
+		Uint32 code = 0;
+		float x = 0.0f;// offset from the start of the line in pixels
+		float advance = 0.0f;
+		Uint32 line = 0;
+		Uint32 byteOffset = 0;// start of the code point in the text
+	};
+
+	struct TextLayoutLine {
+		Uint32 firstGlyph = 0;
+		Uint32 glyphCount = 0;
+		float width = 0.0f;
+		size_t textStart = 0;// byte offset of the line start (wrapped lines: of the first glyph)
+	};
+
+	/*
+	* Layout parameters, a change results in a new layout
+	*/
+	struct TextLayoutParams {
+		float scale = 1.0f;// text size / asset size
+		float clipWidth = -1.0f;// -1 = lines are only broken at '\n'
+		size_t maxLines = 0;// 0 = no limit
+
+		bool operator==(const TextLayoutParams& o) const {
+			return scale == o.scale && clipWidth == o.clipWidth && maxLines == o.maxLines;
+		}
+	};
+
+	/*
+	* Key of a fitted text size, the scale of the layout parameters is not used
+	*/
+	struct TextFitParams {
+		TextLayoutParams layout;
+		float targetW = 0.0f;// <= 0 = not limited
+		float targetH = 0.0f;// <= 0 = not limited
+		float lineHeightMultiplier = 0.0f;
+
+		bool operator==(const TextFitParams& o) const {
+			return layout == o.layout && targetW == o.targetW && targetH == o.targetH &&
+				lineHeightMultiplier == o.lineHeightMultiplier;
+		}
+	};
+
+	struct TextLayout {
+		std::vector<TextLayoutGlyph> glyphs;
+		std::vector<TextLayoutLine> lines;
+		float blockWidth = 0.0f;// width of the widest line
+
+		void Clear();
+	};
+
+	/*
+	* Breaks UTF-8 text into lines and positions the glyphs.
+	* Works on views into the source text, the only memory used are the vectors of the layout.
+	* Lines are broken at '\n', with a clip width words are moved to the next line
+	* and words wider than the clip width are broken at any character.
+	* Characters without a glyph (control characters) are skipped
+	*/
+	void BuildTextLayout(FontAsset* asset, std::string_view text, const TextLayoutParams& params, TextLayout& out);
+
+	/*
+	* Prefix sums of the glyph advances of a text, the width of any glyph range is one subtraction.
+	* Characters without a glyph have no entry, lines are not taken into account
+	*/
+	struct TextWidthTable {
+		std::vector<float> prefix{ 0.0f };// prefix[i] = width of the first i glyphs, size = glyph count + 1
+		std::vector<Uint32> offsets{ 0 };// byte offset of glyph i, offsets[glyph count] = text size
+
+		size_t GetGlyphCount() const;
+
+		/*
+		* @return width of the glyphs [firstGlyph, lastGlyph)
+		*/
+		float GetWidth(size_t firstGlyph, size_t lastGlyph) const;
+		float GetWidth() const;
+
+		/*
+		* @brief binary search over the prefix sums
+		* @return number of glyphs from the start that fit into maxWidth
+		*/
+		size_t GetFittingGlyphCount(float maxWidth) const;
+
+		void Clear();
+	};
+
+	void BuildTextWidthTable(FontAsset* asset, std::string_view text, float scale, TextWidthTable& out);
+
+	/*
+	* Memoizes layouts, width tables and fitted text sizes by the content hash of the text, the font asset and the parameters.
+	* Entries that were not used for a number of frames are recycled, their memory is kept
+	* so looking up a new text does not allocate once the cache is warm
+	*/
+	class TextLayoutCache {
+	public:
+		static constexpr size_t MAX_ENTRIES = 4096;// per kind
+		static constexpr uint64_t TTL_FRAMES = 600;
+
+		TextLayoutCache() = default;
+
+		/*
+		* @brief returns the layout of the text, builds it if it is not cached.
+		* The pointer is valid until the next call
+		*/
+		const TextLayout* Get(FontAsset* asset, std::string_view text, const TextLayoutParams& params);
+
+		/*
+		* @brief returns the width table of the text, builds it if it is not cached.
+		* The pointer is valid until the next call
+		*/
+		const TextWidthTable* GetWidthTable(FontAsset* asset, std::string_view text, float scale);
+
+		/*
+		* @brief looks up the text size that was fitted into the bounds of params
+		* @return false if the size is not cached
+		*/
+		bool GetFittedSize(FontAsset* asset, std::string_view text, const TextFitParams& params, float& outSize);
+		void SetFittedSize(FontAsset* asset, std::string_view text, const TextFitParams& params, float size);
+
+		/*
+		* @brief recycles entries that were not used for TTL_FRAMES frames
+		*/
+		void EvictOld(uint64_t currentFrame);
+		void Clear();
+
+		size_t GetEntryCount() const;
+
+	private:
+		struct FittedSize {
+			float size = 0.0f;
+
+			void Clear() { size = 0.0f; }
+		};
+
+		template<typename T, typename P = TextLayoutParams>
+		struct Store {
+			struct Entry {
+				uint64_t assetID = 0;
+				P params;
+				std::string text;
+				T value;
+				uint64_t lastUseFrame = 0;
+			};
+
+			std::vector<Entry> entries;
+			std::vector<Uint32> freeEntries;
+			std::unordered_map<size_t, Uint32> hashToEntry;
+			T scratch;// used if the store is full
+
+			template<typename BuildFunc>
+			const T* Get(uint64_t assetID, std::string_view text, const P& params, BuildFunc&& build);
+			/*
+			* @return nullptr if the entry is not cached
+			*/
+			const T* Find(uint64_t assetID, std::string_view text, const P& params);
+			void EvictOld(uint64_t currentFrame);
+			void Clear();
+		};
+
+		Store<TextLayout> m_layouts;
+		Store<TextWidthTable> m_widthTables;
+		Store<FittedSize, TextFitParams> m_fittedSizes;
+		uint64_t m_lastEvictFrame = 0;
+	};
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+#include <SDL3/SDL.h>
+
+namespace SDLCore {
+
+	class Vertex;
+
+	namespace VertexConverter {
+
+		/*
+		* @brief Converts SDLCore::Vertex (colors 0-255) into SDL_Vertex (colors 0-1).
+		* Positions are transformed with position * scale + offset, colors are clamped.
+		* Uses SSE2 when SDL provides the intrinsics, otherwise a scalar loop.
+		* @param overrideColor if not nullptr every vertex gets this color (already in the range 0-1)
+		*/
+		void Convert(SDL_Vertex* dst,
+			const Vertex* src,
+			size_t count,
+			float xOffset,
+			float yOffset,
+			float xScale,
+			float yScale,
+			const SDL_FColor* overrideColor = nullptr);
+
+	}
+
+}
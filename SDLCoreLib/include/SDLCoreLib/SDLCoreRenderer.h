@@ -13,6 +13,8 @@
 
 namespace SDLCore {
 	class Vertex;
+	class SubTexture;
+	class Mesh;
 }
 
 namespace SDLCore::Render {
@@ -28,6 +30,18 @@ namespace SDLCore::Render {
 		INVALID				= SDL_BLENDMODE_INVALID
 	};
 
+	enum class LineJoin {
+		MITER = 0,	/**< segments are extended until they meet (falls back to BEVEL for sharp angles) */
+		BEVEL,		/**< the corner is cut off */
+		ROUND		/**< the corner is rounded */
+	};
+
+	enum class LineCap {
+		BUTT = 0,	/**< the line ends exactly at the end point */
+		SQUARE,		/**< the line is extended by half the stroke width */
+		ROUND		/**< the line ends with a half circle */
+	};
+
 	/**
 	* @brief Returns the currently active SDL renderer.
 	* @return Pointer to the currently active SDL_Renderer, or nullptr if none is set.
@@ -60,6 +74,16 @@ namespace SDLCore::Render {
 	*/
 	void Present();
 
+	/**
+	* @brief Saves the content of the current render target as a PNG image.
+	*
+	* Has to be called before Present, the content of the back buffer is undefined afterwards.
+	* Layers composited by Present are not included.
+	* @param path Path of the image file.
+	* @return true on success. Call SDLCore::GetError() for more information
+	*/
+	bool SaveFrame(const SystemFilePath& path);
+
 	/**
 	* @brief Sets a uniform render scale on the active SDL renderer.
 	* @param scaleX Horizontal scale factor.
@@ -101,6 +125,89 @@ namespace SDLCore::Render {
 	*/
 	Vector2 GetRenderScale();
 
+	#pragma region Batching
+
+	/**
+	* @brief Draw call statistics of the batched render mode.
+	*/
+	struct BatchStats {
+		size_t recordedDraws = 0;	/**< draw calls recorded into the command buffer */
+		size_t submittedDraws = 0;	/**< SDL_RenderGeometry calls issued to SDL */
+		size_t savedSubmissions = 0;/**< recordedDraws - submittedDraws */
+	};
+
+	/**
+	* @brief Enables or disables the batched render mode.
+	* @param value true = batched, false = immediate (default)
+	*
+	* In batched mode filled rects, thick rects, thick lines, polygons, textures and uncached text are recorded
+	* into a per window command buffer instead of being drawn immediately.
+	* Draws that share texture, blend mode, scale mode and clip rect are merged into one
+	* SDL_RenderGeometry call, as long as no other draw in between overlaps them,
+	* so the result is identical to the immediate mode.
+	* The buffer is submitted on Present, Clear, viewport and render scale changes
+	* and before every draw call that is not batched (cached text, points, 1px lines and rects).
+	*
+	* Textures rendered in batched mode must stay alive until the buffer is submitted.
+	* Disabling the batched mode submits all pending draws of the active window.
+	*/
+	void SetBatchingEnabled(bool value);
+
+	/**
+	* @brief Returns true if the batched render mode is enabled.
+	*/
+	bool IsBatchingEnabled();
+
+	/**
+	* @brief Submits all recorded draw calls of the active window.
+	*
+	* Only needed when mixing the batched mode with direct SDL render calls.
+	*/
+	void FlushBatch();
+
+	/**
+	* @brief Returns the batch statistics of the last presented frame of the active window.
+	* @return Statistics of the last frame, all zero if batching is disabled.
+	*/
+	BatchStats GetBatchStats();
+
+	#pragma endregion
+
+	#pragma region Culling
+
+	/**
+	* @brief Culling statistics of one frame.
+	*/
+	struct CullStats {
+		size_t culledDraws = 0;		/**< draw calls skipped because they were outside of the visible area */
+		size_t submittedDraws = 0;	/**< draw calls that passed the test */
+	};
+
+	/**
+	* @brief Enables or disables culling of draw calls outside of the visible area.
+	* @param value true = cull, false = submit everything (default)
+	*
+	* When enabled, filled and outlined rects, lines, polylines, points, polygons, textures and text are tested
+	* with their bounding box against the viewport and clip rect of the active target,
+	* before any vertex conversion or SDL call. The render scale is taken into account.
+	* Rotated textures use the bounds of the rotated rect, thick strokes include the miter limit.
+	* The visible area is read from SDL once and cached until viewport, clip rect, scale or target change.
+	*/
+	void SetCullingEnabled(bool value);
+
+	/**
+	* @brief Returns true if culling is enabled.
+	*/
+	bool IsCullingEnabled();
+
+	/**
+	* @brief Returns the culling statistics of the last presented frame of the active window.
+	* @return Statistics of the last frame, all zero if culling is disabled.
+	*/
+	CullStats GetCullStats();
+
+	#pragma endregion
+
 	#pragma region ViewportAndClipping
 
 	/**
@@ -233,6 +340,27 @@ namespace SDLCore::Render {
 	*/
 	void SetBlendMode(BlendMode mode);
 
+	/**
+	* @brief Counters of the render state shadow cache.
+	*
+	* State setters (SetColor, SetBlendMode, SetClipRect, SetViewport and the texture color, alpha and scale mods)
+	* only call SDL if the value differs from the last value set on that renderer or texture.
+	*/
+	struct RenderStateStats {
+		uint64_t issuedCalls = 0;	/**< state calls forwarded to SDL */
+		uint64_t skippedCalls = 0;	/**< redundant state calls that were dropped */
+	};
+
+	/**
+	* @brief Returns the counters of the render state shadow cache since start or the last reset.
+	*/
+	RenderStateStats GetRenderStateStats();
+
+	/**
+	* @brief Resets the counters of the render state shadow cache.
+	*/
+	void ResetRenderStateStats();
+
 	#pragma region Color
 
 	/*
@@ -307,6 +435,18 @@ namespace SDLCore::Render {
 	*/
 	void SetInnerStroke(bool value);
 
+	/**
+	* @brief Sets how the segments of thick polylines are connected.
+	* @param join Join type, default is LineJoin::MITER.
+	*/
+	void SetLineJoin(LineJoin join);
+
+	/**
+	* @brief Sets how the ends of thick polylines and line lists are drawn.
+	* @param cap Cap type, default is LineCap::BUTT.
+	*/
+	void SetLineCap(LineCap cap);
+
 	#pragma region Primitives
 
 	#pragma region Rectangle
@@ -464,6 +604,52 @@ namespace SDLCore::Render {
 	*/
 	void Line(const Vector4& poins);
 
+	/**
+	* @brief Draws connected line segments through all points.
+	* @param points Pointer to the first point.
+	* @param count Number of points.
+	* @param closed If true the last point is connected to the first one.
+	*
+	* Strokes wider than 1px are tessellated into a single geometry call using the
+	* active line join (SetLineJoin) and line cap (SetLineCap). The stroke is centered on the points.
+	*/
+	void Polyline(const Vector2* points, size_t count, bool closed = false);
+
+	/**
+	* @brief Draws connected line segments through all points.
+	* @param points List of points.
+	* @param closed If true the last point is connected to the first one.
+	*/
+	void Polyline(const std::vector<Vector2>& points, bool closed = false);
+
+	/**
+	* @brief Draws an open strip of connected line segments, same as Polyline(points, count, false).
+	* @param points Pointer to the first point.
+	* @param count Number of points.
+	*/
+	void LineStrip(const Vector2* points, size_t count);
+
+	/**
+	* @brief Draws an open strip of connected line segments, same as Polyline(points, false).
+	* @param points List of points.
+	*/
+	void LineStrip(const std::vector<Vector2>& points);
+
+	/**
+	* @brief Draws independent line segments, each pair of points is one line.
+	* @param points Pointer to the first point.
+	* @param count Number of points, a trailing unpaired point is ignored.
+	*
+	* Strokes wider than 1px use the active line cap and are submitted with a single geometry call.
+	*/
+	void LineList(const Vector2* points, size_t count);
+
+	/**
+	* @brief Draws independent line segments, each pair of points is one line.
+	* @param points List of points, a trailing unpaired point is ignored.
+	*/
+	void LineList(const std::vector<Vector2>& points);
+
 	#pragma endregion
 
 	/**
@@ -499,6 +685,13 @@ namespace SDLCore::Render {
 		float scaleX = 1.0f,
 		float scaleY = 1.0f);
 
+	/**
+	* @brief Draws a persistent mesh to the current bound window.
+	* @param mesh The mesh that will be drawn. Unchanged meshes are drawn without any vertex conversion.
+	* @return true on success. Call SDLCore::GetError() for more information
+	*/
+	bool Mesh(SDLCore::Mesh& mesh);
+
 	#pragma endregion
 
 	#pragma region Texture
@@ -559,6 +752,31 @@ namespace SDLCore::Render {
 	*/
 	void Texture(SDLCore::Texture& texture, const FRect& transform, const FRect* src = nullptr);
 
+	/**
+	* @brief Draws an image packed into a TextureAtlas.
+	* @param texture Handle of the packed image.
+	* @param x X position of the top left corner.
+	* @param y Y position of the top left corner.
+	* @param w Width (0 = image width).
+	* @param h Height (0 = image height).
+	*/
+	void Texture(const SubTexture& texture, float x, float y, float w = 0, float h = 0);
+
+	/**
+	* @brief Draws an image packed into a TextureAtlas.
+	* @param texture Handle of the packed image.
+	* @param pos Position of the top left corner.
+	* @param size Size (0 = image size).
+	*/
+	void Texture(const SubTexture& texture, const Vector2& pos, const Vector2& size = Vector2{ 0, 0 });
+
+	/**
+	* @brief Draws an image packed into a TextureAtlas.
+	* @param texture Handle of the packed image.
+	* @param transform Destination rectangle (x, y, width, height).
+	*/
+	void Texture(const SubTexture& texture, const FRect& transform);
+
 	#pragma endregion
 
 	#pragma region Text
@@ -568,6 +786,7 @@ namespace SDLCore::Render {
 	*
 	* For text that changes infrequently or remains constant, enabling caching
 	* via `CachText(true)` can improve performance by pre-rendering the text.
+	* Uncached text is submitted as one geometry call per text block.
 	*
 	* @param text The text to draw.
 	* @param x X position in pixels.
@@ -586,6 +805,27 @@ namespace SDLCore::Render {
 	*/
 	void Text(const std::string& text, const Vector2& pos);
 
+	/**
+	* @brief Draws an editable text block at the specified position using the active font.
+	*
+	* Only the part of the block that was edited since the last draw is laid out again
+	* and only the changed lines are rendered into the texture of the block.
+	* The text cache, max lines and the text limit are not used for blocks.
+	*
+	* @param block The text block to draw.
+	* @param x X position in pixels.
+	* @param y Y position in pixels.
+	*/
+	void Text(TextBlock& block, float x, float y);
+
+	/**
+	* @brief Draws an editable text block at the specified position using the active font.
+	*
+	* @param block The text block to draw.
+	* @param pos X,Y position of the text in pixels.
+	*/
+	void Text(TextBlock& block, const Vector2& pos);
+
 	/**
 	* @brief Draws formatted text at the specified position using the active font.
 	*
@@ -620,6 +860,7 @@ namespace SDLCore::Render {
 	*
 	* When enabled, the renderer will pre-render the text and store it for faster repeated rendering.
 	* Cached text that is not used for a certain number of frames will be automatically removed.
+	* If the cached texture memory exceeds the budget (see SetTextCacheBudget), the least recently used entries are removed.
 	*
 	* @param value True to enable caching, false to disable.
 	*/
@@ -645,6 +886,55 @@ namespace SDLCore::Render {
 	*/
 	size_t GetNumberOfCachedTexts();
 
+	/**
+	* @brief Statistics of the text cache.
+	*/
+	struct TextCacheStats {
+		size_t entries = 0;			/**< number of cached texts */
+		size_t pinnedEntries = 0;	/**< number of pinned cached texts */
+		size_t textureBytes = 0;	/**< estimated memory of all pre-rendered textures */
+		size_t budgetBytes = 0;		/**< texture memory budget, 0 = no limit */
+		uint64_t hits = 0;			/**< cached renders that reused an entry */
+		uint64_t misses = 0;		/**< cached renders that had to pre-render the text */
+		uint64_t evictions = 0;		/**< entries removed by the budget or the unused frame limit */
+	};
+
+	/**
+	* @brief Pins or unpins the cached version of a text for the current text settings.
+	*
+	* Pinned entries are never removed by the memory budget or the unused frame limit,
+	* only by ClearTextCache or when the renderer is destroyed.
+	* Pinning a text that is not cached yet pre-renders it.
+	*
+	* @param text The text as it is passed to Text.
+	* @param value True to pin, false to unpin.
+	* @return false if the entry could not be found or created.
+	*/
+	bool PinCachedText(const std::string& text, bool value = true);
+
+	/**
+	* @brief Sets the memory budget of the pre-rendered text textures.
+	* @param bytes Budget in bytes, 0 = no limit. Default is 64 MB.
+	*
+	* Least recently used entries are removed immediately if the cache exceeds the new budget.
+	*/
+	void SetTextCacheBudget(size_t bytes);
+
+	/**
+	* @brief Returns the memory budget of the pre-rendered text textures in bytes.
+	*/
+	size_t GetTextCacheBudget();
+
+	/**
+	* @brief Returns the statistics of the text cache.
+	*/
+	TextCacheStats GetTextCacheStats();
+
+	/**
+	* @brief Resets the hit, miss and eviction counters of the text cache.
+	*/
+	void ResetTextCacheStats();
+
 	/**
 	* @brief Resets all text rendering parameters to their default values.
 	*
@@ -1,14 +1,34 @@
 #pragma once
+#include <cstddef>
 #include <cstdint>
 
 namespace SDLCore {
 
     class Application;
 
+    /**
+    * @brief Statistics over the recorded frame times, see Time::GetFrameTimeStats
+    */
+    struct FrameTimeStats {
+        size_t sampleCount = 0;     /**< number of recorded frames, at most Time::FRAME_HISTORY_SIZE */
+        float averageMS = 0.0f;
+        float minMS = 0.0f;
+        float maxMS = 0.0f;
+        float p50MS = 0.0f;         /**< median frame time */
+        float p95MS = 0.0f;
+        float p99MS = 0.0f;
+        size_t hitchCount = 0;      /**< recorded frames above the hitch threshold */
+    };
+
     class Time {
         friend class Application;
 
     public:
+        /**
+        * @brief Number of frame times that are kept for the frame time statistics
+        */
+        static constexpr size_t FRAME_HISTORY_SIZE = 256;
+
         /*
         * @brief Gets the current number of frames since application instance creation
         * @return Current frame count
@@ -75,6 +95,122 @@ namespace SDLCore {
         */
         static double GetFrameRateHzD();
 
+        /**
+        * @brief Gets the number of fixed update ticks since application instance creation
+        * @return Fixed tick count
+        */
+        static uint64_t GetFixedTickCount();
+
+        /**
+        * @brief Gets the number of fixed update ticks that were dropped because a frame
+        * needed more catch-up ticks than allowed (see Application::SetMaxFixedStepsPerFrame)
+        * @return Dropped tick count
+        */
+        static uint64_t GetDroppedFixedTickCount();
+
+        /**
+        * @brief Gets the simulated time of the fixed update in seconds (fixed tick count * fixed delta time)
+        * @return Simulated time in seconds
+        */
+        static double GetFixedTimeSecD();
+
+        /**
+        * @brief Gets the length of one fixed update tick in milliseconds
+        * @return Fixed delta time in milliseconds, 0 if the fixed update is disabled
+        */
+        static float GetFixedDeltaTimeMSF();
+
+        /**
+        * @brief Gets the length of one fixed update tick in seconds
+        * @return Fixed delta time in seconds, 0 if the fixed update is disabled
+        */
+        static float GetFixedDeltaTimeSecF();
+
+        /**
+        * @brief Gets the length of one fixed update tick in seconds
+        * @return Fixed delta time in seconds, 0 if the fixed update is disabled
+        */
+        static double GetFixedDeltaTimeSecD();
+
+        /**
+        * @brief Gets the fixed update tick rate
+        * @return Ticks per second, 0 if the fixed update is disabled
+        */
+        static double GetFixedTickRateHzD();
+
+        /**
+        * @brief Gets how far the current frame is between the last and the next fixed update tick.
+        *
+        * Used to interpolate rendering between the last two simulated states:
+        * renderState = Lerp(previousState, currentState, alpha)
+        *
+        * @return Value between 0 and 1. Always 1 if the fixed update runs as fast as possible
+        */
+        static float GetInterpolationAlphaF();
+
+        /**
+        * @brief Same as GetInterpolationAlphaF with double precision
+        */
+        static double GetInterpolationAlphaD();
+
+        /**
+        * @brief Gets the number of recorded frame times (at most FRAME_HISTORY_SIZE)
+        */
+        static size_t GetFrameHistoryCount();
+
+        /**
+        * @brief Copies the recorded frame times in milliseconds, from the oldest to the newest
+        * @param out buffer that receives the frame times
+        * @param maxCount size of out, if smaller than the history only the newest frames are copied
+        * @return Number of copied frame times
+        */
+        static size_t GetFrameHistory(float* out, size_t maxCount);
+
+        /**
+        * @brief Gets the average frame time of the recorded frames in milliseconds
+        */
+        static float GetAverageFrameTimeMSF();
+
+        /**
+        * @brief Gets the average frame rate of the recorded frames, less noisy than GetFrameRateHzF
+        * @return Frames per second
+        */
+        static float GetAverageFrameRateHzF();
+
+        /**
+        * @brief Gets a percentile of the recorded frame times in milliseconds (O(n) selection)
+        * @param percentile between 0 and 100, 50 = median
+        */
+        static float GetFrameTimePercentileMSF(float percentile);
+
+        /**
+        * @brief Gets average, min, max, p50, p95, p99 and hitches of the recorded frames.
+        * Computed on demand once per frame, later calls of the same frame return the cached result
+        */
+        static const FrameTimeStats& GetFrameTimeStats();
+
+        /**
+        * @brief Sets the frame time above which a frame counts as hitch
+        * @param ms Threshold in milliseconds (default 50)
+        */
+        static void SetHitchThresholdMS(float ms);
+
+        /**
+        * @brief Gets the frame time above which a frame counts as hitch in milliseconds
+        */
+        static float GetHitchThresholdMS();
+
+        /**
+        * @brief Gets the number of hitches since application start or the last ResetFrameTimeStats
+        * (not limited to the recorded frames)
+        */
+        static uint64_t GetTotalHitchCount();
+
+        /**
+        * @brief Clears the recorded frame times and the hitch count
+        */
+        static void ResetFrameTimeStats();
+
     private:
         Time() = delete;
 
@@ -82,6 +218,35 @@ namespace SDLCore {
         * @brief Updates internal timing info, called by Application each frame
         */
         static void Update();
+
+        /**
+        * @brief Removes time from the next delta time (and with that the fixed update and the frame statistics).
+        * Called by Application after it waited in idle mode
+        */
+        static void SkipTime(uint64_t ns);
+
+        /**
+        * @brief Sets the fixed update tick rate, 0 disables the fixed update
+        */
+        static void SetFixedTickRate(double hz);
+
+        /**
+        * @brief Adds the delta time of this frame to the fixed update accumulator. Called by Application each frame
+        * @param maxSteps max ticks of one frame, the backlog above is dropped
+        * @param fastAsPossible true = ignores the real time and always returns maxSteps
+        * @return Number of fixed update ticks to run this frame
+        */
+        static uint32_t ConsumeFixedSteps(uint32_t maxSteps, bool fastAsPossible);
+
+        /**
+        * @brief Advances the fixed tick count, called by Application before every OnFixedUpdate
+        */
+        static void AdvanceFixedTick();
+
+        /**
+        * @brief Adds a frame time to the frame history
+        */
+        static void RecordFrameTime(float ms);
     };
 
 }
\ No newline at end of file
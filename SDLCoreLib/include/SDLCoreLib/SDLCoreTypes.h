@@ -1,5 +1,6 @@
 #include "Types/Font/Font.h"
 #include "Types/Texture.h"
+#include "Types/TextBlock.h"
 #include "Types/Version.h"
 #include "Types/Vertex.h"
 #include "Types/Types.h"
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+#include <mutex>
+#include <string>
+#include <vector>
+#include <string_view>
+#include <unordered_map>
+
+#include "Types/Types.h"
+#include "Internal/MappedFile.h"
+#include "Internal/AssetPackFormat.h"
+
+struct SDL_IOStream;
+namespace SDLCore {
+
+	/**
+	* @brief Read only archive of asset files written by the AssetPacker tool (see AssetPackWriter).
+	*
+	* The pack is memory mapped, entries are found through a hashed index without touching the filesystem.
+	* Stored entries are read directly from the mapping without a copy, compressed entries
+	* are decompressed on access. Entry names use '/' as separator and are relative to the pack root.
+	*
+	* Texture, SoundClip, Font and the AssetLoader can load directly from an entry.
+	* The pack has to stay open as long as assets that stream from it are used
+	* (fonts and sound clips that are not predecoded).
+	*
+	* OpenIO and Verify can be called from any thread
+	*/
+	class AssetPack {
+	public:
+		AssetPack() = default;
+		explicit AssetPack(const SystemFilePath& path);
+
+		AssetPack(const AssetPack&) = delete;
+		AssetPack& operator=(const AssetPack&) = delete;
+
+		/**
+		* @brief Maps a pack file and validates its header and index, a previously opened pack is closed
+		* @return true on success. Call SDLCore::GetError() for more information
+		*/
+		bool Open(const SystemFilePath& path);
+		void Close();
+
+		bool IsOpen() const;
+		const SystemFilePath& GetPath() const;
+		size_t GetEntryCount() const;
+
+		/**
+		* @brief Returns the name of an entry, in the order of the index
+		*/
+		std::string_view GetEntryPath(size_t index) const;
+
+		bool Contains(std::string_view path) const;
+
+		/**
+		* @brief Returns the decompressed size of an entry in bytes, 0 if it does not exist
+		*/
+		size_t GetEntrySize(std::string_view path) const;
+
+		bool IsCompressed(std::string_view path) const;
+
+		/**
+		* @brief Opens a read only stream of an entry.
+		* Stored entries are read from the mapping, compressed entries are decompressed into a buffer
+		* that is freed when the stream is closed
+		* @return nullptr on failure. Call SDLCore::GetError() for more information (not on other threads)
+		*/
+		SDL_IOStream* OpenIO(std::string_view path) const;
+
+		/**
+		* @brief Same as OpenIO, reports the error in outError instead of SDLCore::GetError(). Used on loader threads
+		*/
+		SDL_IOStream* OpenIO(std::string_view path, std::string& outError) const;
+
+		/**
+		* @brief Returns the bytes of an entry that stay valid as long as the pack is open.
+		* Compressed entries are decompressed once and kept by the pack
+		* @return nullptr if the entry does not exist or could not be decompressed
+		*/
+		const uint8_t* GetData(std::string_view path, size_t& outSize);
+
+		/**
+		* @brief Checks the stored bytes of an entry against the checksum of the index
+		*/
+		bool Verify(std::string_view path) const;
+
+		/**
+		* @brief Verifies every entry, corrupted entries are logged
+		* @return false if at least one entry is corrupted
+		*/
+		bool VerifyAll() const;
+
+	private:
+		SystemFilePath m_path;
+		MappedFile m_file;
+		const AssetPackFormat::Header* m_header = nullptr;
+		const AssetPackFormat::Entry* m_entries = nullptr;
+		const char* m_paths = nullptr;
+
+		std::mutex m_dataMutex;
+		std::unordered_map<const AssetPackFormat::Entry*, std::vector<uint8_t>> m_decompressed;// of GetData
+
+		const AssetPackFormat::Entry* FindEntry(std::string_view path) const;
+		std::string_view GetEntryPath(const AssetPackFormat::Entry& entry) const;
+		bool VerifyEntry(const AssetPackFormat::Entry& entry) const;
+
+		/*
+		* @brief decompresses a compressed entry into out
+		* @return false and sets outError if the entry is corrupted
+		*/
+		bool DecompressEntry(const AssetPackFormat::Entry& entry, uint8_t* out, std::string& outError) const;
+	};
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <string_view>
+#include <unordered_set>
+
+#include "Types/Types.h"
+
+namespace SDLCore {
+
+	/**
+	* @brief Builds an asset pack file that can be opened with AssetPack. Used by the AssetPacker tool.
+	*
+	* All added data is kept in memory until Write is called.
+	*/
+	class AssetPackWriter {
+	public:
+		/**
+		* A compressed entry is only stored compressed if it is at most this fraction of the original size,
+		* already compressed formats (png, ogg, ...) are stored as they are
+		*/
+		static constexpr float MAX_COMPRESSION_RATIO = 0.9f;
+
+		AssetPackWriter() = default;
+
+		/**
+		* @brief Adds the content of a file under the given entry name
+		* @param compress true = the entry is compressed if it gets smaller
+		* @return true on success. Call SDLCore::GetError() for more information
+		*/
+		bool AddFile(const SystemFilePath& file, std::string_view entryPath, bool compress = false);
+
+		/**
+		* @brief Adds every file of a directory and its sub directories, the entry names are relative to the directory
+		* @param compress true = the entries are compressed if they get smaller
+		* @return true on success. Call SDLCore::GetError() for more information
+		*/
+		bool AddDirectory(const SystemFilePath& dir, bool compress = false);
+
+		/**
+		* @brief Adds data from memory under the given entry name
+		* @param compress true = the entry is compressed if it gets smaller
+		* @return true on success. Call SDLCore::GetError() for more information
+		*/
+		bool AddData(std::string_view entryPath, const void* data, size_t size, bool compress = false);
+
+		/**
+		* @brief Writes the pack, the file is replaced only after it was written completely
+		* @return true on success. Call SDLCore::GetError() for more information
+		*/
+		bool Write(const SystemFilePath& path) const;
+
+		size_t GetEntryCount() const;
+
+		/**
+		* @brief Sum of the stored entry sizes in bytes
+		*/
+		size_t GetStoredSize() const;
+
+		/**
+		* @brief Sum of the original entry sizes in bytes
+		*/
+		size_t GetOriginalSize() const;
+
+	private:
+		struct PendingEntry {
+			std::string path;
+			std::vector<uint8_t> data;// stored bytes
+			uint64_t size = 0;
+			bool compressed = false;
+		};
+
+		std::vector<PendingEntry> m_entries;
+		std::unordered_set<std::string> m_paths;
+	};
+
+}
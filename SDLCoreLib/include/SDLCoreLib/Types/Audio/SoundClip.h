@@ -1,4 +1,6 @@
 #pragma once
+#include <string_view>
+#include <functional>
 #include <CoreLib/Math/Vector2.h>
 #include <SDL3_mixer/SDL_mixer.h>
 #include "Types/Types.h"
@@ -22,6 +24,8 @@ namespace SDLCore {
     */
 
     class SoundManager;
+    class AssetLoader;
+    class AssetPack;
 
     enum class SoundType {
         AUTO = 0,       /**< Selects automaticly wich type to use depending on its length. (< 2s = Predecoded; 2-10s = Not predecoded; >10s = Stream)*/
@@ -31,6 +35,7 @@ namespace SDLCore {
 
     class SoundClip {
         friend class SoundManager;
+        friend class AssetLoader;
     public:
         SoundClip() = default;
 
@@ -42,6 +47,14 @@ namespace SDLCore {
         *         contain SDLCORE_INVALID_ID. Call SDLCore::GetError() for details.
         */
         SoundClip(const SystemFilePath& path, SoundType type = SoundType::AUTO);
+
+        /**
+        * @brief Constructs a sound clip from an entry of an asset pack.
+        * @param pack Opened asset pack, has to stay open while a clip that is not predecoded is played.
+        * @param path Name of the entry in the pack.
+        * @param type Sound type used for loading (default AUTO).
+        */
+        SoundClip(const AssetPack& pack, std::string_view path, SoundType type = SoundType::AUTO);
         SoundClip(const SoundClip& other);
         SoundClip(SoundClip&& other) noexcept;
         ~SoundClip();
@@ -184,10 +197,24 @@ namespace SDLCore {
         bool LoadSound(const SystemFilePath& path, SoundType type);
 
         /*
-        * @brief loads audio staticly 
+        * @brief loads the audio and sets the clip infos, does not touch the SoundManager
+        * so it can run on a loader thread
+        * @return the loaded audio or nullptr, outError is set on failure
+        */
+        MIX_Audio* DecodeAudio(const SystemFilePath& path, SoundType type, std::string& outError);
+        MIX_Audio* DecodeAudio(const AssetPack& pack, std::string_view path, SoundType type, std::string& outError);
+
+        /*
+        * @param openIO opens a new stream of the audio data, the audio is opened twice if it is not predecoded
+        */
+        MIX_Audio* DecodeAudioIO(const std::string& name, const std::function<SDL_IOStream*(std::string& outError)>& openIO,
+            SoundType type, std::string& outError);
+
+        /*
+        * @brief gives the audio to the SoundManager under a new id, has to be called on the main thread
         * @return true on success. Call SDLCore::GetError() for more information
         */
-        bool CreateStaticAudio(const char* path, bool predecode);
+        bool RegisterAudio(MIX_Audio* audio);
     };
 
 }
@@ -1,16 +1,37 @@
 #pragma once
 #include <vector>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include "Types/Font/FontAsset.h"
 #include "Types/Types.h"
 
 namespace SDLCore {
 
+	struct FontAssetKey;
+	class AssetPack;
+	class AssetLoader;
+
+	/*
+	* Font assets are shared between all Font objects through a process wide cache,
+	* two fonts with the same file or data, size, style and SDF mode use the same atlas.
+	*
+	* New sizes are generated on a worker thread once the font has a ready size,
+	* until then GetFontAsset returns the ready asset with the nearest size
+	*/
 	class Font {
+	friend class AssetLoader;
 	public:
+		static constexpr float SDF_BASE_SIZE = 48.0f;
+
 		Font(bool useDefaultFont = false, size_t cachedSizes = 20);
 		Font(const SystemFilePath& path, std::vector<float> sizes = {}, size_t cachedSizes = 20);
 		Font(const unsigned char* data, size_t dataSize, std::vector<float> fontSizes = {}, size_t cachedSizes = 20);
+		/*
+		* @brief loads the font from an entry of an asset pack, the pack has to stay open as long as the font is used
+		*/
+		Font(AssetPack& pack, std::string_view path, std::vector<float> fontSizes = {}, size_t cachedSizes = 20);
 
 		Font* SelectSize(float size);
 		Font* SetCachSize(size_t size);
@@ -22,9 +43,21 @@ namespace SDLCore {
 		Font* SetFontData(const unsigned char* data, size_t dataSize);
 		Font* Setpath(const SystemFilePath& path);
 		Font* SetDefaultFont(bool active);
+		/*
+		* @brief enables the signed distance field mode. All sizes are rendered from a
+		* single asset with the size SDF_BASE_SIZE, changing the size never rasterizes glyphs again
+		*/
+		Font* SetSDF(bool active);
+		/*
+		* @brief sets the TTF_STYLE_* flags used for all sizes of this font
+		*/
+		Font* SetStyle(Uint32 style);
 		Font* Clear();
 
 		FontAsset* GetFontAsset();
+		/*
+		* @brief returns the asset of the size or, while it is generated, the ready asset with the nearest size
+		*/
 		FontAsset* GetFontAsset(float size);
 
 		float GetSelectedSize() const;
@@ -32,21 +65,66 @@ namespace SDLCore {
 		std::string GetFileName() const;
 		size_t GetCachSize() const;
 		size_t GetNumberOfCachedFontAssets() const;
+		bool IsSDF() const;
+		Uint32 GetStyle() const;
+
+		/*
+		* @brief sets the memory budget of the shared font asset cache in bytes (0 = no limit).
+		* Assets that are still used by a Font are never destroyed
+		*/
+		static void SetSharedCacheBudget(size_t bytes);
+		static size_t GetSharedCacheBudget();
+		/*
+		* @brief estimated memory of all shared atlas surfaces and textures in bytes
+		*/
+		static size_t GetSharedCacheMemoryUsage();
+		static size_t GetNumberOfSharedFontAssets();
+
+		/*
+		* @brief sets the directory of the glyph atlas disk cache, an empty path disables it.
+		* Default is '<pref path>/FontAtlasCache'
+		*/
+		static void SetAtlasCacheDirectory(const SystemFilePath& dir);
+		static SystemFilePath GetAtlasCacheDirectory();
 
 	private:
 		bool m_isInvalid = false;// if the font is invalid. example path is not valid
 		bool m_loadedFromMem = false;
 		bool m_useDefault = false;// if the default font is active
 		bool m_isFilePathInvalidValid = false;
+		bool m_sdf = false;
+		Uint32 m_style = 0;// TTF_STYLE_NORMAL
 		SystemFilePath m_path;
 		const unsigned char* m_fontData = nullptr;
 		size_t m_fontDataSize = 0;
-		std::vector<FontAsset> m_fontAssets;
+
+		struct FontAssetRef {
+			std::shared_ptr<FontAsset> asset;
+			size_t lastUseTick = 0;
+		};
+		std::unordered_map<float, FontAssetRef> m_fontAssets;// key is the asset size
 		size_t m_maxFontSizesCached = 10;/**< number of font sizes that get stored at the same time */
 
 		size_t m_globalAccessCounter = 0;
 		float m_selectedSize = -1.0f;
 
+		float GetAssetSize(float size) const;
+		/*
+		* @brief returns the key of the shared cache, the fallback font is used for an invalid path
+		*/
+		FontAssetKey GetAssetKey(float assetSize) const;
+
+		/*
+		* @brief creates the asset of a size with its atlas, without adding it to the shared cache.
+		* Runs on the AssetLoader threads, the asset is added on the main thread by AddDecodedFontAsset
+		* @param outAsset stays nullptr if the shared cache already has the asset
+		* @return false if the font could not be opened, outError is set
+		*/
+		bool DecodeFontAsset(float size, std::shared_ptr<FontAsset>& outAsset, std::string& outError) const;
+		void AddDecodedFontAsset(float size, std::shared_ptr<FontAsset> asset);
+		bool AcquireSharedFontAsset(const FontAssetKey& key);
+		FontAsset* GetNearestReadyFontAsset(float size) const;
+		void AddSharedFontAsset(const FontAssetKey& key, TTF_Font* font);
 		bool CreateFontAsset(float size);
 		bool CreateFontAssetFromMem(const unsigned char* data, size_t dataSize, float fontSize);
 		bool CreateFallbackFontAsset(float size);
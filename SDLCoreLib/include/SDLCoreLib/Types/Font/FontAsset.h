@@ -1,5 +1,7 @@
 #pragma once
 #include <array>
+#include <atomic>
+#include <vector>
 #include <unordered_map>
 
 #include "Types/Types.h"
@@ -12,10 +14,38 @@ struct TTF_Font;
 namespace SDLCore {
 	/*
 	* @brief is a helper class used for the Font class. Should not be used
+	*
+	* Glyphs are stored in square atlas pages that are filled with shelf packing.
+	* ASCII 32-126 is rasterized on creation and never evicted, every other code point
+	* is rasterized on first use. If all pages are full, glyphs that were not used
+	* in the current frame are evicted (least recently used first).
+	* Only the changed area of a page is uploaded to the window textures.
+	*
+	* In SDF mode the atlas stores signed distance fields that are remapped to a one pixel
+	* alpha ramp around the glyph edge, the asset is created once per font and scaled
+	* to the selected text size by the renderer.
+	*
+	* A deferred asset generates its atlas on the FontAtlasWorker thread, it can not be
+	* used until IsReady() returns true.
+	*
+	* If a disk cache file is set, the initial atlas is loaded from the memory mapped file
+	* instead of being rasterized, and written to it after it was rasterized.
 	*/
 	class FontAsset {
+	friend class FontAtlasWorker;
+	friend class FontAssetCache;
+	friend class Font;
 	public:
-		FontAsset(TTF_Font* font, float size);
+		static constexpr int MIN_GLYPH_ATLAS_PAGE_SIZE = 512;
+		static constexpr int MAX_GLYPH_ATLAS_PAGE_SIZE = 4096;
+		static constexpr int MAX_GLYPH_ATLAS_PAGES = 4;
+		static constexpr int NO_GLYPH = -1;
+		static constexpr int SDF_SPREAD = 8;// distance in pixels covered by the field on each side of the edge (FreeType default)
+
+		/**
+		* @param deferred true = the atlas is generated later by the FontAtlasWorker
+		*/
+		FontAsset(TTF_Font* font, float size, bool sdf = false, bool deferred = false);
 		~FontAsset();
 
 		FontAsset(const FontAsset&) noexcept;
@@ -27,32 +57,135 @@ namespace SDLCore {
 		float m_fontSize = -1;
 		size_t m_lastUseTick = 0;
 		FontResource m_font;
-		TextureSurface m_glyphAtlasSurf;
 		int m_ascent = 0;
 		int m_descent = 0;
 		int m_lineSkip = 0;
+		bool m_sdf = false;
+
+		/**
+		* @brief Returns true once the glyph atlas is generated
+		*/
+		bool IsReady() const;
 
+		/**
+		* @brief Returns true while the atlas of a deferred asset is not generated yet
+		*/
+		bool IsPending() const;
+
+		/**
+		* @brief Returns the metrics of a code point, rasterizes the glyph if it is not in the atlas yet
+		* @param code Unicode code point
+		* @return nullptr if the glyph can not be rasterized or is a control character
+		*/
 		GlyphMetrics* GetGlyphMetrics(uint32_t code);
-		SDL_Texture* GetGlyphAtlasTexture(WindowID winID);
+
+		/**
+		* @brief Returns the advance of a code point in pixels of this asset, used to measure text.
+		* ASCII is read from the pinned glyph table, other advances are kept after the glyph
+		* was evicted from the atlas, measuring does not rasterize a glyph again
+		* @return NO_GLYPH if the code point has no glyph or is a control character
+		*/
+		int GetGlyphAdvance(uint32_t code);
+
+		/**
+		* @brief Returns the texture of an atlas page for a window, pending glyph changes are uploaded first
+		* @param page Index of the atlas page (GlyphMetrics::atlasPage)
+		*/
+		SDL_Texture* GetGlyphAtlasTexture(WindowID winID, int page = 0);
+
+		/**
+		* @brief Returns the number of atlas pages that are currently allocated
+		*/
+		int GetGlyphAtlasPageCount() const;
+
+		/**
+		* @brief Returns the width and height of every atlas page in pixels
+		*/
+		int GetGlyphAtlasPageSize() const;
+
+		/**
+		* @brief Returns the estimated memory of the atlas surfaces and window textures in bytes
+		*/
+		size_t GetMemoryUsage() const;
+
+		/**
+		* @brief Returns an id that is unique for every asset created in this process.
+		* Used as key of cached text layouts, an address can be reused by a later asset
+		*/
+		uint64_t GetID() const;
 
 	private:
+		uint64_t m_id = NextID();
+		static uint64_t NextID();
+
+		enum class State : uint8_t {
+			PENDING,
+			READY,
+			FAILED
+		};
+		std::atomic<State> m_state{ State::PENDING };
+
+		struct GlyphShelf {
+			int y = 0;
+			int height = 0;
+			int cursorX = 0;
+		};
+
+		struct GlyphPage {
+			TextureSurface surface;
+			std::vector<GlyphShelf> shelves;
+			std::vector<SDL_Rect> freeSlots;// slots of evicted glyphs
+			int shelfBottom = 0;
+			int glyphCount = 0;// glyphs that can be evicted
+			bool pinned = false;// contains ASCII glyphs, is never reset
+			std::unordered_map<WindowID, SDL_Texture*> textures;
+			std::unordered_map<WindowID, SDL_Rect> dirtyRects;// area that is not uploaded yet per texture
+		};
+
+		struct CachedGlyph {
+			GlyphMetrics metrics;
+			SDL_Rect slot{ 0, 0, 0, 0 };
+			uint64_t lastUseFrame = 0;
+		};
+
 		std::array<GlyphMetrics, 256> m_asciiGlyphs;
-		std::array<bool, 256> m_asciiPresent;
+		std::array<bool, 256> m_asciiPresent{};
 
-		std::unordered_map<Uint32, GlyphMetrics> m_charToGlyphMetrics;
-		std::unordered_map<WindowID, SDL_Texture*> m_winIDToGlyphAtlasTexture;
+		std::vector<GlyphPage> m_pages;
+		int m_pageSize = MIN_GLYPH_ATLAS_PAGE_SIZE;
+		bool m_atlasFullWarned = false;
+		std::unordered_map<Uint32, CachedGlyph> m_charToGlyphMetrics;
+		std::unordered_map<Uint32, bool> m_failedGlyphs;// code points that could not be rasterized
+		std::unordered_map<Uint32, int> m_advances;// advances of non ASCII code points, never evicted
 		std::unordered_map<WindowID, WindowCallbackID> m_winIDToWinCallbackID;
 
+		SystemFilePath m_atlasCacheFile;// empty = no disk cache
+		uint64_t m_atlasCacheID = 0;
+
 		void CopyFrom(const FontAsset& other) noexcept;
 		void MoveFrom(FontAsset&& other) noexcept;
 		void Cleanup();
 
-		TextureSurface GenerateGlypeAtlas(TTF_Font* font, float size);
-		SDL_Texture* CreateTextureForWindow(WindowID winID);
+		/*
+		* Generates the atlas surfaces and sets the state, only touches surfaces
+		* so it can run on the worker thread
+		*/
+		void GenerateAtlas();
+		bool GenerateGlypeAtlas(TTF_Font* font);
+		bool LoadAtlasCache();
+		bool SaveAtlasCache() const;
+		GlyphMetrics* RasterizeGlyph(Uint32 code, bool pinned);
+		bool AllocateSlot(int w, int h, int& outPage, SDL_Rect& outSlot);
+		bool AllocateInPage(GlyphPage& page, int w, int h, SDL_Rect& outSlot);
+		bool AddPage();
+		bool EvictGlyphs(int w, int h, int& outPage, SDL_Rect& outSlot);
+		void MarkPageDirty(GlyphPage& page, const SDL_Rect& rect);
+
+		SDL_Texture* CreateTextureForWindow(WindowID winID, int page);
 		void FreeTextureForWindow(WindowID winID);
 
 		void RemoveAllWindowCloseCB();
 		void RemoveWindowCloseCB(WindowID winID);
 	};
 
-}
\ No newline at end of file
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 
 namespace SDLCore {
 
@@ -14,7 +15,7 @@ namespace SDLCore {
     */
     class GlyphMetrics {
     public:
-        char code = 'a';          /**< Character code associated with this glyph. */
+        uint32_t code = 'a';      /**< Unicode code point associated with this glyph. */
 
         // --- Font metrics (baseline-relative) ---
         int minX = 0;       /**< Minimum horizontal offset from pen position. */
@@ -28,6 +29,7 @@ namespace SDLCore {
         int atlasY = 0;     /**< Y coordinate inside the glyph atlas texture. */
         int atlasWidth = 0; /**< Actual rendered glyph width in atlas. */
         int atlasHeight = 0;/**< Actual rendered glyph height in atlas. */
+        int atlasPage = 0;  /**< Index of the atlas page that contains the glyph. */
 
         GlyphMetrics() = default;
 
@@ -35,7 +37,7 @@ namespace SDLCore {
         * @brief Constructs glyph metrics for a specific codepoint.
         * @param ch Character code stored as unsigned integer (UTF-32 scalar).
         */
-        GlyphMetrics(char ch);
+        GlyphMetrics(uint32_t ch);
 
         /**
         * @brief Returns the glyph width based on metrics (maxX - minX).
@@ -0,0 +1,130 @@
+#pragma once
+#include <vector>
+#include <SDL3/SDL.h>
+#include <CoreLib/Math/Vector2.h>
+
+#include "Types/Vertex.h"
+#include "Types/Types.h"
+
+namespace SDLCore {
+
+	class Texture;
+
+	/**
+	* @brief Persistent geometry that is converted to SDL_Vertex once and drawn without per frame conversion.
+	*
+	* Vertices are converted when they are set or updated. Position and scale are applied
+	* to a second buffer that is only rebuilt when the transform, the vertices or the active
+	* color (untextured meshes) change, so drawing an unchanged mesh performs no conversion and no allocation.
+	* Like Render::Polygon, untextured meshes are drawn with the active color of the renderer
+	* and textured meshes with their vertex colors.
+	*
+	* The texture is not owned by the mesh and has to outlive it.
+	*/
+	class Mesh {
+	public:
+		Mesh() = default;
+
+		/**
+		* @param vertices Pointer to the first vertex.
+		* @param vertexCount Number of vertices.
+		* @param indices Optional index buffer (nullptr = vertices are a plain triangle list).
+		* @param indexCount Number of indices.
+		*/
+		Mesh(const Vertex* vertices, size_t vertexCount, const int* indices = nullptr, size_t indexCount = 0);
+		Mesh(const std::vector<Vertex>& vertices, const std::vector<int>& indices = {});
+
+		/**
+		* @brief Replaces all vertices.
+		*/
+		Mesh* SetVertices(const Vertex* vertices, size_t count);
+		Mesh* SetVertices(const std::vector<Vertex>& vertices);
+
+		/**
+		* @brief Overwrites a range of vertices, only this range is converted again.
+		* @param offset Index of the first vertex to overwrite.
+		* @param vertices Pointer to the new vertices.
+		* @param count Number of vertices.
+		* @return false if the range is out of bounds. Call SDLCore::GetError() for more information
+		*/
+		bool UpdateVertices(size_t offset, const Vertex* vertices, size_t count);
+
+		/**
+		* @brief Replaces the index buffer. Every 3 indices define one triangle.
+		* @param indices Pointer to the first index, nullptr removes the index buffer.
+		*/
+		Mesh* SetIndices(const int* indices, size_t count);
+		Mesh* SetIndices(const std::vector<int>& indices);
+
+		/**
+		* @brief Overwrites a range of indices.
+		* @return false if the range is out of bounds. Call SDLCore::GetError() for more information
+		*/
+		bool UpdateIndices(size_t offset, const int* indices, size_t count);
+
+		/**
+		* @brief Removes all vertices and indices.
+		*/
+		Mesh* Clear();
+
+		/**
+		* @brief Sets the texture sampled by the mesh (nullptr = untextured).
+		*/
+		Mesh* SetTexture(Texture* texture);
+
+		/**
+		* @brief Sets the translation applied to all vertices.
+		*/
+		Mesh* SetPosition(float x, float y);
+		Mesh* SetPosition(const Vector2& position);
+
+		/**
+		* @brief Sets the scale applied to all vertices (before the translation).
+		*/
+		Mesh* SetScale(float x, float y);
+		Mesh* SetScale(float scale);
+		Mesh* SetScale(const Vector2& scale);
+
+		Texture* GetTexture() const;
+		Vector2 GetPosition() const;
+		Vector2 GetScale() const;
+		size_t GetVertexCount() const;
+		size_t GetIndexCount() const;
+
+		/**
+		* @brief Returns the bounds of the untransformed vertices.
+		*/
+		FRect GetLocalBounds();
+
+		/**
+		* @brief Draws the mesh to the active window.
+		* @return true on success. Call SDLCore::GetError() for more information
+		*/
+		bool Render();
+
+	private:
+		std::vector<SDL_Vertex> m_vertices;		// converted, untransformed
+		std::vector<SDL_Vertex> m_drawVertices;	// transformed and colored, submitted to SDL
+		std::vector<int> m_indices;
+		Texture* m_texture = nullptr;
+
+		Vector2 m_position{ 0.0f, 0.0f };
+		Vector2 m_scale{ 1.0f, 1.0f };
+
+		// range of m_drawVertices that has to be rebuilt, begin >= end = clean
+		size_t m_dirtyBegin = 0;
+		size_t m_dirtyEnd = 0;
+
+		SDL_FColor m_drawColor{ 1.0f, 1.0f, 1.0f, 1.0f };
+		bool m_drawColorApplied = false;
+
+		FRect m_localBounds{ 0.0f, 0.0f, 0.0f, 0.0f };
+		bool m_boundsDirty = true;
+
+		void MarkDirty(size_t begin, size_t end);
+		void MarkAllDirty();
+		void UpdateDrawVertices(bool overrideColor);
+		void UpdateBounds();
+	};
+
+}
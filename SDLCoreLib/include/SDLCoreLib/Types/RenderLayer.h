@@ -0,0 +1,114 @@
+#pragma once
+#include <unordered_map>
+#include <SDL3/SDL.h>
+
+#include "Types/Types.h"
+
+namespace SDLCore::Render {
+
+	/**
+	* @brief Retained render layer backed by a render target texture per window.
+	*
+	* The content of a layer is only redrawn when it is marked dirty:
+	* @code
+	* if (layer.Begin()) {
+	*     // draw calls go into the layer
+	*     layer.End();
+	* }
+	* @endcode
+	* Layers with a negative z order are composited after Render::Clear, right before the first draw
+	* to the window (or at Render::Present), so they can still be recorded after the clear (backgrounds).
+	* Layers with a z order >= 0 are composited by Render::Present (overlays), each with one texture draw.
+	* The layer content is stored premultiplied and composited with SDL_BLENDMODE_BLEND_PREMULTIPLIED.
+	* Auto compositing can be disabled to draw a layer manually with Draw().
+	*
+	* The target textures have the size of the render output of the window and are
+	* recreated (and marked dirty) when the size changes or the renderer is destroyed.
+	* While recording, viewport, clip rect and render scale belong to the layer target.
+	*/
+	class Layer {
+	public:
+		/**
+		* @param zOrder Composite order, lower values are drawn first. Negative = background layer.
+		*/
+		Layer(int zOrder = 0);
+		~Layer();
+
+		Layer(const Layer&) = delete;
+		Layer& operator=(const Layer&) = delete;
+
+		/**
+		* @brief Starts recording into the layer of the active window if it is dirty.
+		*
+		* Clears the dirty area and restricts drawing to it with the clip rect.
+		* @return true if the layer has to be redrawn, End() must be called in this case.
+		*/
+		bool Begin();
+
+		/**
+		* @brief Stops recording and restores the previous render target.
+		*/
+		void End();
+
+		/**
+		* @brief Marks the whole layer of every window as dirty.
+		*/
+		void MarkDirty();
+
+		/**
+		* @brief Marks an area of the layer of every window as dirty.
+		* @param rect Area in layer pixels. Multiple areas are merged into their bounding rect.
+		*/
+		void MarkDirty(const SDLCore::Rect& rect);
+
+		/**
+		* @brief Returns true if the layer of the active window has to be redrawn.
+		*/
+		bool IsDirty() const;
+
+		/**
+		* @brief Draws the layer to the active window with one texture draw.
+		*/
+		void Draw();
+
+		Layer* SetZOrder(int zOrder);
+		Layer* SetVisible(bool value);
+		Layer* SetOpacity(Uint8 alpha);
+		Layer* SetAutoComposite(bool value);
+
+		int GetZOrder() const;
+		bool IsVisible() const;
+		Uint8 GetOpacity() const;
+		bool IsAutoComposite() const;
+
+	private:
+		struct Target {
+			SDL_Texture* texture = nullptr;
+			int width = 0;
+			int height = 0;
+			bool fullDirty = true;
+			bool partialDirty = false;
+			SDLCore::Rect dirtyRect{ 0, 0, 0, 0 };
+			WindowCallbackID rendererDestroyCallback{ SDLCORE_INVALID_ID };
+		};
+
+		std::unordered_map<WindowID, Target> m_targets;
+		int m_zOrder = 0;
+		bool m_visible = true;
+		Uint8 m_opacity = 255;
+		bool m_autoComposite = true;
+
+		// state of the recording
+		bool m_recording = false;
+		SDL_Texture* m_prevTarget = nullptr;
+
+		/*
+		* @brief Returns the target of the window and (re)creates its texture if needed
+		*/
+		Target* GetTarget(SDL_Renderer* renderer, WindowID winID);
+		void FreeTarget(WindowID winID);
+
+		friend void CompositeLayers(bool background);
+	};
+
+}
@@ -0,0 +1,138 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Types.h"
+#include "Internal/TextLayout.h"
+
+struct SDL_Texture;
+namespace SDLCore {
+
+	class TextBlock;
+	class FontAsset;
+
+	namespace Render {
+		void Text(TextBlock& block, float x, float y);
+	}
+
+	/*
+	* @brief Editable multi line text that is laid out and rendered incrementally.
+	*
+	* The block keeps its line breaks and line widths between draws. An edit only lays out
+	* the text from the line before the edit to the end of the edited paragraph, lines behind
+	* it are shifted. Only lines whose glyphs changed are rendered again into the cached texture,
+	* a changed number of lines redraws the lines below the edit.
+	*
+	* The block is drawn with Render::Text and uses the active font, text size, alignment,
+	* line height and clip width of the renderer. Max lines and the text limit are not applied.
+	* A change of these settings lays out and renders the whole block again
+	*/
+	class TextBlock {
+	friend void Render::Text(TextBlock& block, float x, float y);
+	public:
+		TextBlock() = default;
+		explicit TextBlock(const std::string& text);
+		~TextBlock();
+
+		TextBlock(const TextBlock& other);
+		TextBlock& operator=(const TextBlock& other);
+
+		TextBlock(TextBlock&& other) noexcept;
+		TextBlock& operator=(TextBlock&& other) noexcept;
+
+		/**
+		* @brief Replaces the whole text, the block is laid out again on the next draw
+		*/
+		void SetText(const std::string& text);
+
+		/**
+		* @brief Inserts UTF-8 text at a byte position (clamped to the text size)
+		*/
+		void Insert(size_t pos, std::string_view text);
+
+		/**
+		* @brief Appends UTF-8 text at the end
+		*/
+		void Append(std::string_view text);
+
+		/**
+		* @brief Erases count bytes at a byte position
+		*/
+		void Erase(size_t pos, size_t count);
+
+		void Clear();
+
+		/**
+		* @brief Enables the pre rendered texture (default true). Disabled blocks draw their glyphs every frame
+		*/
+		void SetTextureCache(bool value);
+
+		const std::string& GetText() const;
+		bool IsTextureCacheEnabled() const;
+
+		/**
+		* @brief Number of lines of the last layout
+		*/
+		size_t GetLineCount() const;
+
+		/**
+		* @brief Width of the widest line of the last layout in pixels
+		*/
+		float GetWidth() const;
+
+		/**
+		* @brief Number of lines that were laid out again by the last layout update, for profiling
+		*/
+		size_t GetLastRelayoutLineCount() const;
+
+	private:
+		static constexpr size_t NO_EDIT = static_cast<size_t>(-1);
+
+		struct Line {
+			size_t textStart = 0;
+			float width = 0.0f;
+			std::vector<TextLayoutGlyph> glyphs;// byte offsets are relative to textStart
+		};
+
+		std::string m_text;
+		std::vector<Line> m_lines;
+		float m_blockWidth = 0.0f;
+
+		bool m_layoutValid = false;
+		uint64_t m_layoutAssetID = 0;
+		TextLayoutParams m_layoutParams;
+		size_t m_editStart = NO_EDIT;// byte range changed since the last layout
+		size_t m_editEnd = 0;
+		size_t m_lastRelayoutLineCount = 0;
+		TextLayout m_scratch;
+
+		// lines that changed since the texture was rendered
+		size_t m_dirtyLineBegin = 0;
+		size_t m_dirtyLineEnd = 0;
+
+		bool m_textureCache = true;
+		SDL_Texture* m_texture = nullptr;
+		WindowID m_textureWinID{ SDLCORE_INVALID_ID };
+		WindowCallbackID m_textureCallbackID{ SDLCORE_INVALID_ID };
+		int m_textureWidth = 0;
+		int m_textureHeight = 0;
+		float m_textureBlockWidth = 0.0f;// layout of the rendered content
+		float m_textureLineHeight = 0.0f;
+		Align m_textureAlign = Align::START;
+		SDL_Color m_textureColor{ 255, 255, 255, 255 };
+
+		/*
+		* Lays out the edited part of the text or the whole text if the font or the parameters changed
+		*/
+		void UpdateLayout(FontAsset* asset, const TextLayoutParams& params);
+		void RelayoutAll(FontAsset* asset);
+		void RelayoutEdit(FontAsset* asset);
+		void MarkEdited(size_t start, size_t end);
+		void MarkLinesDirty(size_t begin, size_t end);
+
+		void SetTexture(SDL_Texture* texture, WindowID winID, int width, int height);
+		void FreeTexture();
+	};
+
+}
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <string>
+#include <string_view>
 #include <SDL3/SDL.h>
 
 #include <CoreLib/Math/Vector2.h>
@@ -13,6 +14,8 @@
 namespace SDLCore {
 	
     class Window;
+    class RenderBatch;
+    class AssetPack;
 
     inline constexpr bool TEXTURE_FALLBACK_TEXTURE = true;
 
@@ -75,6 +78,21 @@ namespace SDLCore {
         */
         Texture(const SystemFilePath& path, Type type = Type::STATIC);
 
+        /**
+        * @brief Loads an image from an entry of an asset pack, stored entries are decoded without a copy.
+        * @param pack Opened asset pack.
+        * @param path Name of the entry in the pack.
+        * @param type Texture type (default Type::STATIC).
+        */
+        Texture(const AssetPack& pack, std::string_view path, Type type = Type::STATIC);
+
+        /**
+        * @brief Creates a texture from an existing surface.
+        * @param surface Surface to use, shared through the ref counting of the TextureSurface.
+        * @param type Texture type (default Type::STATIC).
+        */
+        Texture(const TextureSurface& surface, Type type = Type::STATIC);
+
         /**
         * @brief Destructor. Frees all associated GPU textures and surface memory.
         */
@@ -166,6 +184,17 @@ namespace SDLCore {
         */
         bool Update(WindowID windowID, const void* pixels, int pitch, Rect* rect = nullptr);
 
+        /**
+        * @brief Uploads an area of the CPU surface to the GPU textures of all windows.
+        *
+        * Used after the pixels of the surface were modified directly.
+        * Windows without a GPU texture are skipped, their texture is created from the surface on first use.
+        *
+        * @param rect area of the surface to upload (nullptr = whole surface)
+        * @return true on success. Call SDLCore::GetError() for more information
+        */
+        bool UpdateFromSurface(const Rect* rect = nullptr);
+
         /**
         * @brief Set the rotation angle for this texture when rendered.
         * @param rotation Rotation angle in degrees.
@@ -341,7 +370,7 @@ namespace SDLCore {
     private:
         struct SDLTexture {
             SDL_Texture* tex = nullptr;
-            Uint8 lastR = 0, lastG = 0, lastB = 0, lastA = 0;
+            Uint8 lastR = 255, lastG = 255, lastB = 255, lastA = 255;// SDL default mods of a new texture
             SDL_ScaleMode scaleMode = SDL_ScaleMode::SDL_SCALEMODE_INVALID;
 
             SDLTexture() = default;
@@ -383,6 +412,17 @@ namespace SDLCore {
         */
         SDLTexture* GetTexture(WindowID id);
 
+        /*
+        * @brief returns true if the (rotated) destination rect lies outside the visible area
+        */
+        bool IsCulled(float x, float y, float w, float h) const;
+
+        /*
+        * @brief records the texture as a rotated and flipped quad into the batch of the active window
+        */
+        bool RenderBatched(RenderBatch* batch, SDL_Renderer* renderer, SDLTexture* texture,
+            float x, float y, float w, float h, const FRect* src);
+
         /**
         * @brief Internal helper for moving texture resources from another instance.
         * @param other Source texture whose internal data is transferred. After the call, @p other no longer owns any resources.
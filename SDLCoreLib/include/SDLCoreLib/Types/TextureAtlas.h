@@ -0,0 +1,194 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <SDL3/SDL.h>
+
+#include "Types/Texture.h"
+#include "Types/TextureSurface.h"
+#include "Types/Types.h"
+
+namespace SDLCore {
+
+	class TextureAtlas;
+
+	/**
+	* @brief Lightweight handle to an image packed into a TextureAtlas page.
+	*
+	* Copying is cheap. The handle stays valid when the atlas is repacked,
+	* the page and source rect are updated in place.
+	* Render settings (tint, rotation, flip, ...) belong to the page texture
+	* and are shared by all images on the same page.
+	*/
+	class SubTexture {
+	friend class TextureAtlas;
+	public:
+		SubTexture() = default;
+
+		/**
+		* @brief Returns true if the handle points to a packed image.
+		*/
+		bool IsValid() const;
+
+		/**
+		* @brief Returns the page texture the image is packed into.
+		* @return Pointer to the page texture, or nullptr if the handle is invalid.
+		*/
+		Texture* GetTexture() const;
+
+		/**
+		* @brief Returns the area of the image inside the page texture in pixels (without padding).
+		*/
+		FRect GetSourceRect() const;
+
+		/**
+		* @brief Returns the width of the image in pixels.
+		*/
+		int GetWidth() const;
+
+		/**
+		* @brief Returns the height of the image in pixels.
+		*/
+		int GetHeight() const;
+
+		/**
+		* @brief Renders the image to the active window.
+		* @param x X position of the top left corner.
+		* @param y Y position of the top left corner.
+		* @param w Width (0 = image width).
+		* @param h Height (0 = image height).
+		* @return true on success. Call SDLCore::GetError() for more information
+		*/
+		bool Render(float x, float y, float w = 0, float h = 0) const;
+
+	private:
+		struct Entry {
+			std::shared_ptr<Texture> page;
+			FRect rect{ 0, 0, 0, 0 };
+			TextureSurface source;// converted copy used for repacking
+			size_t pageIndex = 0;
+		};
+
+		std::shared_ptr<Entry> m_entry;
+
+		SubTexture(std::shared_ptr<Entry> entry);
+	};
+
+	/**
+	* @brief Packs many small images into a few large page textures.
+	*
+	* Uses a skyline bottom-left packer. New images are packed into the free
+	* space of the existing pages, only the changed area of a page is uploaded.
+	* Repack() rebuilds all pages sorted by height for a tighter packing.
+	* Each image is surrounded by padding, with bleed enabled the edge pixels are
+	* extruded into the padding to avoid sampling neighbours with linear filtering.
+	*/
+	class TextureAtlas {
+	public:
+		/**
+		* @param pageSize Width and height of a page in pixels.
+		* @param padding Space around each image in pixels.
+		* @param bleed If true the edge pixels of an image are repeated into its padding.
+		*/
+		TextureAtlas(int pageSize = 2048, int padding = 2, bool bleed = true);
+		~TextureAtlas() = default;
+
+		TextureAtlas(const TextureAtlas&) = delete;
+		TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+		/**
+		* @brief Packs an image file into the atlas.
+		* @param path Path of the image. Also used as the name of the image.
+		* @return Handle of the image, invalid on failure. Call SDLCore::GetError() for more information
+		*/
+		SubTexture Add(const SystemFilePath& path);
+
+		/**
+		* @brief Packs a surface into the atlas.
+		* @param name Unique name of the image. Adding an existing name returns the existing handle.
+		* @param surface Surface to copy the pixels from.
+		* @return Handle of the image, invalid on failure. Call SDLCore::GetError() for more information
+		*/
+		SubTexture Add(const std::string& name, const TextureSurface& surface);
+
+		/**
+		* @brief Returns the handle of an image by name.
+		* @return Handle of the image, invalid if no image with this name exists.
+		*/
+		SubTexture Get(const std::string& name) const;
+
+		/**
+		* @brief Returns true if an image with this name exists.
+		*/
+		bool Contains(const std::string& name) const;
+
+		/**
+		* @brief Rebuilds all pages with every image sorted by height.
+		*
+		* Existing handles stay valid. Useful after many incremental adds.
+		* @return true on success. Call SDLCore::GetError() for more information
+		*/
+		bool Repack();
+
+		/**
+		* @brief Removes all images and pages. Existing handles become invalid.
+		*/
+		void Clear();
+
+		/**
+		* @brief Returns the number of pages.
+		*/
+		size_t GetPageCount() const;
+
+		/**
+		* @brief Returns the page texture at the given index, nullptr if out of range.
+		*/
+		Texture* GetPage(size_t index) const;
+
+		/**
+		* @brief Returns the number of packed images.
+		*/
+		size_t GetImageCount() const;
+
+		/**
+		* @brief Returns the ratio of used to total page area (0-1).
+		*/
+		float GetOccupancy() const;
+
+	private:
+		struct SkylineNode {
+			int x = 0;
+			int y = 0;
+			int w = 0;
+		};
+
+		struct Page {
+			std::shared_ptr<Texture> texture;
+			SDL_Surface* surface = nullptr;// owned by the TextureSurface of the texture
+			std::vector<SkylineNode> skyline;
+			size_t usedArea = 0;
+		};
+
+		int m_pageSize = 2048;
+		int m_padding = 2;
+		bool m_bleed = true;
+		std::vector<Page> m_pages;
+		std::unordered_map<std::string, std::shared_ptr<SubTexture::Entry>> m_entries;
+
+		/*
+		* @brief Packs the entry into an existing page or a new one and copies its pixels
+		*/
+		bool Insert(SubTexture::Entry& entry, bool upload);
+
+		/*
+		* @brief Finds the best skyline position for a rect, returns false if it does not fit
+		*/
+		bool FindPosition(const Page& page, int w, int h, int& outX, int& outY, size_t& outNode) const;
+		void AddSkylineLevel(Page& page, size_t nodeIndex, int x, int y, int w, int h);
+
+		bool CreatePage();
+		void CopyPixels(Page& page, SDL_Surface* src, int x, int y);
+	};
+
+}
@@ -1,3 +1,4 @@
+#include <thread>
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <SDL3_mixer/SDL_mixer.h>
@@ -8,6 +9,8 @@
 #include "Types/Audio/SoundManager.h"
 #include "Internal/TextureManager.h"
 #include "Internal/FontManager.h"
+#include "Internal/FontAssetCache.h"
+#include "Internal/FontAtlasWorker.h"
 #include "Application.h"
 
 namespace SDLCore {
@@ -22,6 +25,9 @@ namespace SDLCore {
 
     static bool s_closeApplication = false;
     static bool s_sdlQuit = false;
+    static bool s_headless = false;
+    static int s_reservedThreadCount = 2;
+    static Uint32 s_wakeUpEventType = 0;// pushed to end the wait of the idle mode
 
     bool IsApplicationQuit() {
         return s_closeApplication;
@@ -82,7 +88,38 @@ namespace SDLCore {
         return platform;
     }
 
+    void Application::SetHeadless(bool value) {
+        if (s_application) {
+            Log::Warn("SDLCore::Application::SetHeadless: Has to be called before the application is created, value is ignored!");
+            return;
+        }
+        s_headless = value;
+    }
+
+    bool Application::IsHeadless() {
+        return s_headless;
+    }
+
+    void Application::SetReservedThreadCount(int count) {
+        if (s_application) {
+            Log::Warn("SDLCore::Application::SetReservedThreadCount: Has to be called before the application is created, value is ignored!");
+            return;
+        }
+        s_reservedThreadCount = std::max(count, 0);
+    }
+
+    int Application::GetReservedThreadCount() {
+        return s_reservedThreadCount;
+    }
+
     void Application::InitInternal() {
+        if (s_headless) {
+            // has to be set before SDL_Init, SDL tries the drivers in order
+            SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "offscreen,dummy");
+            SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+            m_renderDriver = "software";
+        }
+
         if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_EVENTS)) {
             SetError(Log::GetFormattedString("SDLCore::Application: {}", SDL_GetError()));
             cancelStart = 1;
@@ -108,12 +145,21 @@ namespace SDLCore {
             SetErrorF("SDLCore::Application(SDL_Net): {}", SDL_GetError());
             cancelStart = 5;
         }
+
+        s_wakeUpEventType = SDL_RegisterEvents(1);
+
+        int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+        m_jobSystem.Init(static_cast<size_t>(std::max(hardwareThreads - s_reservedThreadCount, 1)));
     }
 
     void Application::QuitInternal() {
         if (s_sdlQuit)
             return;
 
+        AssetLoader::GetInstance().Shutdown();
+        m_jobSystem.Shutdown();
+        FontAtlasWorker::GetInstance().Shutdown();
+        FontAssetCache::GetInstance().Clear();
         TextureManager::GetInstance().ClearAllTexturesEntries();
         FontManager::GetInstance().ClearAllFontEntries();
   
@@ -136,22 +182,29 @@ namespace SDLCore {
             return cancelStart;
         }
 
-        uint64_t frameStart = 0;
         OnStart();
+        m_framePacer.Restart();
         while(!s_closeApplication) {
-            frameStart = Time::GetTimeMS();
+            WaitWhileIdle();
             Time::Update();
 
             ProcessSDLPollEvents();
             if (s_closeApplication)
                 break;
 
+            AssetLoader::GetInstance().Update();
+
+            RunFixedUpdates();
+            if (s_closeApplication)
+                break;
+
             OnUpdate();
+            WaitForFrameJobs();
             Input::LateUpdate();
             SoundManager::Flush();
 
             LockCursor();
-            FPSCapDelay(frameStart);
+            PaceFrame();
 
             ProcessWindowClosureRequests();
         }
@@ -168,6 +221,27 @@ namespace SDLCore {
 
     void Application::Quit() {
         s_closeApplication = true;
+        WakeUp();
+    }
+
+    void Application::SetIdleMode(bool value) {
+        m_idleMode = value;
+        m_redrawRequested = true;
+    }
+
+    bool Application::IsIdleMode() const {
+        return m_idleMode;
+    }
+
+    void Application::RequestRedraw() {
+        m_redrawRequested = true;
+        WakeUp();
+    }
+
+    void Application::ScheduleWakeup(double seconds) {
+        uint64_t wakeup = SDL_GetTicksNS() + static_cast<uint64_t>(std::max(seconds, 0.0) * SDL_NS_PER_SECOND);
+        if (m_nextWakeupNS == 0 || wakeup < m_nextWakeupNS)
+            m_nextWakeupNS = wakeup;
     }
 
     Window* Application::AddWindow(WindowID* idPtr, std::string name, int width, int height) {
@@ -380,6 +454,56 @@ namespace SDLCore {
         }
 
         m_fpsCap = value;
+        m_framePacer.SetTargetFrameRate((m_vsync == 0) ? m_fpsCap : 0);
+        m_framePacer.ResetStats();
+    }
+
+    const FramePacingStats& Application::GetFramePacingStats() const {
+        return m_framePacer.GetStats();
+    }
+
+    void Application::ResetFramePacingStats() {
+        m_framePacer.ResetStats();
+    }
+
+    void Application::SetFixedTickRate(double hz) {
+        if (hz < 0.0) {
+            Log::Warn("SDLCore::Application::SetFixedTickRate: Tick rate '{}' is negative, fixed update is disabled", hz);
+            hz = 0.0;
+        }
+        Time::SetFixedTickRate(hz);
+    }
+
+    double Application::GetFixedTickRate() const {
+        return Time::GetFixedTickRateHzD();
+    }
+
+    void Application::SetMaxFixedStepsPerFrame(int steps) {
+        m_maxFixedStepsPerFrame = std::max(steps, 1);
+    }
+
+    int Application::GetMaxFixedStepsPerFrame() const {
+        return m_maxFixedStepsPerFrame;
+    }
+
+    void Application::SetRunAsFastAsPossible(bool value) {
+        m_runAsFastAsPossible = value;
+    }
+
+    bool Application::IsRunAsFastAsPossible() const {
+        return m_runAsFastAsPossible;
+    }
+
+    JobSystem& Application::GetJobSystem() {
+        return m_jobSystem;
+    }
+
+    void Application::ScheduleFrameJob(JobSystem::JobFunc job) {
+        m_jobSystem.Schedule(std::move(job), &m_frameJobs);
+    }
+
+    void Application::WaitForFrameJobs() {
+        m_jobSystem.Wait(m_frameJobs);
     }
 
     bool Application::SetCursorLock(WindowID winID, bool active, bool center) {
@@ -501,9 +625,13 @@ namespace SDLCore {
 
     void Application::ProcessSDLPollEvents() {
         while (SDL_PollEvent(&m_sdlEvent)) {
-            for (auto& window : m_windows) {
-                ProcessSDLPollEventWindow(window);
-            }
+            ProcessSDLEvent();
+        }
+    }
+
+    void Application::ProcessSDLEvent() {
+        for (auto& window : m_windows) {
+            ProcessSDLPollEventWindow(window);
         }
     }
 
@@ -548,6 +676,57 @@ namespace SDLCore {
         Input::ProcessEvent(m_sdlEvent);
     }
 
+    void Application::WaitWhileIdle() {
+        if (!m_idleMode)
+            return;
+
+        // loads that are not done yet have to be uploaded, the loop keeps running
+        bool hasWork = m_redrawRequested || !m_windowsToClose.empty() || AssetLoader::GetPendingCount() > 0;
+        if (!hasWork) {
+            const uint64_t waitStart = SDL_GetTicksNS();
+
+            // RequestRedraw sets the flag before it checks m_idleWaiting, either the loop below
+            // sees the flag or a wake up event is pushed
+            m_idleWaiting = true;
+            while (!m_redrawRequested && !s_closeApplication) {
+                Sint32 timeoutMS = -1;
+                if (m_nextWakeupNS != 0) {
+                    uint64_t now = SDL_GetTicksNS();
+                    if (now >= m_nextWakeupNS)
+                        break;
+                    uint64_t remainingMS = (m_nextWakeupNS - now + SDL_NS_PER_MS - 1) / SDL_NS_PER_MS;
+                    timeoutMS = static_cast<Sint32>(std::min<uint64_t>(remainingMS, SDL_MAX_SINT32));
+                }
+
+                // every event runs a frame, the remaining events are polled in the frame
+                if (SDL_WaitEventTimeout(&m_sdlEvent, timeoutMS)) {
+                    ProcessSDLEvent();
+                    break;
+                }
+            }
+            m_idleWaiting = false;
+
+            const uint64_t waited = SDL_GetTicksNS() - waitStart;
+            Time::SkipTime(waited);
+            m_framePacer.Restart();
+        }
+
+        if (m_nextWakeupNS != 0 && SDL_GetTicksNS() >= m_nextWakeupNS)
+            m_nextWakeupNS = 0;
+        m_redrawRequested = false;
+    }
+
+    void Application::WakeUp() {
+        if (!m_idleWaiting || s_wakeUpEventType == 0)
+            return;
+
+        SDL_Event event;
+        SDL_zero(event);
+        event.type = s_wakeUpEventType;
+        event.user.timestamp = SDL_GetTicksNS();
+        SDL_PushEvent(&event);
+    }
+
     void Application::ProcessWindowClosureRequests() {
         if (m_windowsToClose.empty())
             return;
@@ -560,15 +739,20 @@ namespace SDLCore {
         m_windowsToClose.clear();
     }
 
-    void Application::FPSCapDelay(uint64_t frameStartTime) const {
-        if (m_fpsCap <= 0 || m_vsync != 0)
+    void Application::PaceFrame() {
+        if (m_runAsFastAsPossible) {
+            // the deadline would be far behind once pacing is enabled again
+            m_framePacer.Restart();
             return;
+        }
+        m_framePacer.Wait();
+    }
 
-        uint64_t targetFrameTime = 1000 / m_fpsCap;
-        uint64_t frameTime = SDL_GetTicks() - frameStartTime;
-
-        if (frameTime < targetFrameTime) {
-            SDL_Delay(static_cast<Uint32>(targetFrameTime - frameTime));
+    void Application::RunFixedUpdates() {
+        uint32_t steps = Time::ConsumeFixedSteps(static_cast<uint32_t>(m_maxFixedStepsPerFrame), m_runAsFastAsPossible);
+        for (uint32_t i = 0; i < steps && !s_closeApplication; i++) {
+            Time::AdvanceFixedTick();
+            OnFixedUpdate();
         }
     }
 
@@ -0,0 +1,447 @@
+#include <algorithm>
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+#include <SDL3_mixer/SDL_mixer.h>
+#include <CoreLib/Log.h>
+#include <CoreLib/File.h>
+
+#include "Application.h"
+#include "SDLCoreError.h"
+#include "Types/AssetPack.h"
+#include "AssetLoader.h"
+
+namespace SDLCore {
+
+    namespace {
+        // decoded audio of a sound clip until it is registered on the main thread
+        struct DecodedAudio {
+            MIX_Audio* audio = nullptr;
+
+            ~DecodedAudio() {
+                if (audio && !IsSDLQuit())
+                    MIX_DestroyAudio(audio);
+            }
+        };
+
+        // font assets of the requested sizes until they are added to the shared cache on the main thread
+        struct DecodedFontAssets {
+            std::vector<std::pair<float, std::shared_ptr<FontAsset>>> assets;
+        };
+
+        bool CheckFileExists(const SystemFilePath& path, std::string& outError) {
+            File file{ path };
+            if (file.Exists())
+                return true;
+
+            outError = FormatUtils::formatString("File '{}' does not exist", path);
+            return false;
+        }
+    }
+
+    AssetRequestBase::AssetRequestBase(const SystemFilePath& path, int priority)
+        : m_path(path), m_priority(priority) {
+    }
+
+    AssetState AssetRequestBase::GetState() const {
+        return m_state.load(std::memory_order_acquire);
+    }
+
+    int AssetRequestBase::GetPriority() const {
+        return m_priority;
+    }
+
+    const SystemFilePath& AssetRequestBase::GetPath() const {
+        return m_path;
+    }
+
+    const std::string& AssetRequestBase::GetError() const {
+        return m_error;
+    }
+
+    AssetLoader::~AssetLoader() {
+        Shutdown();
+    }
+
+    AssetLoader& AssetLoader::GetInstance() {
+        static AssetLoader instance;
+        return instance;
+    }
+
+    AssetHandle<Texture> AssetLoader::LoadTexture(const SystemFilePath& path, int priority, Texture::Type type) {
+        auto openIO = [path](std::string& outError) -> SDL_IOStream* {
+            if (!CheckFileExists(path, outError))
+                return nullptr;
+
+            SDL_IOStream* io = SDL_IOFromFile(path.string().c_str(), "rb");
+            if (!io)
+                outError = FormatUtils::formatString("Failed to open file: {}", SDL_GetError());
+            return io;
+        };
+        return LoadTexture(path, std::move(openIO), priority, type);
+    }
+
+    AssetHandle<SoundClip> AssetLoader::LoadSound(const SystemFilePath& path, int priority, SoundType type) {
+        auto decodeAudio = [path, type](SoundClip& clip, std::string& outError) {
+            return clip.DecodeAudio(path, type, outError);
+        };
+        return LoadSound(path, std::move(decodeAudio), priority);
+    }
+
+    AssetHandle<Font> AssetLoader::LoadFont(const SystemFilePath& path, std::vector<float> sizes, int priority) {
+        auto createFont = [path](std::string& outError) -> std::unique_ptr<Font> {
+            if (!CheckFileExists(path, outError))
+                return nullptr;
+            return std::make_unique<Font>(path);
+        };
+        return LoadFont(path, std::move(createFont), std::move(sizes), priority);
+    }
+
+    AssetHandle<Texture> AssetLoader::LoadTexture(const AssetPack& pack, std::string_view path, int priority, Texture::Type type) {
+        auto openIO = [&pack, entry = std::string(path)](std::string& outError) {
+            return pack.OpenIO(entry, outError);
+        };
+        return LoadTexture(SystemFilePath(std::string(path)), std::move(openIO), priority, type);
+    }
+
+    AssetHandle<SoundClip> AssetLoader::LoadSound(const AssetPack& pack, std::string_view path, int priority, SoundType type) {
+        auto decodeAudio = [&pack, entry = std::string(path), type](SoundClip& clip, std::string& outError) {
+            return clip.DecodeAudio(pack, entry, type, outError);
+        };
+        return LoadSound(SystemFilePath(std::string(path)), std::move(decodeAudio), priority);
+    }
+
+    AssetHandle<Font> AssetLoader::LoadFont(AssetPack& pack, std::string_view path, std::vector<float> sizes, int priority) {
+        auto createFont = [&pack, entry = std::string(path)](std::string& outError) -> std::unique_ptr<Font> {
+            if (!pack.Contains(entry)) {
+                outError = FormatUtils::formatString("Entry '{}' does not exist in '{}'", entry, pack.GetPath());
+                return nullptr;
+            }
+            return std::make_unique<Font>(pack, entry);
+        };
+        return LoadFont(SystemFilePath(std::string(path)), std::move(createFont), std::move(sizes), priority);
+    }
+
+    AssetHandle<Texture> AssetLoader::LoadTexture(const SystemFilePath& name, OpenIOFunc openIO, int priority, Texture::Type type) {
+        auto decode = [openIO = std::move(openIO), type](const SystemFilePath&, std::string& outError) -> std::unique_ptr<Texture> {
+            SDL_IOStream* io = openIO(outError);
+            if (!io)
+                return nullptr;
+
+            SDL_Surface* surface = IMG_Load_IO(io, true);
+            if (!surface) {
+                outError = FormatUtils::formatString("Failed to load image: {}", SDL_GetError());
+                return nullptr;
+            }
+            return std::make_unique<Texture>(TextureSurface(surface), type);
+        };
+
+        // creates the textures now instead of on the first draw
+        auto finish = [](Texture& texture, std::string& outError) {
+            auto* app = Application::GetInstance();
+            if (!app)
+                return true;
+
+            for (const auto& win : app->m_windows) {
+                if (!win->HasRenderer())
+                    continue;
+
+                if (!texture.CreateForWindow(win->GetID())) {
+                    outError = SDLCore::GetError();
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        auto request = std::make_shared<AssetRequest<Texture>>(name, priority, std::move(decode), std::move(finish));
+        GetInstance().Schedule(request);
+        return AssetHandle<Texture>(std::move(request));
+    }
+
+    AssetHandle<SoundClip> AssetLoader::LoadSound(const SystemFilePath& name, DecodeAudioFunc decodeAudio, int priority) {
+        auto decoded = std::make_shared<DecodedAudio>();
+
+        auto decode = [decodeAudio = std::move(decodeAudio), decoded](const SystemFilePath& path, std::string& outError) -> std::unique_ptr<SoundClip> {
+            auto clip = std::make_unique<SoundClip>();
+            clip->m_path = path;
+            decoded->audio = decodeAudio(*clip, outError);
+            if (!decoded->audio)
+                return nullptr;
+            return clip;
+        };
+
+        // the SoundManager is not thread safe, the audio is registered on the main thread
+        auto finish = [decoded](SoundClip& clip, std::string& outError) {
+            MIX_Audio* audio = decoded->audio;
+            decoded->audio = nullptr;
+            if (!clip.RegisterAudio(audio)) {
+                outError = SDLCore::GetError();
+                return false;
+            }
+            return true;
+        };
+
+        auto request = std::make_shared<AssetRequest<SoundClip>>(name, priority, std::move(decode), std::move(finish));
+        GetInstance().Schedule(request);
+        return AssetHandle<SoundClip>(std::move(request));
+    }
+
+    AssetHandle<Font> AssetLoader::LoadFont(const SystemFilePath& name, CreateFontFunc createFont, std::vector<float> sizes, int priority) {
+        auto decoded = std::make_shared<DecodedFontAssets>();
+
+        /*
+        * The atlases are generated on the loader thread. The shared FontAssetCache is only read here,
+        * the assets are added on the main thread because adding trims the cache and destroys assets
+        */
+        auto decode = [createFont = std::move(createFont), sizes, decoded](const SystemFilePath&, std::string& outError) -> std::unique_ptr<Font> {
+            auto font = createFont(outError);
+            if (!font)
+                return nullptr;
+
+            for (float size : sizes) {
+                std::shared_ptr<FontAsset> asset;
+                if (!font->DecodeFontAsset(size, asset, outError))
+                    return nullptr;
+                decoded->assets.emplace_back(size, std::move(asset));
+            }
+            return font;
+        };
+
+        auto finish = [sizes, decoded](Font& font, std::string& outError) {
+            for (auto& [size, asset] : decoded->assets)
+                font.AddDecodedFontAsset(size, std::move(asset));
+            decoded->assets.clear();
+
+            if (!sizes.empty() && font.GetNumberOfCachedFontAssets() == 0) {
+                outError = "Could not create a font asset";
+                return false;
+            }
+            font.CalculateCachedFonts();
+
+            auto* app = Application::GetInstance();
+            if (!app)
+                return true;
+
+            for (float size : sizes) {
+                FontAsset* asset = font.GetFontAsset(size);
+                if (!asset || !asset->IsReady())
+                    continue;
+
+                for (const auto& win : app->m_windows) {
+                    if (!win->HasRenderer())
+                        continue;
+
+                    for (int page = 0; page < asset->GetGlyphAtlasPageCount(); page++)
+                        asset->GetGlyphAtlasTexture(win->GetID(), page);
+                }
+            }
+            return true;
+        };
+
+        auto request = std::make_shared<AssetRequest<Font>>(name, priority, std::move(decode), std::move(finish));
+        GetInstance().Schedule(request);
+        return AssetHandle<Font>(std::move(request));
+    }
+
+    void AssetLoader::SetUploadBudget(float ms) {
+        if (ms < 0.0f) {
+            Log::Warn("SDLCore::AssetLoader::SetUploadBudget: Budget '{}' is negative, set to 0!", ms);
+            ms = 0.0f;
+        }
+        GetInstance().m_uploadBudgetNS = static_cast<uint64_t>(ms * 1000000.0f);
+    }
+
+    float AssetLoader::GetUploadBudget() {
+        return static_cast<float>(GetInstance().m_uploadBudgetNS) / 1000000.0f;
+    }
+
+    size_t AssetLoader::GetPendingCount() {
+        return GetInstance().m_requests.size();
+    }
+
+    void AssetLoader::CancelAll() {
+        AssetLoader& loader = GetInstance();
+        while (!loader.m_requests.empty()) {
+            std::shared_ptr<AssetRequestBase> request = loader.m_requests.back();
+            loader.Cancel(*request);
+        }
+    }
+
+    Texture* AssetLoader::GetFallbackTexture() {
+        AssetLoader& loader = GetInstance();
+        if (!loader.m_fallbackTexture)
+            loader.m_fallbackTexture = std::make_unique<Texture>(TEXTURE_FALLBACK_TEXTURE);
+        return loader.m_fallbackTexture.get();
+    }
+
+    Font* AssetLoader::GetFallbackFont() {
+        AssetLoader& loader = GetInstance();
+        if (!loader.m_fallbackFont)
+            loader.m_fallbackFont = std::make_unique<Font>(true);
+        return loader.m_fallbackFont.get();
+    }
+
+    SoundClip* AssetLoader::GetFallbackSound() {
+        AssetLoader& loader = GetInstance();
+        if (!loader.m_fallbackSound)
+            loader.m_fallbackSound = std::make_unique<SoundClip>();
+        return loader.m_fallbackSound.get();
+    }
+
+    void AssetLoader::Schedule(std::shared_ptr<AssetRequestBase> request) {
+        std::lock_guard lock(m_mutex);
+        if (m_shutdown) {
+            request->m_error = "AssetLoader is shut down";
+            request->m_state.store(AssetState::FAILED, std::memory_order_release);
+            return;
+        }
+
+        if (m_workers.empty()) {
+            size_t count = std::thread::hardware_concurrency();
+            count = std::clamp<size_t>((count > 1) ? count - 1 : 1, 1, MAX_WORKER_COUNT);
+            for (size_t i = 0; i < count; i++)
+                m_workers.emplace_back(&AssetLoader::Run, this);
+        }
+
+        request->m_sequence = m_nextSequence++;
+        m_requests.push_back(request);
+        m_queue.push_back(std::move(request));
+        std::push_heap(m_queue.begin(), m_queue.end(), ComparePriority);
+        m_condition.notify_one();
+    }
+
+    void AssetLoader::SetPriority(AssetRequestBase& request, int priority) {
+        std::lock_guard lock(m_mutex);
+        if (request.m_priority == priority)
+            return;
+
+        request.m_priority = priority;
+        std::make_heap(m_queue.begin(), m_queue.end(), ComparePriority);
+    }
+
+    void AssetLoader::Cancel(AssetRequestBase& request) {
+        if (request.GetState() != AssetState::PENDING)
+            return;
+
+        // queued requests are skipped by the loader threads, decoded ones are released in Update
+        request.m_canceled.store(true, std::memory_order_release);
+        request.m_state.store(AssetState::CANCELED, std::memory_order_release);
+        RemoveRequest(request);
+    }
+
+    void AssetLoader::Update() {
+        // canceled requests are still handed over once their decode is done and are released here
+        {
+            std::lock_guard lock(m_mutex);
+            m_uploads.insert(m_uploads.end(),
+                std::make_move_iterator(m_decoded.begin()), std::make_move_iterator(m_decoded.end()));
+            m_decoded.clear();
+        }
+
+        if (m_uploads.empty())
+            return;
+
+        std::sort(m_uploads.begin(), m_uploads.end(),
+            [](const auto& a, const auto& b) { return ComparePriority(b, a); });
+
+        const uint64_t start = SDL_GetTicksNS();
+        size_t finished = 0;
+        while (finished < m_uploads.size()) {
+            FinishRequest(*m_uploads[finished++]);
+            if (SDL_GetTicksNS() - start >= m_uploadBudgetNS)
+                break;
+        }
+        m_uploads.erase(m_uploads.begin(), m_uploads.begin() + finished);
+    }
+
+    void AssetLoader::Shutdown() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_shutdown = true;
+            m_queue.clear();
+        }
+        m_condition.notify_all();
+
+        for (auto& worker : m_workers) {
+            if (worker.joinable())
+                worker.join();
+        }
+        m_workers.clear();
+
+        // decoded assets are released while SDL is still running
+        m_uploads.insert(m_uploads.end(), m_decoded.begin(), m_decoded.end());
+        m_decoded.clear();
+        for (auto& request : m_uploads)
+            request->Release();
+        m_uploads.clear();
+
+        for (auto& request : m_requests) {
+            request->m_canceled.store(true, std::memory_order_release);
+            request->m_state.store(AssetState::CANCELED, std::memory_order_release);
+        }
+        m_requests.clear();
+
+        m_fallbackTexture.reset();
+        m_fallbackFont.reset();
+        m_fallbackSound.reset();
+    }
+
+    void AssetLoader::Run() {
+        while (true) {
+            std::shared_ptr<AssetRequestBase> request;
+            {
+                std::unique_lock lock(m_mutex);
+                m_condition.wait(lock, [this]() { return m_shutdown || !m_queue.empty(); });
+                if (m_shutdown)
+                    return;
+
+                std::pop_heap(m_queue.begin(), m_queue.end(), ComparePriority);
+                request = std::move(m_queue.back());
+                m_queue.pop_back();
+            }
+
+            if (request->m_canceled.load(std::memory_order_acquire))
+                continue;
+
+            request->m_decodeSucceeded = request->Decode();
+
+            std::lock_guard lock(m_mutex);
+            m_decoded.push_back(std::move(request));
+        }
+    }
+
+    void AssetLoader::FinishRequest(AssetRequestBase& request) {
+        if (request.m_canceled.load(std::memory_order_acquire)) {
+            request.Release();
+            return;
+        }
+
+        if (!request.m_decodeSucceeded || !request.Finish()) {
+            Log::Warn("SDLCore::AssetLoader: Failed to load '{}': {}", request.m_path, request.m_error);
+            request.Release();
+            request.m_state.store(AssetState::FAILED, std::memory_order_release);
+        }
+        else {
+            request.m_state.store(AssetState::READY, std::memory_order_release);
+        }
+        RemoveRequest(request);
+    }
+
+    void AssetLoader::RemoveRequest(const AssetRequestBase& request) {
+        auto it = std::find_if(m_requests.begin(), m_requests.end(),
+            [&request](const auto& r) { return r.get() == &request; });
+        if (it == m_requests.end())
+            return;
+
+        *it = std::move(m_requests.back());
+        m_requests.pop_back();
+    }
+
+    bool AssetLoader::ComparePriority(const std::shared_ptr<AssetRequestBase>& a, const std::shared_ptr<AssetRequestBase>& b) {
+        if (a->m_priority != b->m_priority)
+            return a->m_priority < b->m_priority;
+        // earlier loads first
+        return a->m_sequence > b->m_sequence;
+    }
+
+}
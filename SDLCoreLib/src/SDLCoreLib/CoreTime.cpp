@@ -1,3 +1,6 @@
+#include <array>
+#include <cmath>
+#include <algorithm>
 #include <CoreLib/Log.h>
 #include <SDL3/SDL.h>
 #include "SDLCoreTime.h"
@@ -7,9 +10,29 @@ namespace SDLCore {
     static uint64_t s_frameCount = 0;
     static uint64_t s_lastTimeNS = 0;
     static uint64_t s_currentTimeNS = 0;
+    static uint64_t s_deltaTimeNS = 0;
     static double s_deltaTimeSec = 0.0;
     static double s_frameRateHz = 0.0;
 
+    static uint64_t s_fixedStepNS = SDL_NS_PER_SECOND / 60;// 0 = fixed update disabled
+    static uint64_t s_fixedAccumulatorNS = 0;
+    static uint64_t s_fixedTickCount = 0;
+    static uint64_t s_droppedFixedTickCount = 0;
+    static double s_interpolationAlpha = 0.0;
+
+    // ring buffer of the last frame times in ms
+    static std::array<float, Time::FRAME_HISTORY_SIZE> s_frameHistory{};
+    static std::array<float, Time::FRAME_HISTORY_SIZE> s_frameHistoryScratch{};// for the percentile selection
+    static size_t s_frameHistoryNext = 0;
+    static size_t s_frameHistoryCount = 0;
+    static double s_frameHistorySumMS = 0.0;
+    static size_t s_frameHistoryHitches = 0;
+    static float s_hitchThresholdMS = 50.0f;
+    static uint64_t s_totalHitchCount = 0;
+
+    static FrameTimeStats s_frameTimeStats;
+    static uint64_t s_frameTimeStatsFrame = UINT64_MAX;// frame of s_frameTimeStats
+
     uint64_t Time::GetFrameCount() {
         return s_frameCount;
     }
@@ -54,20 +77,240 @@ namespace SDLCore {
         return s_frameRateHz;
     }
 
+    uint64_t Time::GetFixedTickCount() {
+        return s_fixedTickCount;
+    }
+
+    uint64_t Time::GetDroppedFixedTickCount() {
+        return s_droppedFixedTickCount;
+    }
+
+    double Time::GetFixedTimeSecD() {
+        return static_cast<double>(s_fixedTickCount) * GetFixedDeltaTimeSecD();
+    }
+
+    float Time::GetFixedDeltaTimeMSF() {
+        return static_cast<float>(GetFixedDeltaTimeSecD() * SDL_MS_PER_SECOND);
+    }
+
+    float Time::GetFixedDeltaTimeSecF() {
+        return static_cast<float>(GetFixedDeltaTimeSecD());
+    }
+
+    double Time::GetFixedDeltaTimeSecD() {
+        return static_cast<double>(s_fixedStepNS) / SDL_NS_PER_SECOND;
+    }
+
+    double Time::GetFixedTickRateHzD() {
+        return (s_fixedStepNS > 0) ? static_cast<double>(SDL_NS_PER_SECOND) / s_fixedStepNS : 0.0;
+    }
+
+    float Time::GetInterpolationAlphaF() {
+        return static_cast<float>(s_interpolationAlpha);
+    }
+
+    double Time::GetInterpolationAlphaD() {
+        return s_interpolationAlpha;
+    }
+
+    size_t Time::GetFrameHistoryCount() {
+        return s_frameHistoryCount;
+    }
+
+    size_t Time::GetFrameHistory(float* out, size_t maxCount) {
+        if (!out)
+            return 0;
+
+        size_t count = std::min(maxCount, s_frameHistoryCount);
+        size_t start = (s_frameHistoryNext + FRAME_HISTORY_SIZE - count) % FRAME_HISTORY_SIZE;
+        for (size_t i = 0; i < count; i++)
+            out[i] = s_frameHistory[(start + i) % FRAME_HISTORY_SIZE];
+        return count;
+    }
+
+    float Time::GetAverageFrameTimeMSF() {
+        if (s_frameHistoryCount == 0)
+            return 0.0f;
+        return static_cast<float>(s_frameHistorySumMS / s_frameHistoryCount);
+    }
+
+    float Time::GetAverageFrameRateHzF() {
+        float averageMS = GetAverageFrameTimeMSF();
+        return (averageMS > 0.0f) ? SDL_MS_PER_SECOND / averageMS : 0.0f;
+    }
+
+    // index of a percentile (0 - 100) in count sorted values
+    static size_t GetPercentileRank(size_t count, float percentile) {
+        size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0f * count));
+        return std::clamp<size_t>(rank, 1, count) - 1;
+    }
+
+    /*
+    * selects the value of a rank in the first count values of the scratch buffer. After nth_element
+    * all values left of the rank are smaller, a higher rank only has to search from the previous rank
+    */
+    static float SelectRank(size_t first, size_t rank, size_t count) {
+        auto begin = s_frameHistoryScratch.begin();
+        std::nth_element(begin + first, begin + rank, begin + count);
+        return s_frameHistoryScratch[rank];
+    }
+
+    float Time::GetFrameTimePercentileMSF(float percentile) {
+        if (s_frameHistoryCount == 0)
+            return 0.0f;
+
+        std::copy_n(s_frameHistory.begin(), s_frameHistoryCount, s_frameHistoryScratch.begin());
+        return SelectRank(0, GetPercentileRank(s_frameHistoryCount, std::clamp(percentile, 0.0f, 100.0f)), s_frameHistoryCount);
+    }
+
+    const FrameTimeStats& Time::GetFrameTimeStats() {
+        if (s_frameTimeStatsFrame == s_frameCount)
+            return s_frameTimeStats;
+        s_frameTimeStatsFrame = s_frameCount;
+
+        FrameTimeStats stats;
+        const size_t count = s_frameHistoryCount;
+        stats.sampleCount = count;
+        stats.hitchCount = s_frameHistoryHitches;
+        if (count > 0) {
+            auto [minIt, maxIt] = std::minmax_element(s_frameHistory.begin(), s_frameHistory.begin() + count);
+            stats.averageMS = GetAverageFrameTimeMSF();
+            stats.minMS = *minIt;
+            stats.maxMS = *maxIt;
+
+            std::copy_n(s_frameHistory.begin(), count, s_frameHistoryScratch.begin());
+            const size_t p50 = GetPercentileRank(count, 50.0f);
+            const size_t p95 = GetPercentileRank(count, 95.0f);
+            const size_t p99 = GetPercentileRank(count, 99.0f);
+            stats.p50MS = SelectRank(0, p50, count);
+            stats.p95MS = SelectRank(p50, p95, count);
+            stats.p99MS = SelectRank(p95, p99, count);
+        }
+
+        s_frameTimeStats = stats;
+        return s_frameTimeStats;
+    }
+
+    void Time::SetHitchThresholdMS(float ms) {
+        s_hitchThresholdMS = std::max(ms, 0.0f);
+
+        s_frameHistoryHitches = 0;
+        for (size_t i = 0; i < s_frameHistoryCount; i++) {
+            if (s_frameHistory[i] > s_hitchThresholdMS)
+                s_frameHistoryHitches++;
+        }
+        s_frameTimeStatsFrame = UINT64_MAX;
+    }
+
+    float Time::GetHitchThresholdMS() {
+        return s_hitchThresholdMS;
+    }
+
+    uint64_t Time::GetTotalHitchCount() {
+        return s_totalHitchCount;
+    }
+
+    void Time::ResetFrameTimeStats() {
+        s_frameHistoryNext = 0;
+        s_frameHistoryCount = 0;
+        s_frameHistorySumMS = 0.0;
+        s_frameHistoryHitches = 0;
+        s_totalHitchCount = 0;
+        s_frameTimeStatsFrame = UINT64_MAX;
+    }
+
+    void Time::RecordFrameTime(float ms) {
+        // the oldest frame is replaced once the buffer is full
+        if (s_frameHistoryCount == FRAME_HISTORY_SIZE) {
+            float oldest = s_frameHistory[s_frameHistoryNext];
+            s_frameHistorySumMS -= oldest;
+            if (oldest > s_hitchThresholdMS)
+                s_frameHistoryHitches--;
+        }
+        else {
+            s_frameHistoryCount++;
+        }
+
+        s_frameHistory[s_frameHistoryNext] = ms;
+        s_frameHistorySumMS += ms;
+        if (ms > s_hitchThresholdMS) {
+            s_frameHistoryHitches++;
+            s_totalHitchCount++;
+        }
+
+        s_frameHistoryNext = (s_frameHistoryNext + 1) % FRAME_HISTORY_SIZE;
+
+        // the running sum is rebuilt once per cycle so float rounding does not add up
+        if (s_frameHistoryNext == 0) {
+            s_frameHistorySumMS = 0.0;
+            for (size_t i = 0; i < s_frameHistoryCount; i++)
+                s_frameHistorySumMS += s_frameHistory[i];
+        }
+    }
+
     void Time::Update() {
         s_currentTimeNS = GetTimeNS();
 
         if (s_lastTimeNS == 0) {
             s_lastTimeNS = s_currentTimeNS;
+            s_deltaTimeNS = 0;
             s_deltaTimeSec = 0.0;
             s_frameRateHz = 0.0;
             return;
         }
 
         s_frameCount++;
-        s_deltaTimeSec = static_cast<double>(s_currentTimeNS - s_lastTimeNS) / SDL_NS_PER_SECOND; // ns -> s
+        s_deltaTimeNS = s_currentTimeNS - s_lastTimeNS;
+        s_deltaTimeSec = static_cast<double>(s_deltaTimeNS) / SDL_NS_PER_SECOND; // ns -> s
         s_frameRateHz = (s_deltaTimeSec > 0.0) ? 1.0 / s_deltaTimeSec : 0.0;
         s_lastTimeNS = s_currentTimeNS;
+
+        RecordFrameTime(static_cast<float>(s_deltaTimeSec * SDL_MS_PER_SECOND));
+    }
+
+    void Time::SkipTime(uint64_t ns) {
+        if (s_lastTimeNS != 0)
+            s_lastTimeNS += ns;
+    }
+
+    void Time::SetFixedTickRate(double hz) {
+        s_fixedStepNS = (hz > 0.0) ? static_cast<uint64_t>(SDL_NS_PER_SECOND / hz) : 0;
+        if (hz > 0.0 && s_fixedStepNS == 0)
+            s_fixedStepNS = 1;
+        s_fixedAccumulatorNS = 0;
+        s_interpolationAlpha = 0.0;
+    }
+
+    uint32_t Time::ConsumeFixedSteps(uint32_t maxSteps, bool fastAsPossible) {
+        if (s_fixedStepNS == 0 || maxSteps == 0) {
+            s_interpolationAlpha = 0.0;
+            return 0;
+        }
+
+        // offline simulation, the ticks do not wait for the real time
+        if (fastAsPossible) {
+            s_fixedAccumulatorNS = 0;
+            s_interpolationAlpha = 1.0;
+            return maxSteps;
+        }
+
+        s_fixedAccumulatorNS += s_deltaTimeNS;
+        uint64_t steps = s_fixedAccumulatorNS / s_fixedStepNS;
+        s_fixedAccumulatorNS -= steps * s_fixedStepNS;
+
+        // a frame that took too long would need even more ticks next frame (spiral of death),
+        // the backlog above maxSteps is dropped and the simulation runs slower than real time
+        if (steps > maxSteps) {
+            s_droppedFixedTickCount += steps - maxSteps;
+            steps = maxSteps;
+        }
+
+        s_interpolationAlpha = static_cast<double>(s_fixedAccumulatorNS) / s_fixedStepNS;
+        return static_cast<uint32_t>(steps);
+    }
+
+    void Time::AdvanceFixedTick() {
+        s_fixedTickCount++;
     }
 
 }
\ No newline at end of file
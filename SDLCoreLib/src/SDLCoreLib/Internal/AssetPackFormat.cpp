@@ -0,0 +1,204 @@
+#include <cstring>
+
+#include "Internal/AssetPackFormat.h"
+
+namespace SDLCore::AssetPackFormat {
+
+	namespace {
+		constexpr size_t MIN_MATCH = 4;
+		constexpr size_t MAX_OFFSET = 0xFFFF;
+		constexpr int HASH_BITS = 16;
+		constexpr uint8_t LENGTH_MASK = 0x0F;
+
+		uint32_t Read32(const uint8_t* p) {
+			uint32_t value;
+			std::memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		uint64_t Read64(const uint8_t* p) {
+			uint64_t value;
+			std::memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		uint64_t Mix(uint64_t h) {
+			h ^= h >> 33;
+			h *= 0xff51afd7ed558ccdULL;
+			h ^= h >> 33;
+			h *= 0xc4ceb9fe1a85ec53ULL;
+			h ^= h >> 33;
+			return h;
+		}
+
+		// lengths >= 15 continue in the following bytes, 255 = one more byte follows
+		void WriteLength(std::vector<uint8_t>& out, size_t length) {
+			length -= LENGTH_MASK;
+			while (length >= 255) {
+				out.push_back(255);
+				length -= 255;
+			}
+			out.push_back(static_cast<uint8_t>(length));
+		}
+
+		bool ReadLength(const uint8_t*& ip, const uint8_t* end, size_t& length) {
+			uint8_t value = 0;
+			do {
+				if (ip >= end)
+					return false;
+				value = *ip++;
+				length += value;
+			} while (value == 255);
+			return true;
+		}
+
+		void WriteSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength) {
+			const bool hasMatch = matchLength >= MIN_MATCH;
+			const size_t matchCode = (hasMatch) ? matchLength - MIN_MATCH : 0;
+
+			uint8_t token = static_cast<uint8_t>(((literalCount < LENGTH_MASK) ? literalCount : LENGTH_MASK) << 4);
+			token |= static_cast<uint8_t>((matchCode < LENGTH_MASK) ? matchCode : LENGTH_MASK);
+			out.push_back(token);
+
+			if (literalCount >= LENGTH_MASK)
+				WriteLength(out, literalCount);
+			out.insert(out.end(), literals, literals + literalCount);
+
+			// the last sequence only has literals
+			if (!hasMatch)
+				return;
+
+			out.push_back(static_cast<uint8_t>(offset & 0xFF));
+			out.push_back(static_cast<uint8_t>(offset >> 8));
+			if (matchCode >= LENGTH_MASK)
+				WriteLength(out, matchCode);
+		}
+	}
+
+	std::string NormalizePath(std::string_view path) {
+		std::string result(path);
+		for (char& c : result) {
+			if (c == '\\')
+				c = '/';
+		}
+
+		size_t start = 0;
+		while (start < result.size()) {
+			if (result.compare(start, 2, "./") == 0)
+				start += 2;
+			else if (result[start] == '/')
+				start++;
+			else
+				break;
+		}
+		return result.substr(start);
+	}
+
+	uint64_t HashPath(std::string_view path) {
+		// FNV-1a
+		uint64_t h = 0xcbf29ce484222325ULL;
+		for (char c : path) {
+			h ^= static_cast<uint8_t>(c);
+			h *= 0x100000001b3ULL;
+		}
+		return h;
+	}
+
+	uint64_t Checksum(const void* data, size_t size) {
+		const uint8_t* bytes = static_cast<const uint8_t*>(data);
+		uint64_t h = 0x9e3779b97f4a7c15ULL ^ size;
+
+		size_t i = 0;
+		for (; i + 8 <= size; i += 8) {
+			h ^= Mix(Read64(bytes + i));
+			h = (h << 27) | (h >> 37);
+			h = h * 5 + 0x52dce729;
+		}
+
+		uint64_t tail = 0;
+		for (size_t shift = 0; i < size; i++, shift += 8)
+			tail |= static_cast<uint64_t>(bytes[i]) << shift;
+
+		return Mix(h ^ Mix(tail));
+	}
+
+	void Compress(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+		out.clear();
+		out.reserve(size + size / 255 + 16);
+
+		// last position + 1 of every hashed 4 byte sequence, 0 = none
+		std::vector<uint32_t> table(size_t(1) << HASH_BITS, 0);
+
+		size_t anchor = 0;
+		size_t pos = 0;
+		while (pos + MIN_MATCH <= size) {
+			const uint32_t sequence = Read32(data + pos);
+			const uint32_t hash = (sequence * 2654435761u) >> (32 - HASH_BITS);
+			const size_t candidate = table[hash];
+			table[hash] = static_cast<uint32_t>(pos + 1);
+
+			if (candidate == 0 || pos - (candidate - 1) > MAX_OFFSET || Read32(data + candidate - 1) != sequence) {
+				pos++;
+				continue;
+			}
+
+			const size_t match = candidate - 1;
+			size_t length = MIN_MATCH;
+			while (pos + length < size && data[match + length] == data[pos + length])
+				length++;
+
+			WriteSequence(out, data + anchor, pos - anchor, pos - match, length);
+			pos += length;
+			anchor = pos;
+		}
+
+		WriteSequence(out, data + anchor, size - anchor, 0, 0);
+	}
+
+	bool Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+		const uint8_t* ip = src;
+		const uint8_t* const end = src + srcSize;
+		uint8_t* op = dst;
+		uint8_t* const dstEnd = dst + dstSize;
+
+		while (ip < end) {
+			const uint8_t token = *ip++;
+
+			size_t literalCount = token >> 4;
+			if (literalCount == LENGTH_MASK && !ReadLength(ip, end, literalCount))
+				return false;
+			if (literalCount > static_cast<size_t>(end - ip) || literalCount > static_cast<size_t>(dstEnd - op))
+				return false;
+
+			std::memcpy(op, ip, literalCount);
+			ip += literalCount;
+			op += literalCount;
+
+			if (ip == end)
+				break;
+
+			if (end - ip < 2)
+				return false;
+			const size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+			ip += 2;
+			if (offset == 0 || offset > static_cast<size_t>(op - dst))
+				return false;
+
+			size_t length = token & LENGTH_MASK;
+			if (length == LENGTH_MASK && !ReadLength(ip, end, length))
+				return false;
+			length += MIN_MATCH;
+			if (length > static_cast<size_t>(dstEnd - op))
+				return false;
+
+			// the match can overlap the output, copied byte by byte
+			const uint8_t* match = op - offset;
+			for (size_t i = 0; i < length; i++)
+				op[i] = match[i];
+			op += length;
+		}
+
+		return op == dstEnd;
+	}
+
+}
@@ -0,0 +1,169 @@
+#include <vector>
+#include <algorithm>
+
+#include "Types/Font/FontAsset.h"
+#include "Internal/FontAssetCache.h"
+#include "Internal/FontAtlasWorker.h"
+#include "Internal/FontAtlasDiskCache.h"
+
+namespace SDLCore {
+
+	bool FontAssetKey::operator==(const FontAssetKey& o) const {
+		return path == o.path &&
+			data == o.data &&
+			dataSize == o.dataSize &&
+			size == o.size &&
+			style == o.style &&
+			sdf == o.sdf;
+	}
+
+	size_t FontAssetKeyHash::operator()(const FontAssetKey& k) const noexcept {
+		size_t h = std::hash<std::string>{}(k.path);
+		auto combine = [&h](size_t value) {
+			h ^= value + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+		};
+
+		combine(std::hash<const unsigned char*>{}(k.data));
+		combine(std::hash<size_t>{}(k.dataSize));
+		combine(std::hash<float>{}(k.size));
+		combine(std::hash<Uint32>{}(k.style));
+		combine(std::hash<bool>{}(k.sdf));
+		return h;
+	}
+
+	FontAssetCache& FontAssetCache::GetInstance() {
+		static FontAssetCache instance;
+		return instance;
+	}
+
+	std::shared_ptr<FontAsset> FontAssetCache::Get(const FontAssetKey& key) {
+		std::lock_guard lock(m_mutex);
+
+		auto it = m_entries.find(key);
+		if (it == m_entries.end())
+			return nullptr;
+
+		it->second.lastUseTick = ++m_useTick;
+		return it->second.asset;
+	}
+
+	bool FontAssetCache::Contains(const FontAssetKey& key) const {
+		std::lock_guard lock(m_mutex);
+		return m_entries.find(key) != m_entries.end();
+	}
+
+	std::shared_ptr<FontAsset> FontAssetCache::CreateAsset(const FontAssetKey& key, TTF_Font* font) {
+		auto asset = std::make_shared<FontAsset>(font, key.size, key.sdf, true);
+		FontAtlasDiskCache::GetCacheFile(key, asset->m_atlasCacheFile, asset->m_atlasCacheID);
+		return asset;
+	}
+
+	std::shared_ptr<FontAsset> FontAssetCache::Add(const FontAssetKey& key, TTF_Font* font, bool deferred) {
+		auto asset = CreateAsset(key, font);
+		if (deferred)
+			FontAtlasWorker::GetInstance().Schedule(asset);
+		else
+			asset->GenerateAtlas();
+
+		return Insert(key, std::move(asset));
+	}
+
+	std::shared_ptr<FontAsset> FontAssetCache::Insert(const FontAssetKey& key, std::shared_ptr<FontAsset> asset) {
+		std::shared_ptr<FontAsset> cached;
+		{
+			std::lock_guard lock(m_mutex);
+			CacheEntry& entry = m_entries[key];
+			if (!entry.asset)
+				entry.asset = asset;
+			entry.lastUseTick = ++m_useTick;
+			cached = entry.asset;
+		}
+
+		Trim();
+		return cached;
+	}
+
+	void FontAssetCache::Trim() {
+		std::lock_guard lock(m_mutex);
+		if (m_budgetBytes == 0)
+			return;
+
+		size_t usage = GetMemoryUsageUnlocked();
+		if (usage <= m_budgetBytes)
+			return;
+
+		// only assets that no Font (or the atlas worker) references can be destroyed
+		std::vector<std::pair<size_t, const FontAssetKey*>> unused;
+		for (const auto& [key, entry] : m_entries) {
+			if (entry.asset.use_count() == 1)
+				unused.emplace_back(entry.lastUseTick, &key);
+		}
+		std::sort(unused.begin(), unused.end(),
+			[](const auto& a, const auto& b) { return a.first < b.first; });
+
+		for (const auto& [_, key] : unused) {
+			if (usage <= m_budgetBytes)
+				break;
+
+			auto it = m_entries.find(*key);
+			size_t bytes = it->second.asset->GetMemoryUsage();
+			usage -= std::min(usage, bytes);
+			const unsigned char* data = it->first.data;
+			size_t dataSize = it->first.dataSize;
+			m_entries.erase(it);
+			ReleaseDataUnlocked(data, dataSize);
+		}
+	}
+
+	void FontAssetCache::ReleaseDataUnlocked(const unsigned char* data, size_t dataSize) {
+		if (!data)
+			return;
+
+		for (const auto& [key, _] : m_entries) {
+			if (key.data == data && key.dataSize == dataSize)
+				return;
+		}
+		FontAtlasDiskCache::ReleaseData(data, dataSize);
+	}
+
+	void FontAssetCache::SetBudget(size_t bytes) {
+		{
+			std::lock_guard lock(m_mutex);
+			m_budgetBytes = bytes;
+		}
+		Trim();
+	}
+
+	size_t FontAssetCache::GetBudget() const {
+		std::lock_guard lock(m_mutex);
+		return m_budgetBytes;
+	}
+
+	size_t FontAssetCache::GetMemoryUsage() const {
+		std::lock_guard lock(m_mutex);
+		return GetMemoryUsageUnlocked();
+	}
+
+	size_t FontAssetCache::GetAssetCount() const {
+		std::lock_guard lock(m_mutex);
+		return m_entries.size();
+	}
+
+	void FontAssetCache::Clear() {
+		std::lock_guard lock(m_mutex);
+		for (const auto& [key, _] : m_entries) {
+			if (key.data)
+				FontAtlasDiskCache::ReleaseData(key.data, key.dataSize);
+		}
+		m_entries.clear();
+		m_useTick = 0;
+	}
+
+	size_t FontAssetCache::GetMemoryUsageUnlocked() const {
+		size_t bytes = 0;
+		for (const auto& [_, entry] : m_entries)
+			bytes += entry.asset->GetMemoryUsage();
+		return bytes;
+	}
+
+}
@@ -0,0 +1,134 @@
+#include <map>
+#include <mutex>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <SDL3/SDL.h>
+
+#include "Application.h"
+#include "Internal/FontAssetCache.h"
+#include "Internal/FontAtlasDiskCache.h"
+
+namespace SDLCore::FontAtlasDiskCache {
+
+	namespace {
+		std::mutex s_mutex;// assets are created on the AssetLoader threads
+		bool s_directorySet = false;
+		SystemFilePath s_directory;
+
+		struct FileHash {
+			std::filesystem::file_time_type writeTime;
+			uint64_t hash = 0;
+		};
+		std::unordered_map<std::string, FileHash> s_fileHashes;
+		// the same address can hold other font data after the memory was released, so the size is part of the key
+		// and the entry is dropped by ReleaseData once no cached asset uses the data anymore
+		std::map<std::pair<const unsigned char*, size_t>, uint64_t> s_dataHashes;
+
+		// FNV-1a, only used to detect changed font data
+		uint64_t Hash(const void* data, size_t size) {
+			const uint8_t* bytes = static_cast<const uint8_t*>(data);
+			uint64_t h = 0xcbf29ce484222325ULL;
+			for (size_t i = 0; i < size; i++) {
+				h ^= bytes[i];
+				h *= 0x100000001b3ULL;
+			}
+			return h;
+		}
+
+		void Combine(uint64_t& h, uint64_t value) {
+			h ^= value + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+		}
+
+		bool GetFileHash(const std::string& path, uint64_t& outHash) {
+			std::error_code ec;
+			auto writeTime = std::filesystem::last_write_time(path, ec);
+			if (ec)
+				return false;
+
+			auto it = s_fileHashes.find(path);
+			if (it != s_fileHashes.end() && it->second.writeTime == writeTime) {
+				outHash = it->second.hash;
+				return true;
+			}
+
+			size_t size = 0;
+			void* data = SDL_LoadFile(path.c_str(), &size);
+			if (!data)
+				return false;
+
+			outHash = Hash(data, size);
+			SDL_free(data);
+			s_fileHashes[path] = FileHash{ writeTime, outHash };
+			return true;
+		}
+
+		uint64_t GetDataHash(const unsigned char* data, size_t size) {
+			auto it = s_dataHashes.find({ data, size });
+			if (it != s_dataHashes.end())
+				return it->second;
+
+			uint64_t h = Hash(data, size);
+			s_dataHashes[{ data, size }] = h;
+			return h;
+		}
+	}
+
+	void ReleaseData(const unsigned char* data, size_t size) {
+		std::lock_guard lock(s_mutex);
+		s_dataHashes.erase({ data, size });
+	}
+
+	void SetDirectory(const SystemFilePath& dir) {
+		std::lock_guard lock(s_mutex);
+		s_directory = dir;
+		s_directorySet = true;
+	}
+
+	SystemFilePath GetDirectory() {
+		{
+			std::lock_guard lock(s_mutex);
+			if (s_directorySet)
+				return s_directory;
+		}
+
+		Application* app = Application::GetInstance();
+		if (!app)
+			return {};
+		return app->GetPrefPath("SDLCoreLib") / "FontAtlasCache";
+	}
+
+	bool GetCacheFile(const FontAssetKey& key, SystemFilePath& outFile, uint64_t& outID) {
+		SystemFilePath dir = GetDirectory();
+		if (dir.empty())
+			return false;
+
+		std::lock_guard lock(s_mutex);
+		uint64_t fontHash = 0;
+		if (key.data) {
+			if (key.dataSize == 0)
+				return false;
+			fontHash = GetDataHash(key.data, key.dataSize);
+		}
+		else if (key.path.empty() || !GetFileHash(key.path, fontHash)) {
+			return false;
+		}
+
+		uint32_t sizeBits = 0;
+		static_assert(sizeof(sizeBits) == sizeof(key.size));
+		SDL_memcpy(&sizeBits, &key.size, sizeof(sizeBits));
+
+		uint64_t id = fontHash;
+		Combine(id, sizeBits);
+		Combine(id, key.style);
+		Combine(id, key.sdf ? 1 : 0);
+		Combine(id, VERSION);
+
+		char name[32];
+		std::snprintf(name, sizeof(name), "%016llx.atlas", static_cast<unsigned long long>(id));
+		outFile = dir / name;
+		outID = id;
+		return true;
+	}
+
+}
@@ -0,0 +1,70 @@
+#include "Types/Font/FontAsset.h"
+#include "Internal/FontAtlasWorker.h"
+#include "Application.h"
+
+namespace SDLCore {
+
+	FontAtlasWorker::~FontAtlasWorker() {
+		Shutdown();
+	}
+
+	FontAtlasWorker& FontAtlasWorker::GetInstance() {
+		static FontAtlasWorker instance;
+		return instance;
+	}
+
+	void FontAtlasWorker::Schedule(std::shared_ptr<FontAsset> asset) {
+		if (!asset)
+			return;
+
+		{
+			std::lock_guard lock(m_mutex);
+			if (!m_shutdown) {
+				if (!m_running) {
+					m_running = true;
+					m_thread = std::thread(&FontAtlasWorker::Run, this);
+				}
+				m_queue.push_back(std::move(asset));
+				m_condition.notify_one();
+				return;
+			}
+		}
+
+		asset->GenerateAtlas();
+	}
+
+	void FontAtlasWorker::Shutdown() {
+		{
+			std::lock_guard lock(m_mutex);
+			m_shutdown = true;
+			m_queue.clear();
+		}
+		m_condition.notify_all();
+
+		if (m_thread.joinable())
+			m_thread.join();
+		m_running = false;
+	}
+
+	void FontAtlasWorker::Run() {
+		while (true) {
+			std::shared_ptr<FontAsset> asset;
+			{
+				std::unique_lock lock(m_mutex);
+				m_condition.wait(lock, [this]() { return m_shutdown || !m_queue.empty(); });
+				if (m_shutdown)
+					return;
+
+				asset = std::move(m_queue.front());
+				m_queue.pop_front();
+			}
+
+			asset->GenerateAtlas();
+
+			// text of an idle application is drawn once the atlas is ready
+			if (auto* app = Application::GetInstance())
+				app->RequestRedraw();
+		}
+	}
+
+}
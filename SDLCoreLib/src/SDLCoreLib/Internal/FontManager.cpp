@@ -43,6 +43,20 @@ namespace SDLCore {
 		return instance;
 	}
 
+	TTF_Font* FontManager::OpenFont(const std::string& path, float size) {
+		std::lock_guard lock(m_mutex);
+		return TTF_OpenFont(path.c_str(), size);
+	}
+
+	TTF_Font* FontManager::OpenFontFromMem(const unsigned char* data, size_t dataSize, float size) {
+		SDL_IOStream* io = SDL_IOFromConstMem(data, dataSize);
+		if (!io)
+			return nullptr;
+
+		std::lock_guard lock(m_mutex);
+		return TTF_OpenFontIO(io, true, size);
+	}
+
 	FontID FontManager::RegisterFont(TTF_Font* font) {
 		std::lock_guard lock(m_mutex);
 
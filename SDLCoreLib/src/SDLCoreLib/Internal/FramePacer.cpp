@@ -0,0 +1,108 @@
+#include <cmath>
+#include <algorithm>
+#include <SDL3/SDL.h>
+
+#include "Internal/FramePacer.h"
+
+namespace SDLCore {
+
+	void FramePacer::SetTargetFrameRate(int fps) {
+		m_targetFrameRate = std::max(fps, 0);
+		m_frameTimeNS = (m_targetFrameRate > 0) ? SDL_NS_PER_SECOND / static_cast<uint64_t>(m_targetFrameRate) : 0;
+		Restart();
+	}
+
+	int FramePacer::GetTargetFrameRate() const {
+		return m_targetFrameRate;
+	}
+
+	bool FramePacer::IsEnabled() const {
+		return m_frameTimeNS > 0;
+	}
+
+	void FramePacer::Wait() {
+		if (m_frameTimeNS == 0)
+			return;
+
+		uint64_t now = SDL_GetTicksNS();
+		// the first frame starts the deadline sequence
+		if (m_deadlineNS == 0) {
+			m_deadlineNS = now + m_frameTimeNS;
+			return;
+		}
+
+		const bool late = now >= m_deadlineNS;
+		uint64_t spinNS = 0;
+		if (!late) {
+			uint64_t remaining = m_deadlineNS - now;
+			if (remaining > m_sleepMarginNS) {
+				Sleep(remaining - m_sleepMarginNS);
+				now = SDL_GetTicksNS();
+			}
+
+			const uint64_t spinStart = now;
+			while (now < m_deadlineNS) {
+				SDL_CPUPauseInstruction();
+				now = SDL_GetTicksNS();
+			}
+			spinNS = now - spinStart;
+		}
+
+		const int64_t errorNS = static_cast<int64_t>(now - m_deadlineNS);
+
+		// the deadline advances by one frame time, small delays are made up in the next frame.
+		// If the frame is late by more than a frame (hitch, window drag, breakpoint)
+		// the sequence restarts instead of running the missed frames without a wait
+		m_deadlineNS += m_frameTimeNS;
+		const bool resync = now >= m_deadlineNS;
+		if (resync)
+			m_deadlineNS = now + m_frameTimeNS;
+
+		AddStats(errorNS, spinNS, late, resync);
+	}
+
+	void FramePacer::Restart() {
+		m_deadlineNS = 0;
+	}
+
+	const FramePacingStats& FramePacer::GetStats() const {
+		return m_stats;
+	}
+
+	void FramePacer::ResetStats() {
+		m_stats = FramePacingStats{};
+	}
+
+	void FramePacer::Sleep(uint64_t ns) {
+		const uint64_t start = SDL_GetTicksNS();
+		SDL_DelayNS(ns);
+		const uint64_t slept = SDL_GetTicksNS() - start;
+		const uint64_t oversleep = (slept > ns) ? slept - ns : 0;
+
+		// grows at once so the next frame does not oversleep again, shrinks slowly
+		if (oversleep > m_sleepMarginNS)
+			m_sleepMarginNS = oversleep;
+		else
+			m_sleepMarginNS -= (m_sleepMarginNS - oversleep) / 16;
+		m_sleepMarginNS = std::clamp(m_sleepMarginNS, MIN_SLEEP_MARGIN_NS, MAX_SLEEP_MARGIN_NS);
+	}
+
+	void FramePacer::AddStats(int64_t errorNS, uint64_t spinNS, bool late, bool resync) {
+		constexpr double nsToMS = 1.0 / SDL_NS_PER_MS;
+		const double errorMS = static_cast<double>(errorNS) * nsToMS;
+		const double absErrorMS = std::abs(errorMS);
+
+		m_stats.frameCount++;
+		if (late)
+			m_stats.lateFrameCount++;
+		if (resync)
+			m_stats.resyncCount++;
+
+		const double count = static_cast<double>(m_stats.frameCount);
+		m_stats.averageErrorMS += (absErrorMS - m_stats.averageErrorMS) / count;
+		m_stats.averageSpinMS += (static_cast<double>(spinNS) * nsToMS - m_stats.averageSpinMS) / count;
+		m_stats.maxErrorMS = std::max(m_stats.maxErrorMS, absErrorMS);
+		m_stats.lastErrorMS = errorMS;
+	}
+
+}
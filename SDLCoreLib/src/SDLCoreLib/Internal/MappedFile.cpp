@@ -0,0 +1,124 @@
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <utility>
+
+#include "Internal/MappedFile.h"
+
+namespace SDLCore {
+
+	MappedFile::~MappedFile() {
+		Close();
+	}
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept {
+		*this = std::move(other);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+		if (this == &other)
+			return *this;
+
+		Close();
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+		m_fileHandle = std::exchange(other.m_fileHandle, nullptr);
+		m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+#endif
+		return *this;
+	}
+
+	bool MappedFile::Open(const SystemFilePath& path) {
+		Close();
+
+#ifdef _WIN32
+		HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping) {
+			CloseHandle(file);
+			return false;
+		}
+
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!view) {
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_fileHandle = file;
+		m_mappingHandle = mapping;
+		m_data = static_cast<const uint8_t*>(view);
+		m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat info;
+		if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+			close(fd);
+			return false;
+		}
+
+		void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		// the mapping stays valid after the descriptor is closed
+		close(fd);
+		if (view == MAP_FAILED)
+			return false;
+
+		m_data = static_cast<const uint8_t*>(view);
+		m_size = static_cast<size_t>(info.st_size);
+#endif
+		return true;
+	}
+
+	void MappedFile::Close() {
+		if (!m_data)
+			return;
+
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+		CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+		CloseHandle(static_cast<HANDLE>(m_fileHandle));
+		m_mappingHandle = nullptr;
+		m_fileHandle = nullptr;
+#else
+		munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	bool MappedFile::IsOpen() const {
+		return m_data != nullptr;
+	}
+
+	const uint8_t* MappedFile::GetData() const {
+		return m_data;
+	}
+
+	size_t MappedFile::GetSize() const {
+		return m_size;
+	}
+
+}
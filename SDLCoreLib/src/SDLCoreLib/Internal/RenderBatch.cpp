@@ -0,0 +1,259 @@
+#include <algorithm>
+
+#include "SDLCoreError.h"
+#include "Internal/RenderBatch.h"
+
+namespace SDLCore {
+
+	bool RenderBatch::State::operator==(const State& o) const {
+		if (texture != o.texture ||
+			blendMode != o.blendMode ||
+			scaleMode != o.scaleMode ||
+			clipEnabled != o.clipEnabled)
+			return false;
+
+		if (!clipEnabled)
+			return true;
+
+		return clipRect.x == o.clipRect.x &&
+			clipRect.y == o.clipRect.y &&
+			clipRect.w == o.clipRect.w &&
+			clipRect.h == o.clipRect.h;
+	}
+
+	void RenderBatch::AddGeometry(SDL_Renderer* renderer,
+		SDL_Texture* texture,
+		const SDL_Vertex* vertices,
+		size_t vertexCount,
+		const int* indices,
+		size_t indexCount)
+	{
+		if (!renderer || !vertices || vertexCount == 0)
+			return;
+
+		SDL_FRect bounds = CalculateBounds(vertices, vertexCount);
+		Batch& batch = GetBatchFor(CaptureState(renderer, texture), bounds);
+
+		int baseIndex = static_cast<int>(batch.vertices.size());
+		batch.vertices.insert(batch.vertices.end(), vertices, vertices + vertexCount);
+
+		if (indices && indexCount > 0) {
+			batch.indices.reserve(batch.indices.size() + indexCount);
+			for (size_t i = 0; i < indexCount; i++)
+				batch.indices.push_back(baseIndex + indices[i]);
+		}
+		else {
+			batch.indices.reserve(batch.indices.size() + vertexCount);
+			for (size_t i = 0; i < vertexCount; i++)
+				batch.indices.push_back(baseIndex + static_cast<int>(i));
+		}
+
+		m_recordedDraws++;
+	}
+
+	void RenderBatch::AddRect(SDL_Renderer* renderer, const SDL_FRect& rect, const SDL_FColor& color) {
+		if (!renderer)
+			return;
+
+		Batch& batch = GetBatchFor(CaptureState(renderer, nullptr), rect);
+
+		int base = static_cast<int>(batch.vertices.size());
+		const SDL_FPoint uv{ 0.0f, 0.0f };
+		batch.vertices.push_back({ { rect.x, rect.y }, color, uv });
+		batch.vertices.push_back({ { rect.x + rect.w, rect.y }, color, uv });
+		batch.vertices.push_back({ { rect.x + rect.w, rect.y + rect.h }, color, uv });
+		batch.vertices.push_back({ { rect.x, rect.y + rect.h }, color, uv });
+
+		const int quad[6] = { 0, 1, 2, 0, 2, 3 };
+		for (int i : quad)
+			batch.indices.push_back(base + i);
+
+		m_recordedDraws++;
+	}
+
+	bool RenderBatch::Flush(SDL_Renderer* renderer) {
+		if (m_batchCount == 0)
+			return true;
+
+		if (!renderer) {
+			Clear();
+			return false;
+		}
+
+		// state of the renderer before the flush, restored afterwards
+		bool prevClipEnabled = SDL_RenderClipEnabled(renderer);
+		SDL_Rect prevClipRect{ 0, 0, 0, 0 };
+		if (prevClipEnabled)
+			SDL_GetRenderClipRect(renderer, &prevClipRect);
+		SDL_BlendMode prevBlendMode = SDL_BLENDMODE_NONE;
+		SDL_GetRenderDrawBlendMode(renderer, &prevBlendMode);
+
+		bool result = true;
+		bool clipEnabled = prevClipEnabled;
+		SDL_Rect clipRect = prevClipRect;
+		SDL_BlendMode drawBlendMode = prevBlendMode;
+
+		for (size_t i = 0; i < m_batchCount; i++) {
+			Batch& batch = m_batches[i];
+			const State& state = batch.state;
+
+			if (batch.indices.empty())
+				continue;
+
+			if (state.clipEnabled != clipEnabled ||
+				(state.clipEnabled && (state.clipRect.x != clipRect.x || state.clipRect.y != clipRect.y ||
+					state.clipRect.w != clipRect.w || state.clipRect.h != clipRect.h)))
+			{
+				SDL_SetRenderClipRect(renderer, state.clipEnabled ? &state.clipRect : nullptr);
+				clipEnabled = state.clipEnabled;
+				clipRect = state.clipRect;
+			}
+
+			if (state.texture) {
+				SDL_BlendMode texBlend = SDL_BLENDMODE_INVALID;
+				SDL_GetTextureBlendMode(state.texture, &texBlend);
+				if (texBlend != state.blendMode)
+					SDL_SetTextureBlendMode(state.texture, state.blendMode);
+
+				SDL_ScaleMode texScale = SDL_SCALEMODE_INVALID;
+				SDL_GetTextureScaleMode(state.texture, &texScale);
+				if (state.scaleMode != SDL_SCALEMODE_INVALID && texScale != state.scaleMode)
+					SDL_SetTextureScaleMode(state.texture, state.scaleMode);
+			}
+			else if (state.blendMode != drawBlendMode) {
+				SDL_SetRenderDrawBlendMode(renderer, state.blendMode);
+				drawBlendMode = state.blendMode;
+			}
+
+			if (!SDL_RenderGeometry(renderer,
+				state.texture,
+				batch.vertices.data(),
+				static_cast<int>(batch.vertices.size()),
+				batch.indices.data(),
+				static_cast<int>(batch.indices.size())))
+			{
+				SetErrorF("SDLCore::RenderBatch::Flush: Failed to submit batch (vertices={}, indices={}): {}",
+					batch.vertices.size(), batch.indices.size(), SDL_GetError());
+				result = false;
+			}
+			m_submittedDraws++;
+		}
+
+		if (clipEnabled != prevClipEnabled ||
+			clipRect.x != prevClipRect.x || clipRect.y != prevClipRect.y ||
+			clipRect.w != prevClipRect.w || clipRect.h != prevClipRect.h)
+		{
+			SDL_SetRenderClipRect(renderer, prevClipEnabled ? &prevClipRect : nullptr);
+		}
+
+		if (drawBlendMode != prevBlendMode)
+			SDL_SetRenderDrawBlendMode(renderer, prevBlendMode);
+
+		Clear();
+		return result;
+	}
+
+	void RenderBatch::Clear() {
+		for (size_t i = 0; i < m_batchCount; i++) {
+			m_batches[i].vertices.clear();
+			m_batches[i].indices.clear();
+		}
+		m_batchCount = 0;
+	}
+
+	bool RenderBatch::IsEmpty() const {
+		return m_batchCount == 0;
+	}
+
+	void RenderBatch::EndFrame() {
+		m_lastFrameRecordedDraws = m_recordedDraws;
+		m_lastFrameSubmittedDraws = m_submittedDraws;
+		m_recordedDraws = 0;
+		m_submittedDraws = 0;
+	}
+
+	size_t RenderBatch::GetLastFrameRecordedDraws() const {
+		return m_lastFrameRecordedDraws;
+	}
+
+	size_t RenderBatch::GetLastFrameSubmittedDraws() const {
+		return m_lastFrameSubmittedDraws;
+	}
+
+	RenderBatch::State RenderBatch::CaptureState(SDL_Renderer* renderer, SDL_Texture* texture) const {
+		State state;
+		state.texture = texture;
+
+		if (texture) {
+			SDL_GetTextureBlendMode(texture, &state.blendMode);
+			SDL_GetTextureScaleMode(texture, &state.scaleMode);
+		}
+		else {
+			SDL_GetRenderDrawBlendMode(renderer, &state.blendMode);
+		}
+
+		state.clipEnabled = SDL_RenderClipEnabled(renderer);
+		if (state.clipEnabled)
+			SDL_GetRenderClipRect(renderer, &state.clipRect);
+
+		return state;
+	}
+
+	RenderBatch::Batch& RenderBatch::GetBatchFor(const State& state, const SDL_FRect& bounds) {
+		// search backwards for a batch with the same state. Skipping a batch is only
+		// allowed if it does not overlap the new geometry, otherwise the draw order would change
+		size_t searched = 0;
+		for (size_t i = m_batchCount; i > 0 && searched < MAX_MERGE_LOOKBACK; i--, searched++) {
+			Batch& batch = m_batches[i - 1];
+			if (batch.state == state) {
+				ExtendBounds(batch.bounds, bounds);
+				return batch;
+			}
+
+			if (Overlaps(batch.bounds, bounds))
+				break;
+		}
+
+		if (m_batchCount == m_batches.size())
+			m_batches.emplace_back();
+
+		Batch& batch = m_batches[m_batchCount++];
+		batch.state = state;
+		batch.bounds = bounds;
+		batch.vertices.clear();
+		batch.indices.clear();
+		return batch;
+	}
+
+	SDL_FRect RenderBatch::CalculateBounds(const SDL_Vertex* vertices, size_t vertexCount) {
+		float minX = vertices[0].position.x;
+		float minY = vertices[0].position.y;
+		float maxX = minX;
+		float maxY = minY;
+
+		for (size_t i = 1; i < vertexCount; i++) {
+			const SDL_FPoint& p = vertices[i].position;
+			minX = std::min(minX, p.x);
+			minY = std::min(minY, p.y);
+			maxX = std::max(maxX, p.x);
+			maxY = std::max(maxY, p.y);
+		}
+
+		return SDL_FRect{ minX, minY, maxX - minX, maxY - minY };
+	}
+
+	bool RenderBatch::Overlaps(const SDL_FRect& a, const SDL_FRect& b) {
+		// inclusive test, touching edges can still share pixels after rasterization
+		return a.x <= b.x + b.w && b.x <= a.x + a.w &&
+			a.y <= b.y + b.h && b.y <= a.y + a.h;
+	}
+
+	void RenderBatch::ExtendBounds(SDL_FRect& bounds, const SDL_FRect& other) {
+		float minX = std::min(bounds.x, other.x);
+		float minY = std::min(bounds.y, other.y);
+		float maxX = std::max(bounds.x + bounds.w, other.x + other.w);
+		float maxY = std::max(bounds.y + bounds.h, other.y + other.h);
+		bounds = SDL_FRect{ minX, minY, maxX - minX, maxY - minY };
+	}
+
+}
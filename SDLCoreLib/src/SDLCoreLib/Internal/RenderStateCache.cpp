@@ -0,0 +1,127 @@
+#include "Internal/RenderStateCache.h"
+
+namespace SDLCore {
+
+	uint64_t RenderStateCache::s_skippedCalls = 0;
+	uint64_t RenderStateCache::s_issuedCalls = 0;
+
+	bool RenderStateCache::SetDrawColor(SDL_Renderer* renderer, const SDL_Color& color) {
+		if (m_drawColorValid &&
+			m_drawColor.r == color.r &&
+			m_drawColor.g == color.g &&
+			m_drawColor.b == color.b &&
+			m_drawColor.a == color.a)
+		{
+			s_skippedCalls++;
+			return true;
+		}
+
+		s_issuedCalls++;
+		if (!SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a)) {
+			m_drawColorValid = false;
+			return false;
+		}
+
+		m_drawColor = color;
+		m_drawColorValid = true;
+		return true;
+	}
+
+	bool RenderStateCache::SetDrawBlendMode(SDL_Renderer* renderer, SDL_BlendMode mode) {
+		if (m_blendModeValid && m_blendMode == mode) {
+			s_skippedCalls++;
+			return true;
+		}
+
+		s_issuedCalls++;
+		if (!SDL_SetRenderDrawBlendMode(renderer, mode)) {
+			m_blendModeValid = false;
+			return false;
+		}
+
+		m_blendMode = mode;
+		m_blendModeValid = true;
+		return true;
+	}
+
+	bool RenderStateCache::SetClipRect(SDL_Renderer* renderer, const SDL_Rect* rect) {
+		bool enabled = rect != nullptr;
+		if (m_clipValid && m_clipEnabled == enabled && (!enabled || RectEquals(m_clipRect, *rect))) {
+			s_skippedCalls++;
+			return true;
+		}
+
+		s_issuedCalls++;
+		if (!SDL_SetRenderClipRect(renderer, rect)) {
+			m_clipValid = false;
+			return false;
+		}
+
+		m_clipEnabled = enabled;
+		if (enabled)
+			m_clipRect = *rect;
+		m_clipValid = true;
+		return true;
+	}
+
+	bool RenderStateCache::SetViewport(SDL_Renderer* renderer, const SDL_Rect* rect) {
+		if (!IsViewportDifferent(rect)) {
+			s_skippedCalls++;
+			return true;
+		}
+
+		s_issuedCalls++;
+		if (!SDL_SetRenderViewport(renderer, rect)) {
+			m_viewportValid = false;
+			return false;
+		}
+
+		m_viewportSet = rect != nullptr;
+		if (rect)
+			m_viewport = *rect;
+		m_viewportValid = true;
+		return true;
+	}
+
+	bool RenderStateCache::IsViewportDifferent(const SDL_Rect* rect) const {
+		bool set = rect != nullptr;
+		return !m_viewportValid || m_viewportSet != set || (set && !RectEquals(m_viewport, *rect));
+	}
+
+	void RenderStateCache::Invalidate() {
+		m_drawColorValid = false;
+		m_blendModeValid = false;
+		m_clipValid = false;
+		m_viewportValid = false;
+	}
+
+	void RenderStateCache::InvalidateDrawColor() {
+		m_drawColorValid = false;
+	}
+
+	void RenderStateCache::CountSkipped(uint64_t count) {
+		s_skippedCalls += count;
+	}
+
+	void RenderStateCache::CountIssued(uint64_t count) {
+		s_issuedCalls += count;
+	}
+
+	uint64_t RenderStateCache::GetSkippedCalls() {
+		return s_skippedCalls;
+	}
+
+	uint64_t RenderStateCache::GetIssuedCalls() {
+		return s_issuedCalls;
+	}
+
+	void RenderStateCache::ResetCounters() {
+		s_skippedCalls = 0;
+		s_issuedCalls = 0;
+	}
+
+	bool RenderStateCache::RectEquals(const SDL_Rect& a, const SDL_Rect& b) {
+		return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h;
+	}
+
+}
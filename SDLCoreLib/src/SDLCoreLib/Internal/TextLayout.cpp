@@ -0,0 +1,364 @@
+#include <algorithm>
+#include <SDL3/SDL.h>
+
+#include "SDLCoreTime.h"
+#include "Types/Font/FontAsset.h"
+#include "Internal/TextLayout.h"
+
+namespace SDLCore {
+
+	namespace {
+		constexpr uint64_t EVICT_INTERVAL_FRAMES = 60;
+
+		void HashCombine(size_t& seed, size_t value) {
+			seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+		}
+
+		size_t HashLayout(uint64_t assetID, std::string_view text, const TextLayoutParams& params) {
+			size_t h = std::hash<std::string_view>{}(text);
+			HashCombine(h, std::hash<uint64_t>{}(assetID));
+			HashCombine(h, std::hash<float>{}(params.scale));
+			HashCombine(h, std::hash<float>{}(params.clipWidth));
+			HashCombine(h, std::hash<size_t>{}(params.maxLines));
+			return h;
+		}
+
+		size_t HashLayout(uint64_t assetID, std::string_view text, const TextFitParams& params) {
+			size_t h = HashLayout(assetID, text, params.layout);
+			HashCombine(h, std::hash<float>{}(params.targetW));
+			HashCombine(h, std::hash<float>{}(params.targetH));
+			HashCombine(h, std::hash<float>{}(params.lineHeightMultiplier));
+			return h;
+		}
+
+		void BuildUnwrappedLines(FontAsset* asset, std::string_view text, const TextLayoutParams& params, TextLayout& out) {
+			// same lines as std::getline, a trailing '\n' does not start an empty line
+			size_t pos = 0;
+			while (pos < text.size()) {
+				size_t end = text.find('\n', pos);
+				if (end == std::string_view::npos)
+					end = text.size();
+
+				TextLayoutLine line;
+				line.firstGlyph = static_cast<Uint32>(out.glyphs.size());
+				line.textStart = pos;
+				const Uint32 lineIndex = static_cast<Uint32>(out.lines.size());
+
+				const char* str = text.data() + pos;
+				size_t len = end - pos;
+				while (len > 0) {
+					const Uint32 offset = static_cast<Uint32>(str - text.data());
+					Uint32 c = SDL_StepUTF8(&str, &len);
+					int glyphAdvance = asset->GetGlyphAdvance(c);
+					if (glyphAdvance == FontAsset::NO_GLYPH)
+						continue;
+
+					float advance = static_cast<float>(glyphAdvance) * params.scale;
+					out.glyphs.push_back(TextLayoutGlyph{ c, line.width, advance, lineIndex, offset });
+					line.width += advance;
+				}
+
+				line.glyphCount = static_cast<Uint32>(out.glyphs.size()) - line.firstGlyph;
+				out.lines.push_back(line);
+				pos = end + 1;
+
+				if (params.maxLines != 0 && out.lines.size() >= params.maxLines)
+					break;
+			}
+		}
+
+		void BuildWrappedLines(FontAsset* asset, std::string_view text, const TextLayoutParams& params, TextLayout& out) {
+			const float clipWidth = params.clipWidth;
+			auto& glyphs = out.glyphs;
+
+			// glyphs of the current word are positioned relative to the word start until the word is placed
+			Uint32 lineStart = 0;
+			float lineWidth = 0.0f;
+			Uint32 wordStart = 0;
+			float wordWidth = 0.0f;
+
+			auto endLine = [&](Uint32 end) {
+				if (end > lineStart) {
+					const Uint32 lineIndex = static_cast<Uint32>(out.lines.size());
+					for (Uint32 i = lineStart; i < end; ++i)
+						glyphs[i].line = lineIndex;
+					out.lines.push_back(TextLayoutLine{ lineStart, end - lineStart, lineWidth, glyphs[lineStart].byteOffset });
+				}
+				lineStart = end;
+				lineWidth = 0.0f;
+			};
+
+			auto placeWord = [&]() {
+				const Uint32 wordEnd = static_cast<Uint32>(glyphs.size());
+				if (wordEnd == wordStart)
+					return;
+
+				if (lineWidth + wordWidth <= clipWidth) {
+					for (Uint32 i = wordStart; i < wordEnd; ++i)
+						glyphs[i].x += lineWidth;
+					lineWidth += wordWidth;
+				}
+				else {
+					endLine(wordStart);
+
+					if (wordWidth > clipWidth) {
+						// the word does not fit into an empty line, break it at any character
+						for (Uint32 i = wordStart; i < wordEnd; ++i) {
+							if (lineWidth + glyphs[i].advance > clipWidth)
+								endLine(i);
+							glyphs[i].x = lineWidth;
+							lineWidth += glyphs[i].advance;
+						}
+					}
+					else {
+						lineWidth = wordWidth;
+					}
+				}
+
+				wordStart = wordEnd;
+				wordWidth = 0.0f;
+			};
+
+			const char* str = text.data();
+			size_t len = text.size();
+			while (len > 0) {
+				const Uint32 offset = static_cast<Uint32>(str - text.data());
+				Uint32 c = SDL_StepUTF8(&str, &len);
+				if (c == '\n') {
+					placeWord();
+					endLine(static_cast<Uint32>(glyphs.size()));
+				}
+				else if (int glyphAdvance = asset->GetGlyphAdvance(c); glyphAdvance != FontAsset::NO_GLYPH) {
+					float advance = static_cast<float>(glyphAdvance) * params.scale;
+					glyphs.push_back(TextLayoutGlyph{ c, wordWidth, advance, 0, offset });
+					wordWidth += advance;
+
+					if (c == ' ' || c == '\t')
+						placeWord();
+				}
+
+				// finished lines do not change anymore
+				if (params.maxLines != 0 && out.lines.size() >= params.maxLines)
+					break;
+			}
+
+			placeWord();
+			endLine(static_cast<Uint32>(glyphs.size()));
+
+			if (params.maxLines != 0 && out.lines.size() > params.maxLines) {
+				out.lines.resize(params.maxLines);
+				const TextLayoutLine& last = out.lines.back();
+				glyphs.resize(last.firstGlyph + last.glyphCount);
+			}
+		}
+	}
+
+	void TextLayout::Clear() {
+		glyphs.clear();
+		lines.clear();
+		blockWidth = 0.0f;
+	}
+
+	void BuildTextLayout(FontAsset* asset, std::string_view text, const TextLayoutParams& params, TextLayout& out) {
+		out.Clear();
+		if (!asset)
+			return;
+
+		if (params.clipWidth == -1.0f)
+			BuildUnwrappedLines(asset, text, params, out);
+		else
+			BuildWrappedLines(asset, text, params, out);
+
+		for (const auto& line : out.lines)
+			out.blockWidth = std::max(out.blockWidth, line.width);
+	}
+
+	size_t TextWidthTable::GetGlyphCount() const {
+		return prefix.size() - 1;
+	}
+
+	float TextWidthTable::GetWidth(size_t firstGlyph, size_t lastGlyph) const {
+		return prefix[lastGlyph] - prefix[firstGlyph];
+	}
+
+	float TextWidthTable::GetWidth() const {
+		return prefix.back();
+	}
+
+	size_t TextWidthTable::GetFittingGlyphCount(float maxWidth) const {
+		// first prefix that is wider than maxWidth, the glyph before it does not fit
+		auto it = std::upper_bound(prefix.begin() + 1, prefix.end(), maxWidth);
+		return static_cast<size_t>(it - prefix.begin()) - 1;
+	}
+
+	void TextWidthTable::Clear() {
+		prefix.assign(1, 0.0f);
+		offsets.assign(1, 0);
+	}
+
+	void BuildTextWidthTable(FontAsset* asset, std::string_view text, float scale, TextWidthTable& out) {
+		out.prefix.clear();
+		out.offsets.clear();
+		out.prefix.push_back(0.0f);
+
+		// advances are summed as integers like the glyphs are placed by the font
+		int width = 0;
+		const char* str = text.data();
+		size_t len = text.size();
+		while (asset && len > 0) {
+			const Uint32 offset = static_cast<Uint32>(str - text.data());
+			int advance = asset->GetGlyphAdvance(SDL_StepUTF8(&str, &len));
+			if (advance == FontAsset::NO_GLYPH)
+				continue;
+
+			width += advance;
+			out.offsets.push_back(offset);
+			out.prefix.push_back(static_cast<float>(width) * scale);
+		}
+		out.offsets.push_back(static_cast<Uint32>(text.size()));
+	}
+
+	template<typename T, typename P>
+	template<typename BuildFunc>
+	const T* TextLayoutCache::Store<T, P>::Get(uint64_t assetID, std::string_view text, const P& params, BuildFunc&& build) {
+		const uint64_t frame = Time::GetFrameCount();
+		const size_t hash = HashLayout(assetID, text, params);
+
+		auto it = hashToEntry.find(hash);
+		if (it != hashToEntry.end()) {
+			Entry& entry = entries[it->second];
+			entry.lastUseFrame = frame;
+			if (entry.assetID == assetID && entry.params == params && entry.text == text)
+				return &entry.value;
+
+			// hash collision, the entry is replaced
+			entry.assetID = assetID;
+			entry.params = params;
+			entry.text.assign(text.data(), text.size());
+			build(entry.value);
+			return &entry.value;
+		}
+
+		Uint32 index = 0;
+		if (!freeEntries.empty()) {
+			index = freeEntries.back();
+			freeEntries.pop_back();
+		}
+		else if (entries.size() < MAX_ENTRIES) {
+			index = static_cast<Uint32>(entries.size());
+			entries.emplace_back();
+		}
+		else {
+			build(scratch);
+			return &scratch;
+		}
+
+		Entry& entry = entries[index];
+		entry.assetID = assetID;
+		entry.params = params;
+		entry.text.assign(text.data(), text.size());
+		entry.lastUseFrame = frame;
+		build(entry.value);
+		hashToEntry.emplace(hash, index);
+		return &entry.value;
+	}
+
+	template<typename T, typename P>
+	const T* TextLayoutCache::Store<T, P>::Find(uint64_t assetID, std::string_view text, const P& params) {
+		auto it = hashToEntry.find(HashLayout(assetID, text, params));
+		if (it == hashToEntry.end())
+			return nullptr;
+
+		Entry& entry = entries[it->second];
+		if (entry.assetID != assetID || !(entry.params == params) || entry.text != text)
+			return nullptr;
+
+		entry.lastUseFrame = Time::GetFrameCount();
+		return &entry.value;
+	}
+
+	template<typename T, typename P>
+	void TextLayoutCache::Store<T, P>::EvictOld(uint64_t currentFrame) {
+		for (auto it = hashToEntry.begin(); it != hashToEntry.end(); ) {
+			Entry& entry = entries[it->second];
+			if (currentFrame - entry.lastUseFrame <= TTL_FRAMES) {
+				++it;
+				continue;
+			}
+
+			// the memory of the entry is kept for the next text
+			entry.text.clear();
+			entry.value.Clear();
+			freeEntries.push_back(it->second);
+			it = hashToEntry.erase(it);
+		}
+	}
+
+	template<typename T, typename P>
+	void TextLayoutCache::Store<T, P>::Clear() {
+		entries.clear();
+		freeEntries.clear();
+		hashToEntry.clear();
+		scratch.Clear();
+	}
+
+	const TextLayout* TextLayoutCache::Get(FontAsset* asset, std::string_view text, const TextLayoutParams& params) {
+		if (!asset)
+			return nullptr;
+
+		return m_layouts.Get(asset->GetID(), text, params,
+			[&](TextLayout& out) { BuildTextLayout(asset, text, params, out); });
+	}
+
+	const TextWidthTable* TextLayoutCache::GetWidthTable(FontAsset* asset, std::string_view text, float scale) {
+		if (!asset)
+			return nullptr;
+
+		TextLayoutParams params;
+		params.scale = scale;
+		return m_widthTables.Get(asset->GetID(), text, params,
+			[&](TextWidthTable& out) { BuildTextWidthTable(asset, text, scale, out); });
+	}
+
+	bool TextLayoutCache::GetFittedSize(FontAsset* asset, std::string_view text, const TextFitParams& params, float& outSize) {
+		if (!asset)
+			return false;
+
+		const FittedSize* fitted = m_fittedSizes.Find(asset->GetID(), text, params);
+		if (!fitted)
+			return false;
+
+		outSize = fitted->size;
+		return true;
+	}
+
+	void TextLayoutCache::SetFittedSize(FontAsset* asset, std::string_view text, const TextFitParams& params, float size) {
+		if (!asset)
+			return;
+
+		// only called after GetFittedSize missed, the entry is always built
+		m_fittedSizes.Get(asset->GetID(), text, params,
+			[size](FittedSize& out) { out.size = size; });
+	}
+
+	void TextLayoutCache::EvictOld(uint64_t currentFrame) {
+		if (currentFrame - m_lastEvictFrame < EVICT_INTERVAL_FRAMES)
+			return;
+		m_lastEvictFrame = currentFrame;
+
+		m_layouts.EvictOld(currentFrame);
+		m_widthTables.EvictOld(currentFrame);
+		m_fittedSizes.EvictOld(currentFrame);
+	}
+
+	void TextLayoutCache::Clear() {
+		m_layouts.Clear();
+		m_widthTables.Clear();
+		m_fittedSizes.Clear();
+	}
+
+	size_t TextLayoutCache::GetEntryCount() const {
+		return m_layouts.hashToEntry.size() + m_widthTables.hashToEntry.size() + m_fittedSizes.hashToEntry.size();
+	}
+
+}
@@ -0,0 +1,115 @@
+#include <algorithm>
+
+#include "Types/Vertex.h"
+#include "Internal/VertexConverter.h"
+
+namespace SDLCore::VertexConverter {
+
+	// both types are 8 floats: position (2), color (4), texture coordinate (2)
+	static constexpr bool SAME_LAYOUT = sizeof(Vertex) == sizeof(SDL_Vertex) && sizeof(SDL_Vertex) == sizeof(float) * 8;
+
+	static inline float Clamp255(float value) {
+		return std::min(std::max(value, 0.0f), 255.0f);
+	}
+
+	static void ConvertScalar(SDL_Vertex* dst,
+		const Vertex* src,
+		size_t count,
+		float xOffset,
+		float yOffset,
+		float xScale,
+		float yScale,
+		const SDL_FColor* overrideColor)
+	{
+		constexpr float INV_255 = 1.0f / 255.0f;
+		for (size_t i = 0; i < count; i++) {
+			const Vertex& v = src[i];
+			SDL_Vertex& out = dst[i];
+			out.position.x = xOffset + v.position.x * xScale;
+			out.position.y = yOffset + v.position.y * yScale;
+			if (overrideColor) {
+				out.color = *overrideColor;
+			}
+			else {
+				out.color.r = Clamp255(v.color.x) * INV_255;
+				out.color.g = Clamp255(v.color.y) * INV_255;
+				out.color.b = Clamp255(v.color.z) * INV_255;
+				out.color.a = Clamp255(v.color.w) * INV_255;
+			}
+			out.tex_coord.x = v.texCoordinate.x;
+			out.tex_coord.y = v.texCoordinate.y;
+		}
+	}
+
+#ifdef SDL_SSE2_INTRINSICS
+	/*
+	* Each vertex is processed as two 4 float lanes:
+	* lo = (pos.x, pos.y, col.r, col.g), hi = (col.b, col.a, tex.u, tex.v)
+	*/
+	static void ConvertSSE2(SDL_Vertex* dst,
+		const Vertex* src,
+		size_t count,
+		float xOffset,
+		float yOffset,
+		float xScale,
+		float yScale,
+		const SDL_FColor* overrideColor)
+	{
+		constexpr float INV_255 = 1.0f / 255.0f;
+		constexpr float MAX = 3.402823466e+38f;
+
+		const __m128 loMul = _mm_setr_ps(xScale, yScale, INV_255, INV_255);
+		const __m128 loAdd = _mm_setr_ps(xOffset, yOffset, 0.0f, 0.0f);
+		const __m128 loMin = _mm_setr_ps(-MAX, -MAX, 0.0f, 0.0f);
+		const __m128 loMax = _mm_setr_ps(MAX, MAX, 255.0f, 255.0f);
+		const __m128 hiMul = _mm_setr_ps(INV_255, INV_255, 1.0f, 1.0f);
+		const __m128 hiMin = _mm_setr_ps(0.0f, 0.0f, -MAX, -MAX);
+		const __m128 hiMax = _mm_setr_ps(255.0f, 255.0f, MAX, MAX);
+
+		const float* in = reinterpret_cast<const float*>(src);
+		float* out = reinterpret_cast<float*>(dst);
+
+		for (size_t i = 0; i < count; i++, in += 8, out += 8) {
+			__m128 lo = _mm_loadu_ps(in);
+			__m128 hi = _mm_loadu_ps(in + 4);
+
+			// clamps only the color lanes, positions and texture coordinates keep their value
+			lo = _mm_min_ps(_mm_max_ps(lo, loMin), loMax);
+			hi = _mm_min_ps(_mm_max_ps(hi, hiMin), hiMax);
+
+			lo = _mm_add_ps(_mm_mul_ps(lo, loMul), loAdd);
+			hi = _mm_mul_ps(hi, hiMul);
+
+			_mm_storeu_ps(out, lo);
+			_mm_storeu_ps(out + 4, hi);
+		}
+
+		if (overrideColor) {
+			for (size_t i = 0; i < count; i++)
+				dst[i].color = *overrideColor;
+		}
+	}
+#endif
+
+	void Convert(SDL_Vertex* dst,
+		const Vertex* src,
+		size_t count,
+		float xOffset,
+		float yOffset,
+		float xScale,
+		float yScale,
+		const SDL_FColor* overrideColor)
+	{
+		if (!dst || !src || count == 0)
+			return;
+
+#ifdef SDL_SSE2_INTRINSICS
+		if constexpr (SAME_LAYOUT) {
+			ConvertSSE2(dst, src, count, xOffset, yOffset, xScale, yScale, overrideColor);
+			return;
+		}
+#endif
+		ConvertScalar(dst, src, count, xOffset, yOffset, xScale, yScale, overrideColor);
+	}
+
+}
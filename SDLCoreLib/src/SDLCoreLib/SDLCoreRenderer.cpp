@@ -1,13 +1,22 @@
 ﻿#include <vector>
 #include <cmath>
+#include <algorithm>
 #include <unordered_map>
 
 #include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
 #include <CoreLib/Log.h>
 
 #include "SDLCoreTime.h"
 #include "Application.h"
 #include "types/Vertex.h"
+#include "types/TextureAtlas.h"
+#include "types/Mesh.h"
+#include "Internal/RenderBatch.h"
+#include "Internal/RenderStateCache.h"
+#include "Internal/LayerRegistry.h"
+#include "Internal/VertexConverter.h"
+#include "Internal/TextLayout.h"
 #include "SDLCoreRenderer.h"
 
 namespace SDLCore::Render {
@@ -37,8 +46,7 @@ namespace SDLCore::Render {
     };
 
     struct CachedText {
-        std::vector<std::string> lines;
-        std::vector<float> lineWidths;
+        size_t lineCount = 0;
 
         float blockWidth = 0.0f;
         float blockHeight = 0.0f;
@@ -47,8 +55,15 @@ namespace SDLCore::Render {
         bool firstCall = true;
         SDL_Color color{ 255, 255, 255, 255 };
         SDL_Texture* preRenderedTexture = nullptr;
+        size_t textureBytes = 0;
 
         uint64_t lastUseFrame = 0;
+        bool pinned = false;
+
+        // intrusive LRU list, head = most recently used. Pinned entries are not linked
+        const TextCacheKey* key = nullptr;
+        CachedText* lruPrev = nullptr;
+        CachedText* lruNext = nullptr;
     };
 
     static inline void hashCombine(std::size_t& seed, std::size_t value) noexcept {
@@ -85,6 +100,22 @@ namespace SDLCore::Render {
         float s_strokeWidth = 1;
         bool s_innerStroke = true;
         bool s_isClipRectEnabled = false;
+        LineJoin s_lineJoin = LineJoin::MITER;
+        LineCap s_lineCap = LineCap::BUTT;
+        constexpr float MITER_LIMIT = 4.0f;// max miter length relative to the half stroke width
+
+        struct StrokeSegment {
+            SDL_FPoint dir;
+            SDL_FPoint normal;
+            float length;
+        };
+
+        // scratch buffers reused by Polyline/LineList
+        std::vector<SDL_FPoint> s_strokePoints;
+        std::vector<StrokeSegment> s_strokeSegments;
+        std::vector<SDL_FPoint> s_strokeSegmentEnds;
+        std::vector<SDL_Vertex> s_strokeVertices;
+        std::vector<int> s_strokeIndices;
 
         // ========== Text ==========
         SDLCore::Font s_font(true);// loads the default font
@@ -106,22 +137,109 @@ namespace SDLCore::Render {
         constexpr uint64_t TEXT_CACHE_TTL_FRAMES = 600; // ~10 sec
 
         std::unordered_map<TextCacheKey, CachedText, TextCacheKeyHash> s_textCache;
+        CachedText* s_textCacheHead = nullptr;
+        CachedText* s_textCacheTail = nullptr;
+        size_t s_textCacheBytes = 0;
+        size_t s_textCacheBudgetBytes = 64 * 1024 * 1024;// 0 = no limit
+        size_t s_textCachePinnedCount = 0;
+        uint64_t s_textCacheHits = 0;
+        uint64_t s_textCacheMisses = 0;
+        uint64_t s_textCacheEvictions = 0;
         std::unordered_map<WindowID, WindowCallbackID> s_onRendererDestroyCallbacks;
 
+        // scratch buffers reused by every uncached text draw call, one per glyph atlas page
+        struct GlyphGeometry {
+            std::vector<SDL_Vertex> vertices;
+            std::vector<int> indices;
+        };
+        std::vector<GlyphGeometry> s_glyphGeometry;
+
+        // memoized line breaking and glyph positions, shared by measuring and drawing
+        TextLayoutCache s_textLayouts;
+        std::string s_truncatedText;// scratch buffer of Text, keeps its capacity
+        TextLayout s_fitLayout;// scratch layout of CalculateTextSizeForBounds
+
+        // shadow state of every window renderer
+        std::unordered_map<WindowID, RenderStateCache> s_renderStates;
+
+        // ========== Batching ==========
+        bool s_batchingEnabled = false;
+        std::unordered_map<WindowID, RenderBatch> s_renderBatches;
+
+        // ========== Culling ==========
+        bool s_cullingEnabled = false;
+        bool s_cullBoundsValid = false;
+        SDL_FRect s_cullBounds{ 0, 0, 0, 0 };// visible area in render coordinates (min x/y, max x/y)
+        constexpr float CULL_MARGIN = 1.0f;// keeps primitives that only touch the edge (AA, pixel snapping)
+        size_t s_culledDraws = 0;
+        size_t s_cullSubmittedDraws = 0;
+        std::unordered_map<WindowID, CullStats> s_lastCullStats;
+
+    }
+
+    static inline void UnlinkCachedText(CachedText& ct) {
+        if (ct.lruPrev)
+            ct.lruPrev->lruNext = ct.lruNext;
+        else if (s_textCacheHead == &ct)
+            s_textCacheHead = ct.lruNext;
+
+        if (ct.lruNext)
+            ct.lruNext->lruPrev = ct.lruPrev;
+        else if (s_textCacheTail == &ct)
+            s_textCacheTail = ct.lruPrev;
+
+        ct.lruPrev = nullptr;
+        ct.lruNext = nullptr;
+    }
+
+    static inline void PushFrontCachedText(CachedText& ct) {
+        ct.lruPrev = nullptr;
+        ct.lruNext = s_textCacheHead;
+        if (s_textCacheHead)
+            s_textCacheHead->lruPrev = &ct;
+        s_textCacheHead = &ct;
+        if (!s_textCacheTail)
+            s_textCacheTail = &ct;
+    }
+
+    static inline void DestroyCachedTextTexture(CachedText& ct) {
+        if (ct.preRenderedTexture) {
+            SDL_DestroyTexture(ct.preRenderedTexture);
+            ct.preRenderedTexture = nullptr;
+        }
+        s_textCacheBytes -= ct.textureBytes;
+        ct.textureBytes = 0;
+    }
+
+    // removes the entry from the LRU list and the cache, frees its texture
+    static inline void EraseCachedText(CachedText& ct) {
+        DestroyCachedTextTexture(ct);
+        if (ct.pinned)
+            s_textCachePinnedCount--;
+        else
+            UnlinkCachedText(ct);
+
+        // copy the key, the stored key is destroyed by the erase
+        TextCacheKey key = *ct.key;
+        s_textCache.erase(key);
+    }
+
+    // evicts least recently used entries until the texture memory fits into the budget
+    static inline void EnforceTextCacheBudget(const CachedText* keep = nullptr) {
+        if (s_textCacheBudgetBytes == 0)
+            return;
+
+        while (s_textCacheBytes > s_textCacheBudgetBytes && s_textCacheTail && s_textCacheTail != keep) {
+            EraseCachedText(*s_textCacheTail);
+            s_textCacheEvictions++;
+        }
     }
 
     static inline void EvictOldTextCache(uint64_t currentFrame) {
-        for (auto it = s_textCache.begin(); it != s_textCache.end(); ) {
-            if (currentFrame - it->second.lastUseFrame > TEXT_CACHE_TTL_FRAMES) {
-                if (it->second.preRenderedTexture) {
-                    SDL_DestroyTexture(it->second.preRenderedTexture);
-                    it->second.preRenderedTexture = nullptr;
-                }
-                it = s_textCache.erase(it);
-            }
-            else {
-                ++it;
-            }
+        // the tail is always the entry with the oldest lastUseFrame
+        while (s_textCacheTail && currentFrame - s_textCacheTail->lastUseFrame > TEXT_CACHE_TTL_FRAMES) {
+            EraseCachedText(*s_textCacheTail);
+            s_textCacheEvictions++;
         }
     }
 
@@ -131,10 +249,12 @@ namespace SDLCore::Render {
 
         for (auto it = s_textCache.begin(); it != s_textCache.end(); ) {
             if (it->first.renderer == renderer) {
-                if (it->second.preRenderedTexture) {
-                    SDL_DestroyTexture(it->second.preRenderedTexture);
-                    it->second.preRenderedTexture = nullptr;
-                }
+                CachedText& ct = it->second;
+                DestroyCachedTextTexture(ct);
+                if (ct.pinned)
+                    s_textCachePinnedCount--;
+                else
+                    UnlinkCachedText(ct);
                 it = s_textCache.erase(it);
             }
             else {
@@ -150,6 +270,95 @@ namespace SDLCore::Render {
     WindowID GetActiveWindowID() {
         return s_winID;
     }
+
+    // only valid while a renderer is active
+    static inline RenderStateCache& GetActiveRenderState() {
+        return s_renderStates[s_winID];
+    }
+
+    static inline void InvalidateCullBounds() {
+        s_cullBoundsValid = false;
+    }
+
+    void InvalidateActiveRenderState() {
+        InvalidateCullBounds();
+        if (!s_renderer)
+            return;
+        GetActiveRenderState().Invalidate();
+    }
+
+    /*
+    * @brief Reads the visible area of the active target once, until viewport, clip rect, scale or target change.
+    * Draw coordinates are relative to the viewport. SDL returns the viewport size in render coordinates,
+    * so the render scale (and logical presentation) is already applied.
+    */
+    static void UpdateCullBounds() {
+        SDL_Rect viewport{ 0, 0, 0, 0 };
+        SDL_GetRenderViewport(s_renderer, &viewport);
+
+        float minX = 0.0f;
+        float minY = 0.0f;
+        float maxX = static_cast<float>(viewport.w);
+        float maxY = static_cast<float>(viewport.h);
+
+        if (SDL_RenderClipEnabled(s_renderer)) {
+            SDL_Rect clip{ 0, 0, 0, 0 };
+            if (SDL_GetRenderClipRect(s_renderer, &clip)) {
+                minX = std::max(minX, static_cast<float>(clip.x));
+                minY = std::max(minY, static_cast<float>(clip.y));
+                maxX = std::min(maxX, static_cast<float>(clip.x + clip.w));
+                maxY = std::min(maxY, static_cast<float>(clip.y + clip.h));
+            }
+        }
+
+        s_cullBounds = SDL_FRect{ minX - CULL_MARGIN, minY - CULL_MARGIN, maxX + CULL_MARGIN, maxY + CULL_MARGIN };
+        s_cullBoundsValid = true;
+    }
+
+    // AABB test without counting, the bounds have to be valid
+    static inline bool IsOutsideCullBounds(float minX, float minY, float maxX, float maxY) {
+        return maxX < s_cullBounds.x || maxY < s_cullBounds.y ||
+            minX > s_cullBounds.w || minY > s_cullBounds.h;
+    }
+
+    static inline bool CountCullResult(bool culled) {
+        if (culled)
+            s_culledDraws++;
+        else
+            s_cullSubmittedDraws++;
+        return culled;
+    }
+
+    bool IsCulled(float minX, float minY, float maxX, float maxY) {
+        if (!s_cullingEnabled || !s_renderer)
+            return false;
+
+        if (!s_cullBoundsValid)
+            UpdateCullBounds();
+
+        return CountCullResult(IsOutsideCullBounds(minX, minY, maxX, maxY));
+    }
+
+    // culls a rect that can have a negative size, expanded by margin on every side
+    static inline bool IsRectCulled(float x, float y, float w, float h, float margin = 0.0f) {
+        if (!s_cullingEnabled)
+            return false;
+        return IsCulled(std::min(x, x + w) - margin, std::min(y, y + h) - margin,
+            std::max(x, x + w) + margin, std::max(y, y + h) + margin);
+    }
+
+    RenderBatch* GetActiveRenderBatch() {
+        if (!s_batchingEnabled || !s_renderer || s_winID.value == SDLCORE_INVALID_ID)
+            return nullptr;
+        return &s_renderBatches[s_winID];
+    }
+
+    // color the renderer would use for an untextured draw call, in the range 0-1
+    static inline SDL_FColor GetDrawColorF(SDL_Renderer* renderer) {
+        SDL_FColor color{ 1.0f, 1.0f, 1.0f, 1.0f };
+        SDL_GetRenderDrawColorFloat(renderer, &color.r, &color.g, &color.b, &color.a);
+        return color;
+    }
     
     static void ConvertVertices(SDL_Vertex* dst,
         const Vertex* src,
@@ -160,26 +369,17 @@ namespace SDLCore::Render {
         float yScale,
         bool setColor)
     {
-        for (size_t i = 0; i < count; i++) {
-            SDL_Vertex v = static_cast<SDL_Vertex>(src[i]);
-            v.position.x = xOffset + v.position.x * xScale;
-            v.position.y = yOffset + v.position.y * yScale;
-
-            if (setColor) {
-                v.color = SDL_FColor{
-                    s_activeColor.r / 255.0f,
-                    s_activeColor.g / 255.0f,
-                    s_activeColor.b / 255.0f,
-                    s_activeColor.a / 255.0f
-                };
-            }
-            else {
-                v.color.r /= 255.0f;
-                v.color.g /= 255.0f;
-                v.color.b /= 255.0f;
-                v.color.a /= 255.0f;
-            }
-            dst[i] = v;
+        if (setColor) {
+            SDL_FColor color{
+                s_activeColor.r / 255.0f,
+                s_activeColor.g / 255.0f,
+                s_activeColor.b / 255.0f,
+                s_activeColor.a / 255.0f
+            };
+            VertexConverter::Convert(dst, src, count, xOffset, yOffset, xScale, yScale, &color);
+        }
+        else {
+            VertexConverter::Convert(dst, src, count, xOffset, yOffset, xScale, yScale);
         }
     }
 
@@ -232,40 +432,100 @@ namespace SDLCore::Render {
                         }
                     }
 
+                    s_renderBatches.erase(winID);
+                    s_renderStates.erase(winID);
+                    s_lastCullStats.erase(winID);
                     s_onRendererDestroyCallbacks.erase(winID);
                 });
 
             s_onRendererDestroyCallbacks[winID] = *idPtr;
             win->AddOnDestroy([winID]() {
+                s_renderBatches.erase(winID);
+                s_renderStates.erase(winID);
+                s_lastCullStats.erase(winID);
                 s_onRendererDestroyCallbacks.erase(winID);
             });
         }
         s_renderer = rendererPtr;
+        InvalidateCullBounds();
     }
 
     void Clear() {
         auto renderer = GetActiveRenderer();
         if (!renderer)
             return;
+        FlushBatch();
+        InvalidateCullBounds();
         if (!SDL_RenderClear(renderer)) {
             Log::Error("SDLCore::Renderer::Clear: Failed to clear renderer: {}", SDL_GetError());
+            return;
         }
+
+        // background layers are drawn before the first draw to the window, after they were recorded this frame
+        if (!SDL_GetRenderTarget(renderer))
+            RequestBackgroundComposite();
     }
 
     void Present() {
         EvictOldTextCache(Time::GetFrameCount());
+        s_textLayouts.EvictOld(Time::GetFrameCount());
         auto renderer = GetActiveRenderer();
         if (!renderer)
             return;
+
+        FlushBatch();
+        if (!SDL_GetRenderTarget(renderer)) {
+            CompositePendingBackground();
+            CompositeLayers(false);
+        }
+
+        if (RenderBatch* batch = GetActiveRenderBatch()) {
+            FlushBatch();
+            batch->EndFrame();
+        }
+
+        // the window size can change until the next frame
+        InvalidateCullBounds();
+        if (s_cullingEnabled)
+            s_lastCullStats[s_winID] = CullStats{ s_culledDraws, s_cullSubmittedDraws };
+        s_culledDraws = 0;
+        s_cullSubmittedDraws = 0;
+
         if (!SDL_RenderPresent(renderer)) {
             Log::Error("SDLCore::Renderer::Present: Failed to Present: {}", SDL_GetError());
         }
     }
 
+    bool SaveFrame(const SystemFilePath& path) {
+        auto renderer = GetActiveRenderer();
+        if (!renderer) {
+            SetError("SDLCore::Renderer::SaveFrame: No active renderer!");
+            return false;
+        }
+
+        FlushBatch();
+        SDL_Surface* surface = SDL_RenderReadPixels(renderer, nullptr);
+        if (!surface) {
+            SetErrorF("SDLCore::Renderer::SaveFrame: Failed to read pixels: {}", SDL_GetError());
+            return false;
+        }
+
+        std::string file = path.string();
+        bool result = IMG_SavePNG(surface, file.c_str());
+        if (!result) {
+            SetErrorF("SDLCore::Renderer::SaveFrame: Failed to save '{}': {}", file, SDL_GetError());
+        }
+
+        SDL_DestroySurface(surface);
+        return result;
+    }
+
     void SetRenderScale(float scaleX, float scaleY) {
         auto renderer = GetActiveRenderer();
         if (!renderer)
             return;
+        FlushBatch();
+        InvalidateCullBounds();
         if (!SDL_SetRenderScale(renderer,scaleX, scaleY)) {
             Log::Error("SDLCore::Renderer::SetRenderScale: Failed to SetRenderScale: {}", SDL_GetError());
         }
@@ -290,6 +550,58 @@ namespace SDLCore::Render {
         return scale;
     }
 
+    void SetBatchingEnabled(bool value) {
+        if (!value)
+            FlushBatch();
+        s_batchingEnabled = value;
+    }
+
+    bool IsBatchingEnabled() {
+        return s_batchingEnabled;
+    }
+
+    void FlushBatch() {
+        RenderBatch* batch = GetActiveRenderBatch();
+        if (!batch || batch->IsEmpty())
+            return;
+
+        if (!batch->Flush(s_renderer)) {
+            Log::Error("SDLCore::Renderer::FlushBatch: Failed to flush batch: {}", GetError());
+        }
+    }
+
+    BatchStats GetBatchStats() {
+        BatchStats stats;
+        RenderBatch* batch = GetActiveRenderBatch();
+        if (!batch)
+            return stats;
+
+        stats.recordedDraws = batch->GetLastFrameRecordedDraws();
+        stats.submittedDraws = batch->GetLastFrameSubmittedDraws();
+        stats.savedSubmissions = (stats.recordedDraws > stats.submittedDraws)
+            ? stats.recordedDraws - stats.submittedDraws
+            : 0;
+        return stats;
+    }
+
+    void SetCullingEnabled(bool value) {
+        s_cullingEnabled = value;
+        InvalidateCullBounds();
+        s_culledDraws = 0;
+        s_cullSubmittedDraws = 0;
+    }
+
+    bool IsCullingEnabled() {
+        return s_cullingEnabled;
+    }
+
+    CullStats GetCullStats() {
+        auto it = s_lastCullStats.find(s_winID);
+        if (it == s_lastCullStats.end())
+            return CullStats{};
+        return it->second;
+    }
+
     SDLCore::Rect GetViewport() {
         SDL_Rect viewport{ 0, 0, 0, 0 };
         auto renderer = GetActiveRenderer();
@@ -308,7 +620,15 @@ namespace SDLCore::Render {
             return;
 
         SDL_Rect viewport{ x, y, w, h };
-        if (!SDL_SetRenderViewport(renderer, &viewport)) {
+        RenderStateCache& state = GetActiveRenderState();
+        if (!state.IsViewportDifferent(&viewport)) {
+            RenderStateCache::CountSkipped();
+            return;
+        }
+
+        FlushBatch();
+        InvalidateCullBounds();
+        if (!state.SetViewport(renderer, &viewport)) {
             Log::Error("SDLCore::Renderer::SetViewport: Failed to set viewport ({}, {}, {}, {}): {}",
                 x, y, w, h, SDL_GetError());
         }
@@ -341,7 +661,15 @@ namespace SDLCore::Render {
         if (!renderer)
             return;
 
-        if (!SDL_SetRenderViewport(renderer, nullptr)) {
+        RenderStateCache& state = GetActiveRenderState();
+        if (!state.IsViewportDifferent(nullptr)) {
+            RenderStateCache::CountSkipped();
+            return;
+        }
+
+        FlushBatch();
+        InvalidateCullBounds();
+        if (!state.SetViewport(renderer, nullptr)) {
             Log::Error("SDLCore::Renderer::ResetViewport: Failed to reset viewport: {}", SDL_GetError());
         }
     }
@@ -368,8 +696,9 @@ namespace SDLCore::Render {
             return;
 
         s_isClipRectEnabled = true;
+        InvalidateCullBounds();
         SDL_Rect clipRect{ x, y, w, h };
-        if (!SDL_SetRenderClipRect(renderer, &clipRect)) {
+        if (!GetActiveRenderState().SetClipRect(renderer, &clipRect)) {
             Log::Error("SDLCore::Renderer::SetClipRect: Failed to set clipRect ({}, {}, {}, {}): {}",
                 x, y, w, h, SDL_GetError());
         }
@@ -403,7 +732,8 @@ namespace SDLCore::Render {
             return;
 
         s_isClipRectEnabled = false;
-        if (!SDL_SetRenderClipRect(renderer, nullptr)) {
+        InvalidateCullBounds();
+        if (!GetActiveRenderState().SetClipRect(renderer, nullptr)) {
             Log::Error("SDLCore::Renderer::ResetClipRect: Failed to reset clipRect: {}", SDL_GetError());
         }
     }
@@ -414,7 +744,7 @@ namespace SDLCore::Render {
             return;
 
         SDL_BlendMode mode = enabled ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE;
-        if (!SDL_SetRenderDrawBlendMode(renderer, mode)) {
+        if (!GetActiveRenderState().SetDrawBlendMode(renderer, mode)) {
             Log::Error("SDLCore::Renderer::SetBlendMode: Failed to set blend mode {}: {}",
                 enabled ? "BLEND" : "NONE", SDL_GetError());
         }
@@ -424,11 +754,22 @@ namespace SDLCore::Render {
         auto renderer = GetActiveRenderer();
         if (!renderer)
             return;
-        if (!SDL_SetRenderDrawBlendMode(renderer, static_cast<SDL_BlendMode>(mode))) {
+        if (!GetActiveRenderState().SetDrawBlendMode(renderer, static_cast<SDL_BlendMode>(mode))) {
             Log::Error("SDLCore::Renderer::SetBlendMode: Failed to set blend mode {}: {}", static_cast<int>(mode), SDL_GetError());
         }
     }
 
+    RenderStateStats GetRenderStateStats() {
+        RenderStateStats stats;
+        stats.issuedCalls = RenderStateCache::GetIssuedCalls();
+        stats.skippedCalls = RenderStateCache::GetSkippedCalls();
+        return stats;
+    }
+
+    void ResetRenderStateStats() {
+        RenderStateCache::ResetCounters();
+    }
+
     #pragma region Color
 
     Vector4 GetActiveColor() {
@@ -440,7 +781,7 @@ namespace SDLCore::Render {
         if (!renderer)
             return;
         s_activeColor = { r, g, b, a};
-        if (!SDL_SetRenderDrawColor(renderer, r, g, b, a)) {
+        if (!GetActiveRenderState().SetDrawColor(renderer, s_activeColor)) {
             Log::Error("SDLCore::Renderer::SetColor: Failed to set color ({}, {}, {}, {}): {}", r, g, b, a, SDL_GetError());
         }
     }
@@ -481,6 +822,14 @@ namespace SDLCore::Render {
         s_innerStroke = value;
     }
 
+    void SetLineJoin(LineJoin join) {
+        s_lineJoin = join;
+    }
+
+    void SetLineCap(LineCap cap) {
+        s_lineCap = cap;
+    }
+
     #pragma region Primitives
 
     #pragma region Rectangle
@@ -489,8 +838,17 @@ namespace SDLCore::Render {
         auto renderer = GetActiveRenderer();
         if (!renderer)
             return;
+        CompositePendingBackground();
+
+        if (IsRectCulled(x, y, w, h))
+            return;
 
         SDL_FRect rect{ x, y, w, h };
+        if (RenderBatch* batch = GetActiveRenderBatch()) {
+            batch->AddRect(renderer, rect, GetDrawColorF(renderer));
+            return;
+        }
+
         if (!SDL_RenderFillRect(renderer, &rect)) {
             Log::Error("SDLCore::Renderer::FillRect: Failed to fill rect ({}, {}, {}, {}): {}", x, y, w, h, SDL_GetError());
         }
@@ -516,11 +874,26 @@ namespace SDLCore::Render {
         auto renderer = GetActiveRenderer();
         if (!renderer || count == 0)
             return;
+        CompositePendingBackground();
+
+        if (RenderBatch* batch = GetActiveRenderBatch()) {
+            SDL_FColor color = GetDrawColorF(renderer);
+            for (size_t i = 0; i < count; i++) {
+                const Vector4& trans = transforms[i];
+                if (IsRectCulled(trans.x, trans.y, trans.z, trans.w))
+                    continue;
+                batch->AddRect(renderer, SDL_FRect{ trans.x, trans.y, trans.z, trans.w }, color);
+            }
+            return;
+        }
 
-        std::vector<SDL_FRect> rects(count);
+        std::vector<SDL_FRect> rects;
+        rects.reserve(count);
         for (size_t i = 0; i < count; i++) {
             const Vector4& trans = transforms[i];
-            rects[i] = SDL_FRect{ trans.x, trans.y, trans.z, trans.w };
+            if (IsRectCulled(trans.x, trans.y, trans.z, trans.w))
+                continue;
+            rects.push_back(SDL_FRect{ trans.x, trans.y, trans.z, trans.w });
         }
 
         if (!rects.empty()) {
@@ -538,8 +911,13 @@ namespace SDLCore::Render {
         auto renderer = GetActiveRenderer();
         if (!renderer)
             return;
+        CompositePendingBackground();
+
+        if (IsRectCulled(x, y, w, h, (s_innerStroke) ? 0.0f : s_strokeWidth))
+            return;
 
         if (s_strokeWidth == 1) {
+            FlushBatch();
             SDL_FRect rect{ x, y, w, h };
             if (!SDL_RenderRect(renderer, &rect)) {
                 Log::Error("SDLCore::Renderer::Rect: Failed to draw rect ({}, {}, {}, {}): {}",
@@ -567,6 +945,13 @@ namespace SDLCore::Render {
             rects[3] = { x + w, y - s, s, h + s * 2 };  // right
         }
 
+        if (RenderBatch* batch = GetActiveRenderBatch()) {
+            SDL_FColor color = GetDrawColorF(renderer);
+            for (auto& rect : rects)
+                batch->AddRect(renderer, rect, color);
+            return;
+        }
+
         for (auto& rect : rects) {
             if (!SDL_RenderFillRect(renderer, &rect)) {
                 Log::Error("SDLCore::Renderer::Rect: Failed to draw rect ({}, {}, {}, {}): {}",
@@ -596,13 +981,17 @@ namespace SDLCore::Render {
         auto renderer = GetActiveRenderer();
         if (!renderer || count == 0)
             return;
+        CompositePendingBackground();
 
         float s = s_strokeWidth;
         std::vector<SDL_FRect> rects;
         rects.reserve((s_strokeWidth != 1) ? count * 4 : count);
 
+        float cullMargin = (s_innerStroke || s_strokeWidth == 1) ? 0.0f : s_strokeWidth;
         for (size_t i = 0; i < count; i++) {
             const Vector4& t = transforms[i];
+            if (IsRectCulled(t.x, t.y, t.z, t.w, cullMargin))
+                continue;
 
             if (s_strokeWidth == 1) {
                 rects.push_back({ t.x, t.y, t.z, t.w });
@@ -627,6 +1016,15 @@ namespace SDLCore::Render {
         }
 
         if (!rects.empty()) {
+            RenderBatch* batch = GetActiveRenderBatch();
+            if (batch && s_strokeWidth != 1) {
+                SDL_FColor color = GetDrawColorF(renderer);
+                for (auto& rect : rects)
+                    batch->AddRect(renderer, rect, color);
+                return;
+            }
+
+            FlushBatch();
             bool result = true;
             if (s_strokeWidth == 1)
                 result = SDL_RenderRects(renderer, rects.data(), static_cast<int>(rects.size()));
@@ -650,8 +1048,17 @@ namespace SDLCore::Render {
         auto renderer = GetActiveRenderer();
         if (!renderer)
             return;
+        CompositePendingBackground();
+
+        if (s_cullingEnabled) {
+            float halfStroke = std::max(s_strokeWidth, 1.0f) / 2.0f;
+            if (IsCulled(std::min(x1, x2) - halfStroke, std::min(y1, y2) - halfStroke,
+                std::max(x1, x2) + halfStroke, std::max(y1, y2) + halfStroke))
+                return;
+        }
 
         if (s_strokeWidth <= 1) {
+            FlushBatch();
             SDL_RenderLine(renderer, x1, y1, x2, y2);
             return;
         }
@@ -689,6 +1096,11 @@ namespace SDLCore::Render {
         }
 
         int indices[6] = { 0, 1, 2, 2, 3, 0 };
+        if (RenderBatch* batch = GetActiveRenderBatch()) {
+            batch->AddGeometry(renderer, nullptr, quad, 4, indices, 6);
+            return;
+        }
+
         if (!SDL_RenderGeometry(renderer, nullptr, quad, 4, indices, 6)) {
             Log::Error("SDLCore::Renderer::Line: Failed to draw thick line ({}, {}, {}, {}): {}", x1, y1, x2, y2, SDL_GetError());
         }
@@ -710,13 +1122,371 @@ namespace SDLCore::Render {
         Line(poins.x, poins.y, poins.z, poins.w);
     }
 
+    static inline int PushStrokeVertex(float x, float y, const SDL_FColor& color) {
+        s_strokeVertices.push_back(SDL_Vertex{ { x, y }, color, { 0.0f, 0.0f } });
+        return static_cast<int>(s_strokeVertices.size()) - 1;
+    }
+
+    static inline void PushStrokeTriangle(int a, int b, int c) {
+        s_strokeIndices.push_back(a);
+        s_strokeIndices.push_back(b);
+        s_strokeIndices.push_back(c);
+    }
+
+    /*
+    * Adds a triangle fan around center along the arc of radius r from angle a0 to a0 + sweep.
+    * The fan origin can differ from the arc center (used for round joins with an inner miter point).
+    */
+    static void PushStrokeArc(SDL_FPoint origin, SDL_FPoint center, float r, float a0, float sweep, const SDL_FColor& color) {
+        // segment count so the chord error stays below ~0.25px
+        float step = (r > 0.25f) ? 2.0f * std::acos(1.0f - 0.25f / r) : SDL_PI_F;
+        int steps = std::max(1, static_cast<int>(std::ceil(std::fabs(sweep) / step)));
+
+        int originIdx = PushStrokeVertex(origin.x, origin.y, color);
+        int prev = PushStrokeVertex(center.x + std::cos(a0) * r, center.y + std::sin(a0) * r, color);
+        for (int i = 1; i <= steps; i++) {
+            float a = a0 + sweep * (static_cast<float>(i) / steps);
+            int cur = PushStrokeVertex(center.x + std::cos(a) * r, center.y + std::sin(a) * r, color);
+            PushStrokeTriangle(originIdx, prev, cur);
+            prev = cur;
+        }
+    }
+
+    /*
+    * Tessellates a polyline into the stroke scratch buffers.
+    * points must not contain consecutive duplicates.
+    */
+    static void TessellatePolyline(const SDL_FPoint* pts, size_t count, bool closed, const SDL_FColor& color) {
+        if (count < 2)
+            return;
+        if (count == 2)
+            closed = false;
+
+        const float hw = s_strokeWidth * 0.5f;
+        const size_t segCount = (closed) ? count : count - 1;
+
+        // direction, normal and length of every segment
+        s_strokeSegments.resize(segCount);
+        for (size_t i = 0; i < segCount; i++) {
+            const SDL_FPoint& a = pts[i];
+            const SDL_FPoint& b = pts[(i + 1) % count];
+            float dx = b.x - a.x;
+            float dy = b.y - a.y;
+            float len = std::sqrt(dx * dx + dy * dy);
+            dx /= len;
+            dy /= len;
+            s_strokeSegments[i] = StrokeSegment{ { dx, dy }, { -dy, dx }, len };
+        }
+
+        // left (+normal) and right (-normal) end points of every segment
+        s_strokeSegmentEnds.resize(segCount * 4);
+        auto startL = [](size_t i) -> SDL_FPoint& { return s_strokeSegmentEnds[i * 4 + 0]; };
+        auto startR = [](size_t i) -> SDL_FPoint& { return s_strokeSegmentEnds[i * 4 + 1]; };
+        auto endL = [](size_t i) -> SDL_FPoint& { return s_strokeSegmentEnds[i * 4 + 2]; };
+        auto endR = [](size_t i) -> SDL_FPoint& { return s_strokeSegmentEnds[i * 4 + 3]; };
+
+        for (size_t i = 0; i < segCount; i++) {
+            const SDL_FPoint& a = pts[i];
+            const SDL_FPoint& b = pts[(i + 1) % count];
+            const SDL_FPoint& n = s_strokeSegments[i].normal;
+            startL(i) = { a.x + n.x * hw, a.y + n.y * hw };
+            startR(i) = { a.x - n.x * hw, a.y - n.y * hw };
+            endL(i) = { b.x + n.x * hw, b.y + n.y * hw };
+            endR(i) = { b.x - n.x * hw, b.y - n.y * hw };
+        }
+
+        // joins, they move the segment ends and add the corner geometry
+        size_t firstJoint = (closed) ? 0 : 1;
+        size_t lastJoint = (closed) ? count : count - 1;
+        for (size_t j = firstJoint; j < lastJoint; j++) {
+            size_t inSeg = (j == 0) ? segCount - 1 : j - 1;
+            size_t outSeg = j % segCount;
+            const StrokeSegment& s0 = s_strokeSegments[inSeg];
+            const StrokeSegment& s1 = s_strokeSegments[outSeg];
+            const SDL_FPoint p = pts[j];
+
+            float cross = s0.dir.x * s1.dir.y - s0.dir.y * s1.dir.x;
+            float dot = s0.dir.x * s1.dir.x + s0.dir.y * s1.dir.y;
+            if (std::fabs(cross) < 1e-4f && dot > 0.0f)
+                continue;// straight, the segment ends already match
+
+            // turning towards +normal makes the left side the inner side
+            float innerSign = (cross > 0.0f) ? 1.0f : -1.0f;
+            float outerSign = -innerSign;
+
+            float mx = s0.normal.x + s1.normal.x;
+            float my = s0.normal.y + s1.normal.y;
+            float mLen = std::sqrt(mx * mx + my * my);
+
+            bool innerShared = false;
+            float miterLen = 0.0f;
+            if (mLen > 1e-4f) {
+                mx /= mLen;
+                my /= mLen;
+                float cosHalf = mx * s0.normal.x + my * s0.normal.y;
+                miterLen = hw / cosHalf;
+                // the inner miter point is only usable if it stays inside both segments
+                float along = std::sqrt(std::max(0.0f, miterLen * miterLen - hw * hw));
+                innerShared = along <= std::min(s0.length, s1.length);
+            }
+
+            SDL_FPoint a{ p.x + s0.normal.x * hw * outerSign, p.y + s0.normal.y * hw * outerSign };
+            SDL_FPoint b{ p.x + s1.normal.x * hw * outerSign, p.y + s1.normal.y * hw * outerSign };
+            SDL_FPoint inner0{ p.x + s0.normal.x * hw * innerSign, p.y + s0.normal.y * hw * innerSign };
+            SDL_FPoint inner1{ p.x + s1.normal.x * hw * innerSign, p.y + s1.normal.y * hw * innerSign };
+            if (innerShared) {
+                inner0 = { p.x + mx * miterLen * innerSign, p.y + my * miterLen * innerSign };
+                inner1 = inner0;
+            }
+
+            // fan center of the corner geometry
+            SDL_FPoint c = (innerShared) ? inner0 : p;
+
+            LineJoin join = s_lineJoin;
+            if (join == LineJoin::MITER && (mLen <= 1e-4f || miterLen > hw * MITER_LIMIT))
+                join = LineJoin::BEVEL;
+
+            SDL_FPoint outer0 = a;
+            SDL_FPoint outer1 = b;
+            switch (join) {
+            case LineJoin::MITER: {
+                SDL_FPoint o{ p.x + mx * miterLen * outerSign, p.y + my * miterLen * outerSign };
+                if (innerShared) {
+                    outer0 = o;
+                    outer1 = o;
+                }
+                else {
+                    int ic = PushStrokeVertex(c.x, c.y, color);
+                    int ia = PushStrokeVertex(a.x, a.y, color);
+                    int io = PushStrokeVertex(o.x, o.y, color);
+                    int ib = PushStrokeVertex(b.x, b.y, color);
+                    PushStrokeTriangle(ic, ia, io);
+                    PushStrokeTriangle(ic, io, ib);
+                }
+                break;
+            }
+            case LineJoin::BEVEL: {
+                int ic = PushStrokeVertex(c.x, c.y, color);
+                int ia = PushStrokeVertex(a.x, a.y, color);
+                int ib = PushStrokeVertex(b.x, b.y, color);
+                PushStrokeTriangle(ic, ia, ib);
+                break;
+            }
+            case LineJoin::ROUND: {
+                float a0 = std::atan2(a.y - p.y, a.x - p.x);
+                float sweep = std::atan2(
+                    (a.x - p.x) * (b.y - p.y) - (a.y - p.y) * (b.x - p.x),
+                    (a.x - p.x) * (b.x - p.x) + (a.y - p.y) * (b.y - p.y));
+                PushStrokeArc(c, p, hw, a0, sweep, color);
+                break;
+            }
+            }
+
+            if (innerSign > 0.0f) {
+                endL(inSeg) = inner0;
+                startL(outSeg) = inner1;
+                endR(inSeg) = outer0;
+                startR(outSeg) = outer1;
+            }
+            else {
+                endR(inSeg) = inner0;
+                startR(outSeg) = inner1;
+                endL(inSeg) = outer0;
+                startL(outSeg) = outer1;
+            }
+        }
+
+        // caps
+        if (!closed && s_lineCap != LineCap::BUTT) {
+            const StrokeSegment& first = s_strokeSegments.front();
+            const StrokeSegment& last = s_strokeSegments.back();
+            const SDL_FPoint& p0 = pts[0];
+            const SDL_FPoint& p1 = pts[count - 1];
+
+            if (s_lineCap == LineCap::SQUARE) {
+                startL(0).x -= first.dir.x * hw;
+                startL(0).y -= first.dir.y * hw;
+                startR(0).x -= first.dir.x * hw;
+                startR(0).y -= first.dir.y * hw;
+                endL(segCount - 1).x += last.dir.x * hw;
+                endL(segCount - 1).y += last.dir.y * hw;
+                endR(segCount - 1).x += last.dir.x * hw;
+                endR(segCount - 1).y += last.dir.y * hw;
+            }
+            else {
+                float startAngle = std::atan2(first.normal.y, first.normal.x);
+                float endAngle = std::atan2(last.normal.y, last.normal.x);
+                PushStrokeArc(p0, p0, hw, startAngle, SDL_PI_F, color);
+                PushStrokeArc(p1, p1, hw, endAngle, -SDL_PI_F, color);
+            }
+        }
+
+        for (size_t i = 0; i < segCount; i++) {
+            int v0 = PushStrokeVertex(startL(i).x, startL(i).y, color);
+            int v1 = PushStrokeVertex(endL(i).x, endL(i).y, color);
+            int v2 = PushStrokeVertex(endR(i).x, endR(i).y, color);
+            int v3 = PushStrokeVertex(startR(i).x, startR(i).y, color);
+            PushStrokeTriangle(v0, v1, v2);
+            PushStrokeTriangle(v0, v2, v3);
+        }
+    }
+
+    // copies the points into the point scratch buffer and removes consecutive duplicates
+    static inline size_t CopyStrokePoints(const Vector2* points, size_t count, bool closed) {
+        s_strokePoints.clear();
+        s_strokePoints.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            SDL_FPoint p{ points[i].x, points[i].y };
+            if (!s_strokePoints.empty() && s_strokePoints.back().x == p.x && s_strokePoints.back().y == p.y)
+                continue;
+            s_strokePoints.push_back(p);
+        }
+
+        if (closed && s_strokePoints.size() > 2 &&
+            s_strokePoints.front().x == s_strokePoints.back().x &&
+            s_strokePoints.front().y == s_strokePoints.back().y)
+        {
+            s_strokePoints.pop_back();
+        }
+        return s_strokePoints.size();
+    }
+
+    // culls the bounds of a stroke, the margin covers the miter limit, joins and caps
+    static inline bool IsStrokeCulled(const SDL_FPoint* pts, size_t count) {
+        if (!s_cullingEnabled || count == 0)
+            return false;
+
+        float minX = pts[0].x;
+        float minY = pts[0].y;
+        float maxX = minX;
+        float maxY = minY;
+        for (size_t i = 1; i < count; i++) {
+            minX = std::min(minX, pts[i].x);
+            minY = std::min(minY, pts[i].y);
+            maxX = std::max(maxX, pts[i].x);
+            maxY = std::max(maxY, pts[i].y);
+        }
+
+        float margin = std::max(s_strokeWidth, 1.0f) / 2.0f * MITER_LIMIT;
+        return IsCulled(minX - margin, minY - margin, maxX + margin, maxY + margin);
+    }
+
+    static void SubmitStrokeGeometry(SDL_Renderer* renderer, const char* funcName) {
+        if (!s_strokeIndices.empty()) {
+            if (RenderBatch* batch = GetActiveRenderBatch()) {
+                batch->AddGeometry(renderer, nullptr,
+                    s_strokeVertices.data(), s_strokeVertices.size(),
+                    s_strokeIndices.data(), s_strokeIndices.size());
+            }
+            else if (!SDL_RenderGeometry(renderer,
+                nullptr,
+                s_strokeVertices.data(),
+                static_cast<int>(s_strokeVertices.size()),
+                s_strokeIndices.data(),
+                static_cast<int>(s_strokeIndices.size())))
+            {
+                Log::Error("SDLCore::Renderer::{}: Failed to draw stroke (vertices={}): {}",
+                    funcName, s_strokeVertices.size(), SDL_GetError());
+            }
+        }
+
+        s_strokeVertices.clear();
+        s_strokeIndices.clear();
+    }
+
+    void Polyline(const Vector2* points, size_t count, bool closed) {
+        auto renderer = GetActiveRenderer();
+        if (!renderer || !points || count < 2)
+            return;
+        CompositePendingBackground();
+
+        size_t pointCount = CopyStrokePoints(points, count, closed);
+        if (pointCount < 2)
+            return;
+
+        if (IsStrokeCulled(s_strokePoints.data(), pointCount))
+            return;
+
+        if (s_strokeWidth <= 1) {
+            FlushBatch();
+            if (closed && pointCount > 2)
+                s_strokePoints.push_back(s_strokePoints.front());
+            if (!SDL_RenderLines(renderer, s_strokePoints.data(), static_cast<int>(s_strokePoints.size()))) {
+                Log::Error("SDLCore::Renderer::Polyline: Failed to draw lines (count={}): {}", count, SDL_GetError());
+            }
+            return;
+        }
+
+        TessellatePolyline(s_strokePoints.data(), pointCount, closed, GetDrawColorF(renderer));
+        SubmitStrokeGeometry(renderer, "Polyline");
+    }
+
+    void Polyline(const std::vector<Vector2>& points, bool closed) {
+        Polyline(points.data(), points.size(), closed);
+    }
+
+    void LineStrip(const Vector2* points, size_t count) {
+        Polyline(points, count, false);
+    }
+
+    void LineStrip(const std::vector<Vector2>& points) {
+        Polyline(points.data(), points.size(), false);
+    }
+
+    void LineList(const Vector2* points, size_t count) {
+        auto renderer = GetActiveRenderer();
+        if (!renderer || !points || count < 2)
+            return;
+        CompositePendingBackground();
+
+        if (s_strokeWidth <= 1) {
+            FlushBatch();
+            for (size_t i = 0; i + 1 < count; i += 2) {
+                SDL_FPoint pair[2] = {
+                    { points[i].x, points[i].y },
+                    { points[i + 1].x, points[i + 1].y }
+                };
+                if (IsStrokeCulled(pair, 2))
+                    continue;
+                if (!SDL_RenderLine(renderer, points[i].x, points[i].y, points[i + 1].x, points[i + 1].y)) {
+                    Log::Error("SDLCore::Renderer::LineList: Failed to draw line {}: {}", i / 2, SDL_GetError());
+                    break;
+                }
+            }
+            return;
+        }
+
+        SDL_FColor color = GetDrawColorF(renderer);
+        for (size_t i = 0; i + 1 < count; i += 2) {
+            SDL_FPoint pair[2] = {
+                { points[i].x, points[i].y },
+                { points[i + 1].x, points[i + 1].y }
+            };
+            if (pair[0].x == pair[1].x && pair[0].y == pair[1].y)
+                continue;
+            if (IsStrokeCulled(pair, 2))
+                continue;
+            TessellatePolyline(pair, 2, false, color);
+        }
+        SubmitStrokeGeometry(renderer, "LineList");
+    }
+
+    void LineList(const std::vector<Vector2>& points) {
+        LineList(points.data(), points.size());
+    }
+
 #pragma endregion
 
     void Point(float x, float y) {
         auto renderer = GetActiveRenderer();
         if (!renderer)
             return;
+        CompositePendingBackground();
+
+        if (IsCulled(x, y, x + 1.0f, y + 1.0f))
+            return;
 
+        FlushBatch();
         if (!SDL_RenderPoint(renderer, x, y)) {
             Log::Error("SDLCore::Renderer::Point: Failed to draw point ({}, {}): {}", x, y, SDL_GetError());
         }
@@ -735,10 +1505,33 @@ namespace SDLCore::Render {
         auto renderer = GetActiveRenderer();
         if (!renderer)
             return false;
+        CompositePendingBackground();
 
         if (!vertices || vertexCount == 0)
             return true;
 
+        if (s_cullingEnabled) {
+            float minX = vertices[0].position.x;
+            float minY = vertices[0].position.y;
+            float maxX = minX;
+            float maxY = minY;
+            for (size_t i = 1; i < vertexCount; i++) {
+                const Vector2& p = vertices[i].position;
+                minX = std::min(minX, p.x);
+                minY = std::min(minY, p.y);
+                maxX = std::max(maxX, p.x);
+                maxY = std::max(maxY, p.y);
+            }
+
+            // transform of the local bounds, a negative scale swaps min and max
+            float x0 = xOffset + minX * scaleX;
+            float x1 = xOffset + maxX * scaleX;
+            float y0 = yOffset + minY * scaleY;
+            float y1 = yOffset + maxY * scaleY;
+            if (IsCulled(std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1)))
+                return true;
+        }
+
         // Local stack buffer for small meshes (no heap allocation)
         constexpr size_t STACK_LIMIT = 64;
         SDL_Vertex stackBuffer[STACK_LIMIT];
@@ -767,6 +1560,11 @@ namespace SDLCore::Render {
         // Index pointer only if valid
         const int* idx = (indexCount > 0) ? indices : nullptr;
 
+        if (RenderBatch* batch = GetActiveRenderBatch()) {
+            batch->AddGeometry(renderer, tex, out, vertexCount, idx, (idx) ? indexCount : 0);
+            return true;
+        }
+
         // Submit geometry to SDL
         if (!SDL_RenderGeometry(renderer,
             tex,
@@ -789,6 +1587,10 @@ namespace SDLCore::Render {
         return true;
     }
 
+    bool Mesh(SDLCore::Mesh& mesh) {
+        return mesh.Render();
+    }
+
     #pragma endregion
 
     #pragma region Texture
@@ -816,30 +1618,22 @@ namespace SDLCore::Render {
     void Texture(SDLCore::Texture& texture, const FRect& transform, const FRect* src) {
         texture.Render(transform.x, transform.y, transform.w, transform.h, src);
     }
-    
-    #pragma endregion
 
-    #pragma region Text
+    void Texture(const SubTexture& texture, float x, float y, float w, float h) {
+        texture.Render(x, y, w, h);
+    }
 
-    // Helper function to calculate the horizontal offset of the text
-    static inline float CalculateHorOffset(const std::string& text, Align align) {
-        switch (align) {
-        case SDLCore::Align::START:     return 0;
-        case SDLCore::Align::CENTER:    return GetTextWidth(text) * 0.5f;
-        case SDLCore::Align::END:       return GetTextWidth(text);
-        default:                                return 0;
-        }
+    void Texture(const SubTexture& texture, const Vector2& pos, const Vector2& size) {
+        texture.Render(pos.x, pos.y, size.x, size.y);
     }
 
-    // Helper function to calculate the vertical offset of the text
-    static inline float CalculateVerOffset(const std::vector<std::string>& lines, Align align) {
-        switch (align) {
-        case SDLCore::Align::START:     return 0;
-        case SDLCore::Align::CENTER:    return GetTextBlockHeight(lines) * 0.5f;
-        case SDLCore::Align::END:       return GetTextBlockHeight(lines);
-        default:                                return 0;
-        }
+    void Texture(const SubTexture& texture, const FRect& transform) {
+        texture.Render(transform.x, transform.y, transform.w, transform.h);
     }
+    
+    #pragma endregion
+
+    #pragma region Text
 
     static inline float CalcOffsetCached(float blockSize, Align align) {
         switch (align) {
@@ -850,143 +1644,200 @@ namespace SDLCore::Render {
         }
     }
 
-    static inline std::vector<std::string> BuildLines(const std::string& text) {
-        std::vector<std::string> lines;
-        lines.reserve(text.size() / 10);
-
-        if (s_textClipWidth == -1) {
-            std::istringstream stream(text);
-            std::string line;
-            line.reserve(32);
-
-            while (std::getline(stream, line)) {
-                lines.push_back(line);
-                if (s_textMaxLines != 0 && lines.size() >= s_textMaxLines)
-                    break;
-            }
-
-            return lines;
-        }
-
-        auto* asset = s_font.GetFontAsset();
-        if (!asset)
-            return lines;
-
-        std::string currentLine;
-        float currentLineWidth = 0.0f;
+    /*
+    * Scale from the metrics of the asset to the selected text size.
+    * SDF assets are created once per font and drawn at every size, normal assets match the size
+    * unless the size is still generated and the nearest ready size is used as placeholder
+    */
+    static inline float GetGlyphScale(const FontAsset* asset) {
+        if (asset->m_fontSize <= 0.0f || s_textSize <= 0.0f)
+            return 1.0f;
+        return s_textSize / asset->m_fontSize;
+    }
 
-        std::string currentWord;
-        float currentWordWidth = 0.0f;
+    /*
+    * Placeholder assets are drawn scaled until the asset of the selected size is ready
+    */
+    static inline bool IsPlaceholderFontAsset(const FontAsset* asset) {
+        return !asset->m_sdf && asset->m_fontSize != s_textSize;
+    }
 
-        currentLine.reserve(32);
-        currentWord.reserve(16);
+    static inline const TextLayout* GetTextLayout(FontAsset* asset, std::string_view text) {
+        TextLayoutParams params;
+        params.scale = GetGlyphScale(asset);
+        params.clipWidth = s_textClipWidth;
+        params.maxLines = s_textMaxLines;
+        return s_textLayouts.Get(asset, text, params);
+    }
 
-        auto flushLine = [&]() {
-            if (!currentLine.empty()) {
-                lines.push_back(currentLine);
-                currentLine.clear();
-                currentLineWidth = 0.0f;
-            }
-        };
+    static inline float CalculateBlockHeight(const FontAsset* asset, size_t lineCount, float scale, float textSize) {
+        const float ascent = static_cast<float>(asset->m_ascent) * scale;
+        const float descent = static_cast<float>(-asset->m_descent) * scale;
+        const float lineSkip = static_cast<float>(asset->m_lineSkip) * scale;
+        const float extra = s_textLineHeightMultiplier * textSize;
 
-        auto flushWord = [&]() {
-            if (currentWord.empty())
-                return;
+        if (lineCount <= 1) {
+            return ascent + descent;
+        }
 
-            if (currentLineWidth + currentWordWidth <= s_textClipWidth) {
-                currentLine += currentWord;
-                currentLineWidth += currentWordWidth;
-            }
-            else {
-                flushLine();
+        return ascent
+            + (lineCount - 1) * (lineSkip + extra)
+            + descent;
+    }
 
-                if (currentWordWidth > s_textClipWidth) {
-                    for (char c : currentWord) {
-                        auto* m = asset->GetGlyphMetrics(c);
-                        if (!m)
-                            continue;
+    static inline float CalculateBlockHeight(const FontAsset* asset, size_t lineCount) {
+        return CalculateBlockHeight(asset, lineCount, GetGlyphScale(asset), s_textSize);
+    }
 
-                        float cw = static_cast<float>(m->advance);
-                        if (currentLineWidth + cw > s_textClipWidth)
-                            flushLine();
+    /*
+    * Writes the truncated text into out, the capacity of out is reused
+    * @return text if nothing is truncated, otherwise out
+    */
+    static const std::string& TruncateText(const std::string& text, std::string& out) {
+        if (s_textMaxLimit == 0)
+            return text;
 
-                        currentLine += c;
-                        currentLineWidth += cw;
-                    }
-                }
-                else {
-                    currentLine = currentWord;
-                    currentLineWidth = currentWordWidth;
-                }
+        switch (s_textLimitType) {
+        case SDLCore::UnitType::CHARACTERS: {
+            // counts code points, a multi byte character is never cut
+            const char* str = text.data();
+            size_t len = text.size();
+            size_t count = 0;
+            while (len > 0 && count < s_textMaxLimit) {
+                SDL_StepUTF8(&str, &len);
+                count++;
             }
 
-            currentWord.clear();
-            currentWordWidth = 0.0f;
-        };
-
-        for (char c : text) {
-            if (c == '\n') {
-                flushWord();
-                flushLine();
-                continue;
-            }
+            if (len == 0)
+                return text;
 
-            auto* m = asset->GetGlyphMetrics(c);
-            if (!m)
-                continue;
+            out.assign(text.data(), str - text.data());
+            out += s_textEllipsis;
+            return out;
+        }
 
-            float charWidth = static_cast<float>(m->advance);
+        case SDLCore::UnitType::PIXELS: {
+            auto* asset = s_font.GetFontAsset();
+            if (!asset)
+                return text;
 
-            if (c == ' ' || c == '\t') {
-                currentWord += c;
-                currentWordWidth += charWidth;
-                flushWord();
-                continue;
-            }
+            // the width is summed over all lines, line breaks are kept
+            const TextWidthTable* table = s_textLayouts.GetWidthTable(asset, text, GetGlyphScale(asset));
+            const size_t fitting = table->GetFittingGlyphCount(static_cast<float>(s_textMaxLimit));
+            if (fitting == table->GetGlyphCount())
+                return text;
 
-            currentWord += c;
-            currentWordWidth += charWidth;
+            out.assign(text.data(), table->offsets[fitting]);
+            if (!out.empty())
+                out += s_textEllipsis;
+            return out;
         }
 
-        flushWord();
-        flushLine();
-
-        if (s_textMaxLines != 0 && lines.size() > s_textMaxLines)
-            lines.resize(s_textMaxLines);
+        case SDLCore::UnitType::NONE:
+        default:
+            return text;
+        }
+    }
 
-        return lines;
+    static inline const std::string& GetFinalText(const std::string& text, std::string& out) {
+        if (s_textMaxLimit == 0 || s_textLimitType == UnitType::NONE)
+            return text;
+        return TruncateText(text, out);
     }
 
-    static inline void RenderLineGlyphs(
-        SDL_Renderer* renderer,
-        SDL_Texture* atlas,
+    /*
+    * Appends one textured quad per glyph of a layout line to the scratch buffer of its atlas page.
+    * Missing glyphs are rasterized by the font asset on first use.
+    * SDF glyphs are scaled to the text size, the alpha is multiplied by the scale so the
+    * one texel edge ramp of the atlas stays one pixel wide after filtering (alpha threshold).
+    * Renderers that clamp vertex colors (software) draw magnified SDF text with softer edges
+    */
+    static inline void AppendLineGlyphs(
         FontAsset* asset,
-        const std::string& line,
+        const TextLayoutGlyph* glyphs,
+        size_t glyphCount,
         float penX,
-        float penY)
+        float penY,
+        const SDL_FColor& color)
     {
-        const float ascent = static_cast<float>(asset->m_ascent);
+        const float invAtlasW = 1.0f / static_cast<float>(asset->GetGlyphAtlasPageSize());
+        const float invAtlasH = invAtlasW;
+        const float scale = GetGlyphScale(asset);
+
+        SDL_FColor glyphColor = color;
+        if (asset->m_sdf)
+            glyphColor.a *= std::max(scale, 1.0f);
 
-        for (char c : line) {
-            auto* m = asset->GetGlyphMetrics(static_cast<uint8_t>(c));
+        for (size_t i = 0; i < glyphCount; ++i) {
+            auto* m = asset->GetGlyphMetrics(glyphs[i].code);
             if (!m) continue;
-            
-            SDL_FRect dst{
-                penX,
-                penY,
-                static_cast<float>(m->atlasWidth),
-                static_cast<float>(m->atlasHeight)
-            };
 
-            SDL_FRect src{
-                static_cast<float>(m->atlasX),
-                static_cast<float>(m->atlasY),
-                static_cast<float>(m->atlasWidth),
-                static_cast<float>(m->atlasHeight)
-            };
+            if (m->atlasWidth > 0 && m->atlasHeight > 0) {
+                float x0 = penX + glyphs[i].x;
+                float y0 = penY;
+                float x1 = x0 + static_cast<float>(m->atlasWidth) * scale;
+                float y1 = penY + static_cast<float>(m->atlasHeight) * scale;
+
+                float u0 = static_cast<float>(m->atlasX) * invAtlasW;
+                float v0 = static_cast<float>(m->atlasY) * invAtlasH;
+                float u1 = static_cast<float>(m->atlasX + m->atlasWidth) * invAtlasW;
+                float v1 = static_cast<float>(m->atlasY + m->atlasHeight) * invAtlasH;
+
+                if (static_cast<size_t>(m->atlasPage) >= s_glyphGeometry.size())
+                    s_glyphGeometry.resize(m->atlasPage + 1);
+                GlyphGeometry& geo = s_glyphGeometry[m->atlasPage];
+
+                int base = static_cast<int>(geo.vertices.size());
+                geo.vertices.push_back({ { x0, y0 }, glyphColor, { u0, v0 } });
+                geo.vertices.push_back({ { x1, y0 }, glyphColor, { u1, v0 } });
+                geo.vertices.push_back({ { x1, y1 }, glyphColor, { u1, v1 } });
+                geo.vertices.push_back({ { x0, y1 }, glyphColor, { u0, v1 } });
+
+                geo.indices.push_back(base);
+                geo.indices.push_back(base + 1);
+                geo.indices.push_back(base + 2);
+                geo.indices.push_back(base);
+                geo.indices.push_back(base + 2);
+                geo.indices.push_back(base + 3);
+            }
+        }
+    }
+
+    /*
+    * Submits the glyph scratch buffers with one geometry call per atlas page and clears them.
+    * The page textures are requested after all glyphs are appended, so glyphs rasterized
+    * by this draw call are uploaded first.
+    * The atlas color mod is ignored by SDL_RenderGeometry, the color is stored in the vertices.
+    * @param batch if not nullptr the glyphs are recorded into the batch instead
+    */
+    static inline void RenderGlyphGeometry(SDL_Renderer* renderer, FontAsset* asset, RenderBatch* batch) {
+        for (size_t page = 0; page < s_glyphGeometry.size(); ++page) {
+            GlyphGeometry& geo = s_glyphGeometry[page];
+            if (geo.vertices.empty())
+                continue;
+
+            SDL_Texture* atlas = asset->GetGlyphAtlasTexture(s_winID, static_cast<int>(page));
+            if (!atlas) {
+                // error is logged by the font asset
+            }
+            else if (batch) {
+                batch->AddGeometry(renderer, atlas,
+                    geo.vertices.data(), geo.vertices.size(),
+                    geo.indices.data(), geo.indices.size());
+            }
+            else if (!SDL_RenderGeometry(renderer,
+                atlas,
+                geo.vertices.data(),
+                static_cast<int>(geo.vertices.size()),
+                geo.indices.data(),
+                static_cast<int>(geo.indices.size())))
+            {
+                Log::Error("SDLCore::Renderer::Text: Failed to draw glyphs (count={}, page={}): {}",
+                    geo.vertices.size() / 4, page, SDL_GetError());
+            }
 
-            SDL_RenderTexture(renderer, atlas, &src, &dst);
-            penX += m->advance;
+            geo.vertices.clear();
+            geo.indices.clear();
         }
     }
 
@@ -1005,31 +1856,36 @@ namespace SDLCore::Render {
         };
 
         auto it = s_textCache.find(key);
-        if (it == s_textCache.end() && !createOnNotFound)
-            return nullptr;
+        bool inserted = false;
+        if (it == s_textCache.end()) {
+            if (!createOnNotFound)
+                return nullptr;
+            it = s_textCache.try_emplace(std::move(key)).first;
+            it->second.key = &it->first;
+            inserted = true;
+        }
 
         s_isCalculatingTextCache = true;
-        auto [it2, inserted] = s_textCache.try_emplace(key);
-        CachedText& ct = it2->second;
-
-        if (inserted || ct.lines.empty()) {
-            ct.lines = BuildLines(text);
-
-            ct.lineWidths.clear();
-            ct.lineWidths.reserve(ct.lines.size());
+        CachedText& ct = it->second;
+        bool rebuild = inserted || ct.lineCount == 0;
 
-            for (const auto& line : ct.lines) {
-                ct.lineWidths.push_back(GetTextWidth(line));
-            }
+        // only render lookups are counted, measurement functions probe the cache as well
+        if (createOnNotFound) {
+            if (rebuild)
+                s_textCacheMisses++;
+            else
+                s_textCacheHits++;
+        }
 
-            ct.blockWidth = GetTextBlockWidth(ct.lines);
-            ct.blockHeight = GetTextBlockHeight(ct.lines);
+        FontAsset* asset = s_font.GetFontAsset();
+        if (rebuild && asset) {
+            const TextLayout* layout = GetTextLayout(asset, text);
+            ct.lineCount = layout->lines.size();
+            ct.blockWidth = layout->blockWidth;
+            ct.blockHeight = CalculateBlockHeight(asset, ct.lineCount);
             ct.textWidth = GetTextWidth(text);
 
-            if (ct.preRenderedTexture) {
-                SDL_DestroyTexture(ct.preRenderedTexture);
-                ct.preRenderedTexture = nullptr;
-            }
+            DestroyCachedTextTexture(ct);
 
             auto renderer = GetActiveRenderer();
             if (renderer) {
@@ -1042,46 +1898,61 @@ namespace SDLCore::Render {
                 );
 
                 if (ct.preRenderedTexture) {
+                    ct.textureBytes = static_cast<size_t>(ct.preRenderedTexture->w) *
+                        static_cast<size_t>(ct.preRenderedTexture->h) * 4;
+                    s_textCacheBytes += ct.textureBytes;
+
+                    // pending draws belong to the current target
+                    FlushBatch();
                     SDL_Texture* oldTarget = SDL_GetRenderTarget(renderer);
                     SDL_SetRenderTarget(renderer, ct.preRenderedTexture);
-                    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+                    RenderStateCache& state = GetActiveRenderState();
+                    state.SetDrawColor(renderer, SDL_Color{ 0, 0, 0, 0 });
                     SDL_RenderClear(renderer);
 
-                    SDL_Texture* atlas = s_font.GetFontAsset()->GetGlyphAtlasTexture(s_winID);
-                    SDL_SetTextureColorMod(atlas, 255, 255, 255);
-                    SDL_SetTextureAlphaMod(atlas, 255);
+                    const SDL_FColor white{ 1.0f, 1.0f, 1.0f, 1.0f };
 
                     float lineH = GetLineHeight();
                     float penY = 0.0f;
 
-                    for (size_t i = 0; i < ct.lines.size(); ++i) {
+                    for (const auto& line : layout->lines) {
                         float penX = 0.0f;
                         switch (s_textHorAlign) {
-                        case Align::START:  penX = 0.0f;                                         break;
-                        case Align::CENTER: penX = (ct.blockWidth - ct.lineWidths[i]) * 0.5f;   break;
-                        case Align::END:    penX = ct.blockWidth - ct.lineWidths[i];            break;
-                        default:            penX = 0.0f;                                         break;
+                        case Align::START:  penX = 0.0f;                                    break;
+                        case Align::CENTER: penX = (ct.blockWidth - line.width) * 0.5f;    break;
+                        case Align::END:    penX = ct.blockWidth - line.width;             break;
+                        default:            penX = 0.0f;                                    break;
                         }
 
-                        RenderLineGlyphs(renderer, atlas, s_font.GetFontAsset(),
-                            ct.lines[i], penX, penY);
+                        AppendLineGlyphs(asset, layout->glyphs.data() + line.firstGlyph, line.glyphCount, penX, penY, white);
 
                         penY += lineH;
                     }
 
+                    // drawn directly, the batch only records draws for the window target
+                    RenderGlyphGeometry(renderer, asset, nullptr);
                     SDL_SetRenderTarget(renderer, oldTarget);
+                    state.SetDrawColor(renderer, s_activeColor);
                 }
             }
         }
 
         s_isCalculatingTextCache = false;
         ct.lastUseFrame = Time::GetFrameCount();
+        if (!ct.pinned) {
+            UnlinkCachedText(ct);
+            PushFrontCachedText(ct);
+        }
+
+        if (rebuild)
+            EnforceTextCacheBudget(&ct);
         return &ct;
     }
 
     static inline void RenderCachedText(const std::string& text, float x, float y) {
         auto renderer = GetActiveRenderer();
         if (!renderer) return;
+        CompositePendingBackground();
 
         CachedText* ct = GetCachedText(text, CREATE_ON_NOT_FOUND);
         if (!ct || !ct->preRenderedTexture)
@@ -1094,6 +1965,11 @@ namespace SDLCore::Render {
             ct->blockHeight
         };
 
+        if (IsRectCulled(dst.x, dst.y, dst.w, dst.h))
+            return;
+
+        FlushBatch();
+
         if (!ct->firstCall) {
             SDL_Color& col = ct->color;
             if (col.r != s_activeColor.r ||
@@ -1122,64 +1998,245 @@ namespace SDLCore::Render {
     }
 
     void Text(const std::string& text, float x, float y) {
-        std::string finalText = (s_textMaxLimit != 0 && s_textLimitType != UnitType::NONE)
-            ? GetTruncatedText(text)
-            : text;
+        // CacheText only applies to this call, also if nothing is drawn
+        const bool cacheText = s_textCacheEnabled;
+        s_textCacheEnabled = false;
+
+        const std::string& finalText = GetFinalText(text, s_truncatedText);
 
-        if (s_textCacheEnabled) {
-            RenderCachedText(finalText, x, y);
-            s_textCacheEnabled = false;
+        auto* asset = s_font.GetFontAsset();
+        if (!asset || !asset->IsReady())
             return;
+
+        if (cacheText) {
+            // a placeholder size is drawn uncached, the cache would keep it after the real size is ready
+            if (!IsPlaceholderFontAsset(asset)) {
+                RenderCachedText(finalText, x, y);
+                return;
+            }
         }
 
         auto renderer = GetActiveRenderer();
         if (!renderer)
             return;
-        
-        auto* asset = s_font.GetFontAsset();
-        if (!asset)
-            return;
-
-        SDL_Texture* atlas = asset->GetGlyphAtlasTexture(s_winID);
-        if (!atlas)
-            return;
+        CompositePendingBackground();
 
-        SDL_SetTextureColorMod(atlas, s_activeColor.r, s_activeColor.g, s_activeColor.b);
-        SDL_SetTextureAlphaMod(atlas, s_activeColor.a);
+        const SDL_FColor color{
+            s_activeColor.r / 255.0f,
+            s_activeColor.g / 255.0f,
+            s_activeColor.b / 255.0f,
+            s_activeColor.a / 255.0f
+        };
 
-        std::vector<std::string> lines = BuildLines(finalText);
-        if (lines.empty())
+        const TextLayout* layout = GetTextLayout(asset, finalText);
+        if (!layout || layout->lines.empty())
             return;
 
-        const float lineH = static_cast<float>(asset->m_lineSkip)
+        const float lineH = static_cast<float>(asset->m_lineSkip) * GetGlyphScale(asset)
             + s_textLineHeightMultiplier * s_textSize;
-        const float blockH = GetTextBlockHeight(lines);
+        const float blockH = CalculateBlockHeight(asset, layout->lines.size());
         const float blockOffsetY = CalcOffsetCached(blockH, s_textVerAlign);
 
         float penY = y - blockOffsetY;
 
-        for (size_t i = 0; i < lines.size(); ++i) {
-            if (s_textMaxLines != 0 && i >= s_textMaxLines) break;
+        // lines outside the visible area are skipped, the block counts as culled if no line is visible
+        bool cull = s_cullingEnabled;
+        bool anyLineVisible = false;
+        if (cull && !s_cullBoundsValid)
+            UpdateCullBounds();
 
-            float lineWidth = GetTextWidth(lines[i]);
-            float blockOffsetX = CalcOffsetCached(lineWidth, s_textHorAlign);
+        for (const auto& line : layout->lines) {
+            float blockOffsetX = CalcOffsetCached(line.width, s_textHorAlign);
             float penX = x - blockOffsetX;
 
-            RenderLineGlyphs(renderer, atlas, asset, lines[i], penX, penY);
+            if (!cull || !IsOutsideCullBounds(penX, penY, penX + line.width, penY + lineH)) {
+                AppendLineGlyphs(asset, layout->glyphs.data() + line.firstGlyph, line.glyphCount, penX, penY, color);
+                anyLineVisible = true;
+            }
 
             penY += lineH;
         }
+
+        if (cull && CountCullResult(!anyLineVisible))
+            return;
+
+        RenderGlyphGeometry(renderer, asset, GetActiveRenderBatch());
     }
 
     void Text(const std::string& text, const Vector2& pos) {
         Text(text, pos.x, pos.y);
     }
 
+    void Text(TextBlock& block, float x, float y) {
+        auto* asset = s_font.GetFontAsset();
+        if (!asset || !asset->IsReady())
+            return;
+
+        auto renderer = GetActiveRenderer();
+        if (!renderer)
+            return;
+        CompositePendingBackground();
+
+        TextLayoutParams params;
+        params.scale = GetGlyphScale(asset);
+        params.clipWidth = s_textClipWidth;
+        block.UpdateLayout(asset, params);
+        if (block.m_lines.empty())
+            return;
+
+        const auto& lines = block.m_lines;
+        const float lineH = GetLineHeight();
+        const float blockW = block.m_blockWidth;
+        const float blockH = CalculateBlockHeight(asset, lines.size());
+        const float originX = x - CalcOffsetCached(blockW, s_textHorAlign);
+        const float originY = y - CalcOffsetCached(blockH, s_textVerAlign);
+
+        auto lineOffsetX = [&](float lineWidth) {
+            switch (s_textHorAlign) {
+            case Align::CENTER: return (blockW - lineWidth) * 0.5f;
+            case Align::END:    return blockW - lineWidth;
+            default:            return 0.0f;
+            }
+        };
+
+        // a placeholder size is drawn directly, the texture would keep the scaled glyphs
+        if (!block.m_textureCache || IsPlaceholderFontAsset(asset)) {
+            block.m_dirtyLineBegin = block.m_dirtyLineEnd = 0;
+
+            const SDL_FColor color{
+                s_activeColor.r / 255.0f,
+                s_activeColor.g / 255.0f,
+                s_activeColor.b / 255.0f,
+                s_activeColor.a / 255.0f
+            };
+
+            bool cull = s_cullingEnabled;
+            bool anyLineVisible = false;
+            if (cull && !s_cullBoundsValid)
+                UpdateCullBounds();
+
+            float penY = originY;
+            for (const auto& line : lines) {
+                float penX = originX + lineOffsetX(line.width);
+                if (!cull || !IsOutsideCullBounds(penX, penY, penX + line.width, penY + lineH)) {
+                    AppendLineGlyphs(asset, line.glyphs.data(), line.glyphs.size(), penX, penY, color);
+                    anyLineVisible = true;
+                }
+                penY += lineH;
+            }
+
+            if (cull && CountCullResult(!anyLineVisible))
+                return;
+
+            RenderGlyphGeometry(renderer, asset, GetActiveRenderBatch());
+            return;
+        }
+
+        SDL_FRect dst{ originX, originY, blockW, blockH };
+        if (IsRectCulled(dst.x, dst.y, dst.w, dst.h))
+            return;
+
+        const int neededW = std::max(static_cast<int>(std::ceil(blockW)), 1);
+        const int neededH = std::max(static_cast<int>(std::ceil(blockH)), 1);
+        if (!block.m_texture || block.m_textureWinID != s_winID ||
+            neededW > block.m_textureWidth || neededH > block.m_textureHeight)
+        {
+            // grows with headroom, a growing block does not create a new texture for every line
+            auto grow = [](int size) { return ((size + size / 4 + 63) / 64) * 64; };
+            const int w = grow(neededW);
+            const int h = grow(neededH);
+
+            SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+            if (!texture) {
+                Log::Error("SDLCore::Renderer::Text: Failed to create text block texture ({}x{}): {}", w, h, SDL_GetError());
+                return;
+            }
+
+            block.SetTexture(texture, s_winID, w, h);
+            if (!block.m_texture)
+                return;
+            block.MarkLinesDirty(0, lines.size());
+        }
+
+        // alignment and line height move every line
+        if (block.m_textureAlign != s_textHorAlign || block.m_textureLineHeight != lineH ||
+            (s_textHorAlign != Align::START && block.m_textureBlockWidth != blockW))
+        {
+            block.MarkLinesDirty(0, lines.size());
+        }
+
+        if (block.m_dirtyLineBegin < block.m_dirtyLineEnd) {
+            const size_t begin = block.m_dirtyLineBegin;
+            const size_t end = std::min(block.m_dirtyLineEnd, lines.size());
+
+            // pending draws belong to the current target
+            FlushBatch();
+            SDL_Texture* oldTarget = SDL_GetRenderTarget(renderer);
+            SDL_SetRenderTarget(renderer, block.m_texture);
+            RenderStateCache& state = GetActiveRenderState();
+
+            SDL_BlendMode oldBlendMode = SDL_BLENDMODE_BLEND;
+            SDL_GetRenderDrawBlendMode(renderer, &oldBlendMode);
+
+            // removed lines are cleared down to the bottom of the texture
+            const float clearTop = static_cast<float>(begin) * lineH;
+            const float clearBottom = (block.m_dirtyLineEnd >= lines.size())
+                ? static_cast<float>(block.m_textureHeight)
+                : static_cast<float>(end) * lineH;
+            SDL_FRect clearRect{ 0.0f, clearTop, static_cast<float>(block.m_textureWidth), clearBottom - clearTop };
+
+            state.SetDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+            state.SetDrawColor(renderer, SDL_Color{ 0, 0, 0, 0 });
+            SDL_RenderFillRect(renderer, &clearRect);
+            state.SetDrawBlendMode(renderer, oldBlendMode);
+
+            const SDL_FColor white{ 1.0f, 1.0f, 1.0f, 1.0f };
+            for (size_t i = begin; i < end; ++i) {
+                const auto& line = lines[i];
+                AppendLineGlyphs(asset, line.glyphs.data(), line.glyphs.size(),
+                    lineOffsetX(line.width), static_cast<float>(i) * lineH, white);
+            }
+
+            // drawn directly, the batch only records draws for the window target
+            RenderGlyphGeometry(renderer, asset, nullptr);
+            SDL_SetRenderTarget(renderer, oldTarget);
+            state.SetDrawColor(renderer, s_activeColor);
+
+            block.m_dirtyLineBegin = block.m_dirtyLineEnd = 0;
+            block.m_textureAlign = s_textHorAlign;
+            block.m_textureLineHeight = lineH;
+            block.m_textureBlockWidth = blockW;
+        }
+
+        FlushBatch();
+
+        SDL_Color& col = block.m_textureColor;
+        if (col.r != s_activeColor.r || col.g != s_activeColor.g || col.b != s_activeColor.b) {
+            SDL_SetTextureColorMod(block.m_texture, s_activeColor.r, s_activeColor.g, s_activeColor.b);
+            col.r = s_activeColor.r;
+            col.g = s_activeColor.g;
+            col.b = s_activeColor.b;
+        }
+
+        if (col.a != s_activeColor.a) {
+            SDL_SetTextureAlphaMod(block.m_texture, s_activeColor.a);
+            col.a = s_activeColor.a;
+        }
+
+        SDL_FRect src{ 0.0f, 0.0f, blockW, blockH };
+        SDL_RenderTexture(renderer, block.m_texture, &src, &dst);
+    }
+
+    void Text(TextBlock& block, const Vector2& pos) {
+        Text(block, pos.x, pos.y);
+    }
+
     void CacheText(bool value) {
         s_textCacheEnabled = value;
     }
 
     void ClearTextCache() {
+        s_textLayouts.Clear();
         for (auto& [key, ct] : s_textCache) {
             if (ct.preRenderedTexture) {
                 SDL_DestroyTexture(ct.preRenderedTexture);
@@ -1187,15 +2244,21 @@ namespace SDLCore::Render {
             }
         }
         s_textCache.clear();
+        s_textCacheHead = nullptr;
+        s_textCacheTail = nullptr;
+        s_textCacheBytes = 0;
+        s_textCachePinnedCount = 0;
     }
 
     void ClearTextCache(const Font* font) {
         for (auto it = s_textCache.begin(); it != s_textCache.end(); ) {
             if (it->first.font == font) {
-                if (it->second.preRenderedTexture) {
-                    SDL_DestroyTexture(it->second.preRenderedTexture);
-                    it->second.preRenderedTexture = nullptr;
-                }
+                CachedText& ct = it->second;
+                DestroyCachedTextTexture(ct);
+                if (ct.pinned)
+                    s_textCachePinnedCount--;
+                else
+                    UnlinkCachedText(ct);
                 it = s_textCache.erase(it);
             }
             else {
@@ -1208,6 +2271,57 @@ namespace SDLCore::Render {
         return s_textCache.size();
     }
 
+    bool PinCachedText(const std::string& text, bool value) {
+        std::string truncated;
+        const std::string& finalText = GetFinalText(text, truncated);
+
+        CachedText* ct = GetCachedText(finalText, value);
+        if (!ct)
+            return false;
+
+        if (ct->pinned == value)
+            return true;
+
+        ct->pinned = value;
+        if (value) {
+            UnlinkCachedText(*ct);
+            s_textCachePinnedCount++;
+        }
+        else {
+            PushFrontCachedText(*ct);
+            s_textCachePinnedCount--;
+            EnforceTextCacheBudget(ct);
+        }
+        return true;
+    }
+
+    void SetTextCacheBudget(size_t bytes) {
+        s_textCacheBudgetBytes = bytes;
+        EnforceTextCacheBudget();
+    }
+
+    size_t GetTextCacheBudget() {
+        return s_textCacheBudgetBytes;
+    }
+
+    TextCacheStats GetTextCacheStats() {
+        TextCacheStats stats;
+        stats.entries = s_textCache.size();
+        stats.pinnedEntries = s_textCachePinnedCount;
+        stats.textureBytes = s_textCacheBytes;
+        stats.budgetBytes = s_textCacheBudgetBytes;
+        stats.hits = s_textCacheHits;
+        stats.misses = s_textCacheMisses;
+        stats.evictions = s_textCacheEvictions;
+        return stats;
+    }
+
+    void ResetTextCacheStats() {
+        s_textCacheHits = 0;
+        s_textCacheMisses = 0;
+        s_textCacheEvictions = 0;
+    }
+
     void ResetTextParams() {
         SetTextSize(16.0f);
         SetTextAlign(Align::START);
@@ -1304,51 +2418,8 @@ namespace SDLCore::Render {
     }
 
     std::string GetTruncatedText(const std::string& text) {
-        if (s_textMaxLimit == 0)
-            return text;
-
-        switch (s_textLimitType) {
-        case SDLCore::UnitType::CHARACTERS: {
-            if (text.size() <= s_textMaxLimit)
-                return text;
-            return text.substr(0, s_textMaxLimit) + s_textEllipsis;
-        }
-
-        case SDLCore::UnitType::PIXELS: {
-            auto* asset = s_font.GetFontAsset();
-            if (!asset)
-                return text;
-
-            float width = 0.0f;
-            std::string result;
-
-            for (char c : text) {
-                //add line break chars
-                if (c == '\n')
-                    result += c;
-
-                auto* metric = asset->GetGlyphMetrics(c);
-                if (!metric)
-                    continue;
-
-                float charWidth = static_cast<float>(metric->advance);
-                if (width + charWidth > s_textMaxLimit) {
-                    if (!result.empty())
-                        result += s_textEllipsis;
-                    return result;
-                }
-
-                result += c;
-                width += charWidth;
-            }
-
-            return result;
-        }
-
-        case SDLCore::UnitType::NONE:
-        default:
-            return text;
-        }
+        std::string result;
+        return TruncateText(text, result);
     }
 
     void SetTextClipWidth(float w) {
@@ -1363,12 +2434,104 @@ namespace SDLCore::Render {
         s_textClipWidth = -1.0f;
     }
     
+    /*
+    * Wrapped text does not scale linearly, the number of lines changes with the size.
+    * Searches the largest size whose layout fits into the target with a binary search,
+    * the result is memoized by the layout cache
+    */
+    static float FindWrappedTextSize(FontAsset* asset, const std::string& text, float targetW, float targetH) {
+        constexpr float MIN_SIZE = 1.0f;
+        constexpr float MAX_SIZE = 4096.0f;
+        constexpr float SIZE_TOLERANCE = 0.1f;
+
+        TextFitParams fitParams;
+        fitParams.layout.clipWidth = s_textClipWidth;
+        fitParams.layout.maxLines = s_textMaxLines;
+        fitParams.targetW = targetW;
+        fitParams.targetH = targetH;
+        fitParams.lineHeightMultiplier = s_textLineHeightMultiplier;
+
+        float fittedSize = 0.0f;
+        if (s_textLayouts.GetFittedSize(asset, text, fitParams, fittedSize))
+            return fittedSize;
+
+        auto fits = [&](float size) {
+            TextLayoutParams params;
+            params.scale = size / asset->m_fontSize;
+            params.clipWidth = s_textClipWidth;
+            params.maxLines = s_textMaxLines;
+            BuildTextLayout(asset, text, params, s_fitLayout);
+
+            float w = s_fitLayout.blockWidth;
+            float h = CalculateBlockHeight(asset, s_fitLayout.lines.size(), params.scale, size);
+            return (targetW <= 0.0f || w <= targetW) && (targetH <= 0.0f || h <= targetH);
+        };
+
+        // the unwrapped text scales linearly, its size is the closed form first guess.
+        // Wrapping only adds lines, the result is usually close to it
+        TextLayoutParams unwrapped;
+        unwrapped.scale = 1.0f;
+        unwrapped.maxLines = s_textMaxLines;
+        const TextLayout* layout = s_textLayouts.Get(asset, text, unwrapped);
+        const float unitH = CalculateBlockHeight(asset, layout->lines.size(), 1.0f / asset->m_fontSize, 1.0f);
+
+        float estimate = MAX_SIZE;
+        if (targetW > 0.0f && layout->blockWidth > 0.0f)
+            estimate = std::min(estimate, targetW / layout->blockWidth * asset->m_fontSize);
+        if (targetH > 0.0f && unitH > 0.0f)
+            estimate = std::min(estimate, targetH / unitH);
+        estimate = std::clamp(estimate, MIN_SIZE, MAX_SIZE);
+
+        float low = 0.0f;
+        float high = estimate;
+        if (fits(estimate)) {
+            low = estimate;
+            high = std::min(estimate * 2.0f, MAX_SIZE);
+            while (high < MAX_SIZE && fits(high)) {
+                low = high;
+                high = std::min(high * 2.0f, MAX_SIZE);
+            }
+        }
+        else {
+            low = estimate * 0.5f;
+            while (low >= MIN_SIZE && !fits(low)) {
+                high = low;
+                low *= 0.5f;
+            }
+            if (low < MIN_SIZE)
+                low = 0.0f;
+        }
+
+        while (high - low > SIZE_TOLERANCE) {
+            float mid = (low + high) * 0.5f;
+            if (fits(mid))
+                low = mid;
+            else
+                high = mid;
+        }
+
+        fittedSize = std::max(low, MIN_SIZE);
+        s_textLayouts.SetFittedSize(asset, text, fitParams, fittedSize);
+        return fittedSize;
+    }
+
     float CalculateTextSizeForBounds(const std::string& text, float targetW, float targetH) {
         if (text.empty())
             return 1.0f;
 
         float baseSize = (s_textSize > 0.0f) ? s_textSize : 16.0f;
+        if (targetW <= 0.0f && targetH <= 0.0f)
+            return baseSize;
 
+        auto* asset = s_font.GetFontAsset();
+        if (!asset || asset->m_fontSize <= 0.0f)
+            return baseSize;
+
+        if (s_textClipWidth != -1.0f)
+            return FindWrappedTextSize(asset, text, targetW, targetH);
+
+        // unwrapped text scales linearly with the size, the memoized layout of the
+        // current size gives the result directly
         float baseW = GetTextBlockWidth(text);
         float baseH = GetTextBlockHeight(text);
 
@@ -1392,11 +2555,8 @@ namespace SDLCore::Render {
         else if (scaleW > 0.0f) {
             scale = scaleW;
         }
-        else if (scaleH > 0.0f) {
-            scale = scaleH;
-        }
         else {
-            return baseSize;
+            scale = scaleH;
         }
 
         return baseSize * scale;
@@ -1411,8 +2571,8 @@ namespace SDLCore::Render {
         if (!asset)
             return 0.0f;
 
-        auto* m = asset->GetGlyphMetrics(c);
-        return (m) ? m->advance : 0.0f;
+        int advance = asset->GetGlyphAdvance(static_cast<unsigned char>(c));
+        return (advance != FontAsset::NO_GLYPH) ? advance * GetGlyphScale(asset) : 0.0f;
     }
 
     float GetTextWidth(const std::string& text) {
@@ -1420,16 +2580,12 @@ namespace SDLCore::Render {
             if (auto* ct = GetCachedText(text, false))
                 return ct->textWidth; // use cached width
 
-        float width = 0.0f;
         auto* asset = s_font.GetFontAsset();
         if (!asset) 
             return 0.0f;
 
-        for (char c : text) {
-            if (auto* m = asset->GetGlyphMetrics(c))
-                width += m->advance;
-        }
-        return width;
+        const TextWidthTable* table = s_textLayouts.GetWidthTable(asset, text, GetGlyphScale(asset));
+        return (table) ? table->GetWidth() : 0.0f;
     }
 
     float GetTextHeight() {
@@ -1437,7 +2593,7 @@ namespace SDLCore::Render {
         if (!asset)
             return 0.0f;
 
-        return static_cast<float>(asset->m_ascent - asset->m_descent);
+        return static_cast<float>(asset->m_ascent - asset->m_descent) * GetGlyphScale(asset);
     }
 
     float GetTextBlockWidth(const std::string& text) {
@@ -1445,8 +2601,12 @@ namespace SDLCore::Render {
             if (auto* ct = GetCachedText(text, false))
                 return ct->blockWidth; // cached block width
 
-        auto lines = BuildLines(text);
-        return GetTextBlockWidth(lines);
+        auto* asset = s_font.GetFontAsset();
+        if (!asset)
+            return 0.0f;
+
+        const TextLayout* layout = GetTextLayout(asset, text);
+        return (layout) ? layout->blockWidth : 0.0f;
     }
 
     float GetTextBlockWidth(const std::vector<std::string>& lines) {
@@ -1465,8 +2625,12 @@ namespace SDLCore::Render {
             if (auto* ct = GetCachedText(text, false))
                 return ct->blockHeight;
 
-        auto lines = BuildLines(text);
-        return GetTextBlockHeight(lines);
+        auto* asset = s_font.GetFontAsset();
+        if (!asset)
+            return 0.0f;
+
+        const TextLayout* layout = GetTextLayout(asset, text);
+        return CalculateBlockHeight(asset, (layout) ? layout->lines.size() : 0);
     }
 
     float GetTextBlockHeight(const std::vector<std::string>& lines) {
@@ -1474,18 +2638,7 @@ namespace SDLCore::Render {
         if (!asset)
             return 0.0f;
 
-        const float ascent = static_cast<float>(asset->m_ascent);
-        const float descent = static_cast<float>(-asset->m_descent);
-        const float lineSkip = static_cast<float>(asset->m_lineSkip);
-        const float extra = s_textLineHeightMultiplier * s_textSize;
-
-        if (lines.size() == 1) {
-            return ascent + descent;
-        }
-
-        return ascent
-            + (lines.size() - 1) * (lineSkip + extra)
-            + descent;
+        return CalculateBlockHeight(asset, lines.size());
     }
 
     float GetLineHeight() {
@@ -1493,7 +2646,7 @@ namespace SDLCore::Render {
         if (!asset) 
             return 0.0f;
 
-        return static_cast<float>(asset->m_lineSkip)
+        return static_cast<float>(asset->m_lineSkip) * GetGlyphScale(asset)
             + (s_textLineHeightMultiplier * s_textSize);
     }
 
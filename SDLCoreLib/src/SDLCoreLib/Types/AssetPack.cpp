@@ -0,0 +1,247 @@
+#include <algorithm>
+#include <SDL3/SDL.h>
+#include <CoreLib/Log.h>
+
+#include "SDLCoreError.h"
+#include "Types/AssetPack.h"
+
+namespace SDLCore {
+
+    using namespace AssetPackFormat;
+
+    AssetPack::AssetPack(const SystemFilePath& path) {
+        if (!Open(path))
+            Log::Error("SDLCore::AssetPack: {}", GetError());
+    }
+
+    bool AssetPack::Open(const SystemFilePath& path) {
+        Close();
+
+        if (!m_file.Open(path)) {
+            SetErrorF("SDLCore::AssetPack::Open: Could not map '{}'", path);
+            return false;
+        }
+
+        const uint8_t* data = m_file.GetData();
+        const size_t size = m_file.GetSize();
+        auto fail = [&](const char* reason) {
+            SetErrorF("SDLCore::AssetPack::Open: '{}' is not a valid asset pack, {}", path, reason);
+            m_file.Close();
+            return false;
+        };
+
+        if (size < sizeof(Header))
+            return fail("file is too small");
+
+        const auto* header = reinterpret_cast<const Header*>(data);
+        if (header->magic != MAGIC)
+            return fail("wrong magic number");
+        if (header->version != VERSION)
+            return fail("unsupported version");
+
+        const uint64_t indexSize = static_cast<uint64_t>(header->entryCount) * sizeof(Entry);
+        if (header->indexOffset % alignof(Entry) != 0 ||
+            header->indexOffset > size || indexSize > size - header->indexOffset ||
+            header->pathsOffset != header->indexOffset + indexSize ||
+            header->pathsSize > size - header->pathsOffset)
+            return fail("index is out of range");
+
+        if (Checksum(data + header->indexOffset, indexSize + header->pathsSize) != header->indexChecksum)
+            return fail("index is corrupted");
+
+        // entries are validated once, lookups do not check bounds again
+        const auto* entries = reinterpret_cast<const Entry*>(data + header->indexOffset);
+        for (uint32_t i = 0; i < header->entryCount; i++) {
+            const Entry& entry = entries[i];
+            const bool compressed = (entry.flags & ENTRY_COMPRESSED) != 0;
+            if (entry.offset < sizeof(Header) || entry.offset > header->indexOffset || entry.storedSize > header->indexOffset - entry.offset ||
+                static_cast<uint64_t>(entry.pathOffset) + entry.pathLength > header->pathsSize ||
+                (!compressed && entry.storedSize != entry.size))
+                return fail("entry is out of range");
+
+            if (i > 0 && entries[i - 1].pathHash > entry.pathHash)
+                return fail("index is not sorted");
+        }
+
+        m_path = path;
+        m_header = header;
+        m_entries = entries;
+        m_paths = reinterpret_cast<const char*>(data + header->pathsOffset);
+        return true;
+    }
+
+    void AssetPack::Close() {
+        {
+            std::lock_guard lock(m_dataMutex);
+            m_decompressed.clear();
+        }
+
+        m_file.Close();
+        m_path.clear();
+        m_header = nullptr;
+        m_entries = nullptr;
+        m_paths = nullptr;
+    }
+
+    bool AssetPack::IsOpen() const {
+        return m_header != nullptr;
+    }
+
+    const SystemFilePath& AssetPack::GetPath() const {
+        return m_path;
+    }
+
+    size_t AssetPack::GetEntryCount() const {
+        return (m_header) ? m_header->entryCount : 0;
+    }
+
+    std::string_view AssetPack::GetEntryPath(size_t index) const {
+        if (index >= GetEntryCount())
+            return {};
+        return GetEntryPath(m_entries[index]);
+    }
+
+    bool AssetPack::Contains(std::string_view path) const {
+        return FindEntry(path) != nullptr;
+    }
+
+    size_t AssetPack::GetEntrySize(std::string_view path) const {
+        const Entry* entry = FindEntry(path);
+        return (entry) ? static_cast<size_t>(entry->size) : 0;
+    }
+
+    bool AssetPack::IsCompressed(std::string_view path) const {
+        const Entry* entry = FindEntry(path);
+        return entry && (entry->flags & ENTRY_COMPRESSED) != 0;
+    }
+
+    SDL_IOStream* AssetPack::OpenIO(std::string_view path) const {
+        std::string error;
+        SDL_IOStream* io = OpenIO(path, error);
+        if (!io)
+            SetError(error);
+        return io;
+    }
+
+    SDL_IOStream* AssetPack::OpenIO(std::string_view path, std::string& outError) const {
+        const Entry* entry = FindEntry(path);
+        if (!entry) {
+            outError = FormatUtils::formatString("SDLCore::AssetPack::OpenIO: Entry '{}' does not exist in '{}'",
+                std::string(path), m_path);
+            return nullptr;
+        }
+
+        if (!(entry->flags & ENTRY_COMPRESSED)) {
+            SDL_IOStream* io = SDL_IOFromConstMem(m_file.GetData() + entry->offset, static_cast<size_t>(entry->size));
+            if (!io)
+                outError = FormatUtils::formatString("SDLCore::AssetPack::OpenIO: {}", SDL_GetError());
+            return io;
+        }
+
+        auto* buffer = static_cast<uint8_t*>(SDL_malloc(static_cast<size_t>(entry->size)));
+        if (!buffer) {
+            outError = FormatUtils::formatString("SDLCore::AssetPack::OpenIO: Could not allocate {} bytes for '{}'",
+                entry->size, std::string(path));
+            return nullptr;
+        }
+
+        if (!DecompressEntry(*entry, buffer, outError)) {
+            SDL_free(buffer);
+            return nullptr;
+        }
+
+        SDL_IOStream* io = SDL_IOFromConstMem(buffer, static_cast<size_t>(entry->size));
+        if (!io) {
+            outError = FormatUtils::formatString("SDLCore::AssetPack::OpenIO: {}", SDL_GetError());
+            SDL_free(buffer);
+            return nullptr;
+        }
+
+        // the stream owns the decompressed buffer
+        SDL_SetPointerProperty(SDL_GetIOProperties(io), SDL_PROP_IOSTREAM_MEMORY_FREE_FUNC_POINTER,
+            reinterpret_cast<void*>(SDL_free));
+        return io;
+    }
+
+    const uint8_t* AssetPack::GetData(std::string_view path, size_t& outSize) {
+        outSize = 0;
+        const Entry* entry = FindEntry(path);
+        if (!entry)
+            return nullptr;
+
+        if (!(entry->flags & ENTRY_COMPRESSED)) {
+            outSize = static_cast<size_t>(entry->size);
+            return m_file.GetData() + entry->offset;
+        }
+
+        std::lock_guard lock(m_dataMutex);
+        auto it = m_decompressed.find(entry);
+        if (it == m_decompressed.end()) {
+            std::vector<uint8_t> buffer(static_cast<size_t>(entry->size));
+            std::string error;
+            if (!DecompressEntry(*entry, buffer.data(), error)) {
+                Log::Error("{}", error);
+                return nullptr;
+            }
+            it = m_decompressed.emplace(entry, std::move(buffer)).first;
+        }
+
+        outSize = it->second.size();
+        return it->second.data();
+    }
+
+    bool AssetPack::Verify(std::string_view path) const {
+        const Entry* entry = FindEntry(path);
+        return entry && VerifyEntry(*entry);
+    }
+
+    bool AssetPack::VerifyAll() const {
+        bool result = true;
+        for (size_t i = 0; i < GetEntryCount(); i++) {
+            if (!VerifyEntry(m_entries[i])) {
+                Log::Error("SDLCore::AssetPack::VerifyAll: Entry '{}' of '{}' is corrupted!",
+                    std::string(GetEntryPath(m_entries[i])), m_path);
+                result = false;
+            }
+        }
+        return result;
+    }
+
+    const Entry* AssetPack::FindEntry(std::string_view path) const {
+        if (!m_header)
+            return nullptr;
+
+        const std::string name = NormalizePath(path);
+        const uint64_t hash = HashPath(name);
+
+        const Entry* end = m_entries + m_header->entryCount;
+        const Entry* it = std::lower_bound(m_entries, end, hash,
+            [](const Entry& entry, uint64_t value) { return entry.pathHash < value; });
+
+        // entries with the same hash are told apart by their name
+        for (; it != end && it->pathHash == hash; ++it) {
+            if (GetEntryPath(*it) == name)
+                return it;
+        }
+        return nullptr;
+    }
+
+    std::string_view AssetPack::GetEntryPath(const Entry& entry) const {
+        return std::string_view(m_paths + entry.pathOffset, entry.pathLength);
+    }
+
+    bool AssetPack::VerifyEntry(const Entry& entry) const {
+        return Checksum(m_file.GetData() + entry.offset, static_cast<size_t>(entry.storedSize)) == entry.checksum;
+    }
+
+    bool AssetPack::DecompressEntry(const Entry& entry, uint8_t* out, std::string& outError) const {
+        const uint8_t* src = m_file.GetData() + entry.offset;
+        if (!Decompress(src, static_cast<size_t>(entry.storedSize), out, static_cast<size_t>(entry.size))) {
+            outError = FormatUtils::formatString("SDLCore::AssetPack: Entry '{}' of '{}' is corrupted, could not decompress it",
+                std::string(GetEntryPath(entry)), m_path);
+            return false;
+        }
+        return true;
+    }
+
+}
@@ -0,0 +1,191 @@
+#include <limits>
+#include <algorithm>
+#include <filesystem>
+#include <SDL3/SDL.h>
+
+#include "SDLCoreError.h"
+#include "Internal/AssetPackFormat.h"
+#include "Types/AssetPackWriter.h"
+
+namespace SDLCore {
+
+    using namespace AssetPackFormat;
+
+    bool AssetPackWriter::AddFile(const SystemFilePath& file, std::string_view entryPath, bool compress) {
+        size_t size = 0;
+        void* data = SDL_LoadFile(file.string().c_str(), &size);
+        if (!data) {
+            SetErrorF("SDLCore::AssetPackWriter::AddFile: Could not read '{}': {}", file, SDL_GetError());
+            return false;
+        }
+
+        bool result = AddData(entryPath, data, size, compress);
+        SDL_free(data);
+        return result;
+    }
+
+    bool AssetPackWriter::AddDirectory(const SystemFilePath& dir, bool compress) {
+        std::error_code ec;
+        std::filesystem::recursive_directory_iterator it(dir, ec);
+        if (ec) {
+            SetErrorF("SDLCore::AssetPackWriter::AddDirectory: Could not open '{}': {}", dir, ec.message());
+            return false;
+        }
+
+        // sorted so the same directory always gives the same pack
+        std::vector<SystemFilePath> files;
+        for (const auto& entry : it) {
+            if (entry.is_regular_file(ec))
+                files.push_back(entry.path());
+        }
+        std::sort(files.begin(), files.end());
+
+        for (const auto& file : files) {
+            if (!AddFile(file, file.lexically_relative(dir).generic_string(), compress))
+                return false;
+        }
+        return true;
+    }
+
+    bool AssetPackWriter::AddData(std::string_view entryPath, const void* data, size_t size, bool compress) {
+        std::string path = NormalizePath(entryPath);
+        if (path.empty()) {
+            SetError("SDLCore::AssetPackWriter::AddData: Entry name is empty");
+            return false;
+        }
+
+        if (!m_paths.insert(path).second) {
+            SetErrorF("SDLCore::AssetPackWriter::AddData: Entry '{}' was already added", path);
+            return false;
+        }
+
+        PendingEntry entry;
+        entry.path = std::move(path);
+        entry.size = size;
+
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        // the compressor addresses positions with 32 bit
+        if (compress && size > 0 && size <= std::numeric_limits<uint32_t>::max()) {
+            Compress(bytes, size, entry.data);
+            entry.compressed = entry.data.size() <= static_cast<size_t>(size * MAX_COMPRESSION_RATIO);
+        }
+
+        if (!entry.compressed)
+            entry.data.assign(bytes, bytes + size);
+
+        m_entries.push_back(std::move(entry));
+        return true;
+    }
+
+    bool AssetPackWriter::Write(const SystemFilePath& path) const {
+        auto align = [](uint64_t value) {
+            return (value + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+        };
+
+        std::vector<Entry> index;
+        std::string paths;
+        index.reserve(m_entries.size());
+
+        uint64_t offset = align(sizeof(Header));
+        for (const auto& pending : m_entries) {
+            Entry entry;
+            entry.pathHash = HashPath(pending.path);
+            entry.offset = offset;
+            entry.storedSize = pending.data.size();
+            entry.size = pending.size;
+            entry.checksum = Checksum(pending.data.data(), pending.data.size());
+            entry.pathOffset = static_cast<uint32_t>(paths.size());
+            entry.pathLength = static_cast<uint32_t>(pending.path.size());
+            entry.flags = (pending.compressed) ? static_cast<uint32_t>(ENTRY_COMPRESSED) : 0u;
+            index.push_back(entry);
+
+            paths += pending.path;
+            offset = align(offset + entry.storedSize);
+        }
+
+        // the data stays in the order it was added, only the index is sorted for the lookup
+        std::vector<size_t> order(index.size());
+        for (size_t i = 0; i < order.size(); i++)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            if (index[a].pathHash != index[b].pathHash)
+                return index[a].pathHash < index[b].pathHash;
+            return m_entries[a].path < m_entries[b].path;
+        });
+
+        std::vector<uint8_t> indexData(index.size() * sizeof(Entry) + paths.size());
+        for (size_t i = 0; i < order.size(); i++)
+            SDL_memcpy(indexData.data() + i * sizeof(Entry), &index[order[i]], sizeof(Entry));
+        SDL_memcpy(indexData.data() + index.size() * sizeof(Entry), paths.data(), paths.size());
+
+        Header header;
+        header.entryCount = static_cast<uint32_t>(index.size());
+        header.indexOffset = offset;
+        header.pathsOffset = offset + index.size() * sizeof(Entry);
+        header.pathsSize = paths.size();
+        header.indexChecksum = Checksum(indexData.data(), indexData.size());
+
+        std::error_code ec;
+        if (path.has_parent_path())
+            std::filesystem::create_directories(path.parent_path(), ec);
+
+        // written to a temporary file first, a failed write never leaves a half written pack
+        SystemFilePath tempFile = path;
+        tempFile += ".tmp";
+        SDL_IOStream* io = SDL_IOFromFile(tempFile.string().c_str(), "wb");
+        if (!io) {
+            SetErrorF("SDLCore::AssetPackWriter::Write: Could not write '{}': {}", path, SDL_GetError());
+            return false;
+        }
+
+        static const uint8_t padding[DATA_ALIGNMENT] = {};
+        auto writePadding = [&](uint64_t written) {
+            size_t count = static_cast<size_t>(align(written) - written);
+            return count == 0 || SDL_WriteIO(io, padding, count) == count;
+        };
+
+        bool ok = SDL_WriteIO(io, &header, sizeof(header)) == sizeof(header);
+        ok = ok && writePadding(sizeof(header));
+        for (size_t i = 0; i < m_entries.size() && ok; i++) {
+            const auto& data = m_entries[i].data;
+            ok = data.empty() || SDL_WriteIO(io, data.data(), data.size()) == data.size();
+            ok = ok && writePadding(index[i].offset + data.size());
+        }
+        ok = ok && SDL_WriteIO(io, indexData.data(), indexData.size()) == indexData.size();
+
+        if (!ok)
+            SetErrorF("SDLCore::AssetPackWriter::Write: Could not write '{}': {}", path, SDL_GetError());
+        ok = SDL_CloseIO(io) && ok;
+
+        if (ok) {
+            std::filesystem::rename(tempFile, path, ec);
+            if (ec) {
+                SetErrorF("SDLCore::AssetPackWriter::Write: Could not replace '{}': {}", path, ec.message());
+                ok = false;
+            }
+        }
+
+        if (!ok)
+            std::filesystem::remove(tempFile, ec);
+        return ok;
+    }
+
+    size_t AssetPackWriter::GetEntryCount() const {
+        return m_entries.size();
+    }
+
+    size_t AssetPackWriter::GetStoredSize() const {
+        size_t size = 0;
+        for (const auto& entry : m_entries)
+            size += entry.data.size();
+        return size;
+    }
+
+    size_t AssetPackWriter::GetOriginalSize() const {
+        size_t size = 0;
+        for (const auto& entry : m_entries)
+            size += static_cast<size_t>(entry.size);
+        return size;
+    }
+
+}
@@ -2,6 +2,7 @@
 #include "Application.h"
 #include "Types/Audio/SoundManager.h"
 #include "Types/Audio/SoundClip.h"
+#include "Types/AssetPack.h"
 
 namespace SDLCore {
 
@@ -10,6 +11,19 @@ namespace SDLCore {
         LoadSound(filePath, type);
 	}
 
+    SoundClip::SoundClip(const AssetPack& pack, std::string_view path, SoundType type)
+        : m_path(std::string(path)) {
+        std::string error;
+        MIX_Audio* audio = DecodeAudio(pack, path, type, error);
+        if (!audio) {
+            SetError(error);
+            return;
+        }
+
+        if (!RegisterAudio(audio))
+            AddError("\nSDLCore::SoundClip: Failed to create audio from asset pack!");
+    }
+
     SoundClip::SoundClip(const SoundClip& other) {
         // copy all trivial member data
         m_id = other.m_id;
@@ -211,19 +225,65 @@ namespace SDLCore {
     }
 
     bool SoundClip::LoadSound(const SystemFilePath& path, SoundType type) {
+        std::string error;
+        MIX_Audio* audio = DecodeAudio(path, type, error);
+        if (!audio) {
+            SetError(error);
+            return false;
+        }
+
+        if (!RegisterAudio(audio)) {
+            AddError("\nSDLCore::SoundClip::LoadSound: Failed to create static audio!");
+            return false;
+        }
+        return true;
+	}
+
+    MIX_Audio* SoundClip::DecodeAudio(const SystemFilePath& path, SoundType type, std::string& outError) {
         File file{ path };
         if (!file.Exists()) {
-            SetErrorF("SDLCore::SoundClip::LoadSound: Failed to load audio, file '{}' dose not exist!", 
+            outError = FormatUtils::formatString("SDLCore::SoundClip::LoadSound: Failed to load audio, file '{}' dose not exist!", 
                 path);
-            return false;
+            return nullptr;
         }
 
         std::string strPath = path.string();
-        MIX_Audio* tempAudio = MIX_LoadAudio(nullptr, strPath.c_str(), true);
-        if (!tempAudio) {
-            SetErrorF("SDLCore::SoundClip::LoadSound: Failed to load audio '{}'!\n{}", path, std::string(SDL_GetError()));
-            return false;
-        }
+        auto openIO = [&strPath](std::string& error) -> SDL_IOStream* {
+            SDL_IOStream* io = SDL_IOFromFile(strPath.c_str(), "rb");
+            if (!io)
+                error = SDL_GetError();
+            return io;
+        };
+        return DecodeAudioIO(strPath, openIO, type, outError);
+    }
+
+    MIX_Audio* SoundClip::DecodeAudio(const AssetPack& pack, std::string_view path, SoundType type, std::string& outError) {
+        auto openIO = [&pack, path](std::string& error) {
+            return pack.OpenIO(path, error);
+        };
+        return DecodeAudioIO(std::string(path), openIO, type, outError);
+    }
+
+    MIX_Audio* SoundClip::DecodeAudioIO(const std::string& name, const std::function<SDL_IOStream*(std::string& outError)>& openIO,
+        SoundType type, std::string& outError) 
+    {
+        auto loadAudio = [&](bool predecode) -> MIX_Audio* {
+            std::string ioError;
+            SDL_IOStream* io = openIO(ioError);
+            if (!io) {
+                outError = FormatUtils::formatString("SDLCore::SoundClip::LoadSound: Failed to load audio '{}'!\n{}", name, ioError);
+                return nullptr;
+            }
+
+            MIX_Audio* audio = MIX_LoadAudio_IO(nullptr, io, predecode, true);
+            if (!audio)
+                outError = FormatUtils::formatString("SDLCore::SoundClip::LoadSound: Failed to load audio '{}'!\n{}", name, std::string(SDL_GetError()));
+            return audio;
+        };
+
+        MIX_Audio* tempAudio = loadAudio(true);
+        if (!tempAudio)
+            return nullptr;
 
         m_frameCount = MIX_GetAudioDuration(tempAudio);
 
@@ -236,9 +296,6 @@ namespace SDLCore {
             m_durationMS = static_cast<float>(m_frameCount) * 1000.0f / static_cast<float>(m_frequency);
         else
             m_durationMS = 0.0f;
-        
-        MIX_DestroyAudio(tempAudio);
-        tempAudio = nullptr;
 
         if (type == SoundType::AUTO) {
             if (m_frameCount == MIX_DURATION_UNKNOWN || m_frameCount == MIX_DURATION_INFINITE) {
@@ -249,25 +306,19 @@ namespace SDLCore {
                     SoundType::PREDECODED : SoundType::NOT_PREDECODED;
             }
         }
-        
-        bool predecode = (type == SoundType::PREDECODED);
-        if (!CreateStaticAudio(strPath.c_str(), predecode)) {
-            AddError("\nSDLCore::SoundClip::LoadSound: Failed to create static audio!");
-            return false;
-        }
-
         m_type = type;
-        return true;
-	}
 
-    bool SoundClip::CreateStaticAudio(const char* path, bool predecode) {
-        MIX_Audio* audio = MIX_LoadAudio(nullptr, path, predecode);
-        if (!audio) {
-            SetErrorF("SDLCore::SoundClip::CreateStaticAudio: Failed to load audio '{}'! \n{}", 
-                path, SDL_GetError());
-            return false;
-        }
+        // the probe is already decoded
+        if (type == SoundType::PREDECODED)
+            return tempAudio;
+
+        MIX_DestroyAudio(tempAudio);
+        tempAudio = nullptr;
+
+        return loadAudio(false);
+    }
 
+    bool SoundClip::RegisterAudio(MIX_Audio* audio) {
         // frees the old id if it exits
         if (m_id != SDLCORE_INVALID_ID) {
             idManager.FreeUniqueIdentifier(m_id.value);
@@ -276,7 +327,8 @@ namespace SDLCore {
 
         // gives owner ship to Sound manager;
         if (!SoundManager::CreateSound(m_id, audio)) {
-            AddError("\nSDLCore::SoundClip::CreateStaticAudio: Could not add sound to sound manager!");
+            AddError("\nSDLCore::SoundClip::RegisterAudio: Could not add sound to sound manager!");
+            MIX_DestroyAudio(audio);
             return false;
         }
 
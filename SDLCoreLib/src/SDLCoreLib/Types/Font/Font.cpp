@@ -1,8 +1,14 @@
+#include <cmath>
+#include <algorithm>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <CoreLib/Log.h>
 #include <CoreLib/File.h>
 
+#include "Internal/FontManager.h"
+#include "Internal/FontAssetCache.h"
+#include "Internal/FontAtlasDiskCache.h"
 #include "Types/Font/Nurom_Bold_ttf.h"
+#include "Types/AssetPack.h"
 #include "Types/Font/Font.h"
 
 namespace SDLCore {
@@ -47,6 +53,33 @@ namespace SDLCore {
 		CalculateCachedFonts();
 	}
 
+	Font::Font(AssetPack& pack, std::string_view path, std::vector<float> fontSizes, size_t cachedSizes)
+		: m_maxFontSizesCached(cachedSizes) {
+
+		size_t dataSize = 0;
+		const uint8_t* data = pack.GetData(path, dataSize);
+		if (!data) {
+			Log::Warn("SDLCore::Font(FromPack): Entry '{}' could not be read from '{}', used fallback font!", std::string(path), pack.GetPath());
+			SetDefaultFont(true);
+		}
+		else {
+			SetFontData(data, dataSize);
+		}
+
+		if (m_maxFontSizesCached < fontSizes.size()) {
+			Log::Warn("SDLCore::Font(FromPack): The number of predefined font sizes '{}' exceeds the configured cache size '{}'. Some sizes may not be cached.",
+				fontSizes.size(), m_maxFontSizesCached);
+		}
+
+		for (float size : fontSizes) {
+			if (!CreateFontAsset(size)) {
+				Log::Error("SDLCore::Font: Could not create Font with size {}!", size);
+			}
+		}
+
+		CalculateCachedFonts();
+	}
+
 	Font* Font::SelectSize(float size) {
 		if (size <= 0) {
 			Log::Warn("SDLCore::Font::SelectSize: Cant select font size '{}', size must be > 0!", size);
@@ -63,7 +96,9 @@ namespace SDLCore {
 		}
 
 		// is for font caching (LRU)
-		fontAsset->m_lastUseTick = m_globalAccessCounter;
+		auto it = m_fontAssets.find(GetAssetSize(size));
+		if (it != m_fontAssets.end())
+			it->second.lastUseTick = m_globalAccessCounter;
 		m_globalAccessCounter++;
 		CalculateCachedFonts();
 
@@ -110,10 +145,29 @@ namespace SDLCore {
 		return Clear();
 	}
 
+	Font* Font::SetSDF(bool active) {
+		if (m_sdf == active)
+			return this;
+		m_sdf = active;
+		return Clear();
+	}
+
+	Font* Font::SetStyle(Uint32 style) {
+		if (m_style == style)
+			return this;
+		m_style = style;
+		return Clear();
+	}
+
 	Font* Font::Clear() {
+		bool released = !m_fontAssets.empty();
 		m_fontAssets.clear();
 		m_selectedSize = -1;
 		m_globalAccessCounter = 0;
+		// released assets are only destroyed if the shared cache is over budget.
+		// A font without assets does not touch the cache, the AssetLoader creates fonts on its threads
+		if (released)
+			FontAssetCache::GetInstance().Trim();
 		return this;
 	}
 
@@ -122,16 +176,24 @@ namespace SDLCore {
 	}
 
 	FontAsset* Font::GetFontAsset(float size) {
-		auto it = std::find_if(m_fontAssets.begin(), m_fontAssets.end(),
-			[size](const FontAsset& fontAsset) { return fontAsset.m_fontSize == size; });
+		size = GetAssetSize(size);
 
-		if (it != m_fontAssets.end())
-			return &(*it);
+		auto it = m_fontAssets.find(size);
+		if (it == m_fontAssets.end()) {
+			if (!CreateFontAsset(size))
+				return nullptr;
+
+			it = m_fontAssets.find(size);
+			if (it == m_fontAssets.end())
+				return nullptr;
+		}
 
-		if (!CreateFontAsset(size))
-			return nullptr;
+		FontAsset* asset = it->second.asset.get();
+		if (!asset->IsPending())
+			return asset;
 
-		return &m_fontAssets.back();
+		FontAsset* placeholder = GetNearestReadyFontAsset(size);
+		return (placeholder) ? placeholder : asset;
 	}
 
 	float Font::GetSelectedSize() const {
@@ -154,6 +216,137 @@ namespace SDLCore {
 		return m_fontAssets.size();
 	}
 
+	bool Font::IsSDF() const {
+		return m_sdf;
+	}
+
+	Uint32 Font::GetStyle() const {
+		return m_style;
+	}
+
+	void Font::SetSharedCacheBudget(size_t bytes) {
+		FontAssetCache::GetInstance().SetBudget(bytes);
+	}
+
+	size_t Font::GetSharedCacheBudget() {
+		return FontAssetCache::GetInstance().GetBudget();
+	}
+
+	size_t Font::GetSharedCacheMemoryUsage() {
+		return FontAssetCache::GetInstance().GetMemoryUsage();
+	}
+
+	size_t Font::GetNumberOfSharedFontAssets() {
+		return FontAssetCache::GetInstance().GetAssetCount();
+	}
+
+	void Font::SetAtlasCacheDirectory(const SystemFilePath& dir) {
+		FontAtlasDiskCache::SetDirectory(dir);
+	}
+
+	SystemFilePath Font::GetAtlasCacheDirectory() {
+		return FontAtlasDiskCache::GetDirectory();
+	}
+
+	float Font::GetAssetSize(float size) const {
+		// one distance field asset serves every size
+		return (m_sdf && size > 0) ? SDF_BASE_SIZE : size;
+	}
+
+	FontAssetKey Font::GetAssetKey(float assetSize) const {
+		FontAssetKey key;
+		if (m_loadedFromMem) {
+			key.data = m_fontData;
+			key.dataSize = m_fontDataSize;
+		}
+		else if (m_isFilePathInvalidValid) {
+			key.data = StaticFont::Fallback_ttf;
+			key.dataSize = StaticFont::Fallback_ttf_len;
+		}
+		else {
+			key.path = m_path.lexically_normal().string();
+		}
+		key.size = assetSize;
+		key.style = m_style;
+		key.sdf = m_sdf;
+		return key;
+	}
+
+	bool Font::DecodeFontAsset(float size, std::shared_ptr<FontAsset>& outAsset, std::string& outError) const {
+		float assetSize = GetAssetSize(size);
+		if (assetSize <= 0) {
+			outError = FormatUtils::formatString("Font size '{}' is equal or less than zero", size);
+			return false;
+		}
+
+		// a cached asset is acquired on the main thread
+		FontAssetKey key = GetAssetKey(assetSize);
+		if (FontAssetCache::GetInstance().Contains(key))
+			return true;
+
+		FontManager& fontManager = FontManager::GetInstance();
+		TTF_Font* font = (key.data) ?
+			fontManager.OpenFontFromMem(key.data, key.dataSize, assetSize) :
+			fontManager.OpenFont(key.path, assetSize);
+		if (!font) {
+			outError = FormatUtils::formatString("Could not open font with size '{}': {}", assetSize, SDL_GetError());
+			return false;
+		}
+
+		TTF_SetFontStyle(font, m_style);
+		outAsset = FontAssetCache::CreateAsset(key, font);
+		outAsset->GenerateAtlas();
+		return true;
+	}
+
+	void Font::AddDecodedFontAsset(float size, std::shared_ptr<FontAsset> asset) {
+		float assetSize = GetAssetSize(size);
+		FontAssetKey key = GetAssetKey(assetSize);
+		if (AcquireSharedFontAsset(key))
+			return;
+
+		// the cached asset was destroyed since the decode
+		if (!asset) {
+			CreateFontAsset(assetSize);
+			return;
+		}
+
+		m_fontAssets[assetSize].asset = FontAssetCache::GetInstance().Insert(key, std::move(asset));
+	}
+
+	bool Font::AcquireSharedFontAsset(const FontAssetKey& key) {
+		std::shared_ptr<FontAsset> asset = FontAssetCache::GetInstance().Get(key);
+		if (!asset)
+			return false;
+
+		m_fontAssets[key.size].asset = std::move(asset);
+		return true;
+	}
+
+	FontAsset* Font::GetNearestReadyFontAsset(float size) const {
+		FontAsset* nearest = nullptr;
+		float nearestDiff = 0.0f;
+		for (const auto& [assetSize, ref] : m_fontAssets) {
+			if (!ref.asset->IsReady())
+				continue;
+
+			float diff = std::abs(assetSize - size);
+			if (!nearest || diff < nearestDiff) {
+				nearest = ref.asset.get();
+				nearestDiff = diff;
+			}
+		}
+		return nearest;
+	}
+
+	void Font::AddSharedFontAsset(const FontAssetKey& key, TTF_Font* font) {
+		TTF_SetFontStyle(font, m_style);
+
+		// the first size is generated directly, later sizes have a placeholder to draw with
+		bool deferred = GetNearestReadyFontAsset(key.size) != nullptr;
+		m_fontAssets[key.size].asset = FontAssetCache::GetInstance().Add(key, font, deferred);
+	}
+
 	// could create multiple fontassets with the same size
 	bool Font::CreateFontAsset(float size) {
 		if (!m_loadedFromMem && m_isFilePathInvalidValid) {
@@ -172,34 +365,38 @@ namespace SDLCore {
 		if (m_loadedFromMem) {
 			return CreateFontAssetFromMem(m_fontData, m_fontDataSize, size);
 		}
+
+		FontAssetKey key = GetAssetKey(size);
+		if (AcquireSharedFontAsset(key))
+			return true;
 		
-		TTF_Font* font = TTF_OpenFont(m_path.string().c_str(), size);
+		TTF_Font* font = FontManager::GetInstance().OpenFont(key.path, size);
 		if (!font) {
 			Log::Error("SDLCore::Font::CreateFontAsset: Could not create FontAsset with size '{}': {}", size, SDL_GetError());
 			return false;
 		}
 
-		m_fontAssets.emplace_back(font, size);
+		AddSharedFontAsset(key, font);
 		return true;
 	}
 
 	bool Font::CreateFontAssetFromMem(const unsigned char* data, size_t dataSize, float fontSize) {
-		SDL_IOStream* io = SDL_IOFromMem(
-			const_cast<unsigned char*>(data), dataSize
-		);
-
-		if (!io) {
-			Log::Error("SDLCore::Font::CreateFontAssetFromMem: Could not create FontAsset with size '{}', io is nullptr: {}", fontSize, SDL_GetError());
-			return false;
-		}
+		FontAssetKey key;
+		key.data = data;
+		key.dataSize = dataSize;
+		key.size = fontSize;
+		key.style = m_style;
+		key.sdf = m_sdf;
+		if (AcquireSharedFontAsset(key))
+			return true;
 
-		TTF_Font* font = TTF_OpenFontIO(io, 1, fontSize);
+		TTF_Font* font = FontManager::GetInstance().OpenFontFromMem(data, dataSize, fontSize);
 		if (!font) {
 			Log::Error("SDLCore::Font::CreateFontAssetFromMem: Could not create FontAsset with size '{}': {}", fontSize, SDL_GetError());
 			return false;
 		}
 
-		m_fontAssets.emplace_back(font, fontSize);
+		AddSharedFontAsset(key, font);
 		return true;
 	}
 
@@ -214,16 +411,21 @@ namespace SDLCore {
 			return;
 
 		size_t diff = m_fontAssets.size() - m_maxFontSizesCached;
-		std::sort(m_fontAssets.begin(), m_fontAssets.end(),
-			[](const FontAsset& a, const FontAsset& b) { return a.m_lastUseTick > b.m_lastUseTick; });
+		std::vector<std::pair<size_t, float>> sizesByUse;
+		sizesByUse.reserve(m_fontAssets.size());
+		for (const auto& [size, ref] : m_fontAssets)
+			sizesByUse.emplace_back(ref.lastUseTick, size);
 
-		m_fontAssets.erase(m_fontAssets.end() - diff, m_fontAssets.end());
+		std::sort(sizesByUse.begin(), sizesByUse.end());
+		for (size_t i = 0; i < diff; i++)
+			m_fontAssets.erase(sizesByUse[i].second);
 
-		float selectedSize = m_selectedSize;
-		if (std::find_if(m_fontAssets.begin(), m_fontAssets.end(),
-			[selectedSize](const FontAsset& asset) { return asset.m_fontSize == selectedSize; }) == m_fontAssets.end()) {
+		if (m_fontAssets.find(GetAssetSize(m_selectedSize)) == m_fontAssets.end()) {
 			m_selectedSize = -1;
 		}
+
+		// the released assets stay in the shared cache while it is within budget
+		FontAssetCache::GetInstance().Trim();
 	}
 
 	void Font::CheckFilePath(const SystemFilePath& path) {
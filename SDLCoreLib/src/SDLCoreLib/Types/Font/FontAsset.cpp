@@ -1,28 +1,36 @@
 #include <memory>
+#include <algorithm>
+#include <filesystem>
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 
 #include <CoreLib/Log.h>
 
 #include "Application.h"
+#include "SDLCoreTime.h"
+#include "Internal/MappedFile.h"
+#include "Internal/FontAtlasDiskCache.h"
 #include "Types/Font/FontAsset.h"
 
 namespace SDLCore {
 
-	FontAsset::FontAsset(TTF_Font* font, float size)
-		: m_font(font), m_fontSize(size) {
+	FontAsset::FontAsset(TTF_Font* font, float size, bool sdf, bool deferred)
+		: m_font(font), m_fontSize(size), m_sdf(sdf) {
         if (font) {
+            if (sdf && !TTF_SetFontSDF(font, true)) {
+                Log::Warn("SDLCore::FontAsset: Could not enable SDF for font '{}', glyphs are rasterized normally: {}",
+                    TTF_GetFontFamilyName(font), SDL_GetError());
+                m_sdf = false;
+            }
             m_ascent = TTF_GetFontAscent(font);
             m_descent = TTF_GetFontDescent(font);
             m_lineSkip = TTF_GetFontLineSkip(font);
-            m_glyphAtlasSurf = GenerateGlypeAtlas(font, size);
-            if (m_glyphAtlasSurf.IsInvalid()) {
-                Log::Error("SDLCore::FontAsset: Font asset of font '{}' with size '{}' can not be used, glyph atlas was not generated",
-                    TTF_GetFontFamilyName(font), size);
-            }
+            if (!deferred)
+                GenerateAtlas();
         }
         else {
             Log::Error("SDLCore::FontAsset:  Font asset with size '{}' can not be used, the given Font is a nullptr", size);
+            m_state = State::FAILED;
         }
 	}
 
@@ -48,20 +56,198 @@ namespace SDLCore {
 		return *this;
 	}
 
+    namespace {
+        constexpr int GLYPH_PADDING = 1;// transparent border right and below every glyph
+        constexpr int SDF_EDGE_VALUE = 128;// distance value on the glyph outline
+
+        /*
+        * Remaps the distance field of a glyph to a one pixel alpha ramp centered on the edge.
+        * The renderer multiplies the alpha with the text scale, after bilinear filtering this
+        * acts as an alpha threshold and keeps the edge one screen pixel wide at every size.
+        */
+        SDL_Surface* ConvertSDFGlyph(SDL_Surface* glyphSurf) {
+            SDL_Surface* converted = SDL_ConvertSurface(glyphSurf, SDL_PIXELFORMAT_RGBA32);
+            if (!converted)
+                return nullptr;
+
+            std::array<Uint8, 256> ramp;
+            const float pixelsPerValue = (2.0f * FontAsset::SDF_SPREAD) / 255.0f;
+            for (int d = 0; d < 256; ++d) {
+                float alpha = (d - SDF_EDGE_VALUE) * pixelsPerValue + 0.5f;
+                ramp[d] = static_cast<Uint8>(std::clamp(alpha, 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+
+            for (int y = 0; y < converted->h; ++y) {
+                Uint8* row = static_cast<Uint8*>(converted->pixels) + y * converted->pitch;
+                for (int x = 0; x < converted->w; ++x) {
+                    Uint8* px = row + x * 4;
+                    px[0] = 255;
+                    px[1] = 255;
+                    px[2] = 255;
+                    px[3] = ramp[px[3]];
+                }
+            }
+
+            return converted;
+        }
+
+        /*
+        * Layout of an atlas cache file (native byte order, the cache is local to the machine):
+        * AtlasCacheHeader, glyphCount * AtlasCacheGlyph, then per page AtlasCachePage,
+        * shelfCount * AtlasCacheShelf and pageSize * pageSize alpha values.
+        * All glyphs are white, only the alpha channel is stored
+        */
+        constexpr uint32_t ATLAS_CACHE_MAGIC = 0x43414653;// "SFAC"
+
+        struct AtlasCacheHeader {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t id;
+            float size;
+            int32_t sdf;
+            int32_t ascent;
+            int32_t descent;
+            int32_t lineSkip;
+            int32_t pageSize;
+            uint32_t pageCount;
+            uint32_t glyphCount;
+        };
+
+        struct AtlasCacheGlyph {
+            uint32_t code;
+            int32_t minX, maxX, minY, maxY, advance;
+            int32_t atlasX, atlasY, atlasWidth, atlasHeight, atlasPage;
+        };
+
+        struct AtlasCachePage {
+            int32_t shelfBottom;
+            uint32_t shelfCount;
+        };
+
+        struct AtlasCacheShelf {
+            int32_t y, height, cursorX;
+        };
+
+        class CacheReader {
+        public:
+            CacheReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+            template<typename T>
+            bool Read(T& out) {
+                return ReadBytes(&out, sizeof(T));
+            }
+
+            bool ReadBytes(void* out, size_t size) {
+                const uint8_t* src = Skip(size);
+                if (!src)
+                    return false;
+                SDL_memcpy(out, src, size);
+                return true;
+            }
+
+            const uint8_t* Skip(size_t size) {
+                if (size > m_size - m_offset)
+                    return nullptr;
+                const uint8_t* src = m_data + m_offset;
+                m_offset += size;
+                return src;
+            }
+
+        private:
+            const uint8_t* m_data;
+            size_t m_size;
+            size_t m_offset = 0;
+        };
+    }
+
+    uint64_t FontAsset::GetID() const {
+        return m_id;
+    }
+
+    uint64_t FontAsset::NextID() {
+        static std::atomic<uint64_t> s_nextID{ 1 };
+        return s_nextID.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool FontAsset::IsReady() const {
+        return m_state.load(std::memory_order_acquire) == State::READY;
+    }
+
+    bool FontAsset::IsPending() const {
+        return m_state.load(std::memory_order_acquire) == State::PENDING;
+    }
+
     GlyphMetrics* FontAsset::GetGlyphMetrics(uint32_t code) {
+        // the worker thread still owns the atlas
+        if (!IsReady())
+            return nullptr;
+
         if (code < 256 && m_asciiPresent[code])
             return &m_asciiGlyphs[code];
 
+        // control characters and ASCII glyphs that failed on creation
+        if (code < 128 || m_pages.empty())
+            return nullptr;
+
         auto it = m_charToGlyphMetrics.find(code);
-        return (it == m_charToGlyphMetrics.end()) ? nullptr : &it->second;
+        if (it != m_charToGlyphMetrics.end()) {
+            it->second.lastUseFrame = Time::GetFrameCount();
+            return &it->second.metrics;
+        }
+
+        if (m_failedGlyphs.find(code) != m_failedGlyphs.end())
+            return nullptr;
+
+        return RasterizeGlyph(code, false);
     }
 
-    SDL_Texture* FontAsset::GetGlyphAtlasTexture(WindowID winID) {
-        auto it = m_winIDToGlyphAtlasTexture.find(winID);
-        if (it != m_winIDToGlyphAtlasTexture.end())
+    int FontAsset::GetGlyphAdvance(uint32_t code) {
+        if (!IsReady())
+            return NO_GLYPH;
+
+        if (code < 256 && m_asciiPresent[code])
+            return m_asciiGlyphs[code].advance;
+
+        if (code < 128)
+            return NO_GLYPH;
+
+        auto it = m_advances.find(code);
+        if (it != m_advances.end())
+            return it->second;
+
+        // a glyph that does not fit into a full atlas can succeed later, only found advances are kept
+        GlyphMetrics* m = GetGlyphMetrics(code);
+        if (!m)
+            return NO_GLYPH;
+
+        m_advances[code] = m->advance;
+        return m->advance;
+    }
+
+    SDL_Texture* FontAsset::GetGlyphAtlasTexture(WindowID winID, int page) {
+        if (!IsReady() || page < 0 || page >= static_cast<int>(m_pages.size()))
+            return nullptr;
+
+        GlyphPage& glyphPage = m_pages[page];
+        auto it = glyphPage.textures.find(winID);
+        if (it != glyphPage.textures.end()) {
+            // uploads only the area that changed since the last upload
+            auto itDirty = glyphPage.dirtyRects.find(winID);
+            if (itDirty != glyphPage.dirtyRects.end() && itDirty->second.w > 0 && itDirty->second.h > 0) {
+                SDL_Surface* surf = glyphPage.surface.GetSurface();
+                const SDL_Rect& rect = itDirty->second;
+                const Uint8* pixels = static_cast<const Uint8*>(surf->pixels)
+                    + rect.y * surf->pitch + rect.x * SDL_BYTESPERPIXEL(surf->format);
+
+                if (!SDL_UpdateTexture(it->second, &rect, pixels, surf->pitch)) {
+                    Log::Error("SDLCore::FontAsset::GetGlyphAtlasTexture: Failed to update atlas page '{}': {}", page, SDL_GetError());
+                }
+                itDirty->second = SDL_Rect{ 0, 0, 0, 0 };
+            }
             return it->second;
+        }
 
-        SDL_Texture* tex = CreateTextureForWindow(winID);
+        SDL_Texture* tex = CreateTextureForWindow(winID, page);
         if (!tex) {
             auto* app = Application::GetInstance();
             if (app) {
@@ -79,20 +265,65 @@ namespace SDLCore {
         return tex;
     }
 
+    int FontAsset::GetGlyphAtlasPageCount() const {
+        return static_cast<int>(m_pages.size());
+    }
+
+    int FontAsset::GetGlyphAtlasPageSize() const {
+        return m_pageSize;
+    }
+
+    size_t FontAsset::GetMemoryUsage() const {
+        if (!IsReady())
+            return 0;
+
+        const size_t pageBytes = static_cast<size_t>(m_pageSize) * static_cast<size_t>(m_pageSize) * 4;
+        size_t bytes = 0;
+        for (const auto& page : m_pages)
+            bytes += pageBytes * (1 + page.textures.size());
+        return bytes;
+    }
+
     void FontAsset::CopyFrom(const FontAsset& other) noexcept {
+        if (this == &other)
+            return;
+
+        Cleanup();
+
         auto& obj = *this;
         obj.m_fontSize = other.m_fontSize;
         obj.m_lastUseTick = other.m_lastUseTick;
         obj.m_ascent = other.m_ascent;
         obj.m_descent = other.m_descent;
         obj.m_lineSkip = other.m_lineSkip;
+        obj.m_sdf = other.m_sdf;
+        obj.m_state = other.m_state.load();
+        obj.m_atlasCacheFile = other.m_atlasCacheFile;
+        obj.m_atlasCacheID = other.m_atlasCacheID;
 
         obj.m_font = other.m_font;
-        obj.m_glyphAtlasSurf = other.m_glyphAtlasSurf;
+
+        // the pages are modified when glyphs are added, every copy owns its own surfaces.
+        // window textures are created on first use
+        obj.m_pageSize = other.m_pageSize;
+        obj.m_pages.reserve(other.m_pages.size());
+        for (const auto& page : other.m_pages) {
+            GlyphPage copy;
+            copy.shelves = page.shelves;
+            copy.freeSlots = page.freeSlots;
+            copy.shelfBottom = page.shelfBottom;
+            copy.glyphCount = page.glyphCount;
+            copy.pinned = page.pinned;
+            if (SDL_Surface* surf = page.surface.GetSurface())
+                copy.surface = TextureSurface(SDL_DuplicateSurface(surf));
+            obj.m_pages.push_back(std::move(copy));
+        }
 
         obj.m_asciiGlyphs = other.m_asciiGlyphs;
         obj.m_asciiPresent = other.m_asciiPresent;
         obj.m_charToGlyphMetrics = other.m_charToGlyphMetrics;
+        obj.m_failedGlyphs = other.m_failedGlyphs;
+        obj.m_advances = other.m_advances;
     }
 
     void FontAsset::MoveFrom(FontAsset&& other) noexcept {
@@ -104,16 +335,23 @@ namespace SDLCore {
         m_fontSize = other.m_fontSize;
         m_lastUseTick = other.m_lastUseTick;
         m_font = std::move(other.m_font);
-        m_glyphAtlasSurf = std::move(other.m_glyphAtlasSurf);
         m_ascent = other.m_ascent;
         m_descent = other.m_descent;
         m_lineSkip = other.m_lineSkip;
-
+        m_sdf = other.m_sdf;
+        m_state = other.m_state.load();
+        m_atlasCacheFile = std::move(other.m_atlasCacheFile);
+        m_atlasCacheID = other.m_atlasCacheID;
+
+        m_pageSize = other.m_pageSize;
+        m_pages = std::move(other.m_pages);
+        m_atlasFullWarned = other.m_atlasFullWarned;
         m_charToGlyphMetrics = std::move(other.m_charToGlyphMetrics);
+        m_failedGlyphs = std::move(other.m_failedGlyphs);
+        m_advances = std::move(other.m_advances);
         m_asciiGlyphs = std::move(other.m_asciiGlyphs);
         m_asciiPresent = std::move(other.m_asciiPresent);
 
-        m_winIDToGlyphAtlasTexture = std::move(other.m_winIDToGlyphAtlasTexture);
         auto* app = Application::GetInstance();
         for (auto& [winID, cbID] : other.m_winIDToWinCallbackID) {
             if (auto* win = app ? app->GetWindow(winID) : nullptr) {
@@ -128,145 +366,519 @@ namespace SDLCore {
         other.m_fontSize = 0;
         other.m_lastUseTick = 0;
         other.m_font = FontResource();
-        other.m_glyphAtlasSurf = TextureSurface();
         other.m_ascent = 0;
         other.m_descent = 0;
         other.m_lineSkip = 0;
+        other.m_sdf = false;
+        other.m_state = State::FAILED;
+        other.m_pages.clear();
+        other.m_atlasFullWarned = false;
         other.m_charToGlyphMetrics.clear();
+        other.m_failedGlyphs.clear();
+        other.m_advances.clear();
         other.m_asciiGlyphs.fill({});
         other.m_asciiPresent.fill(false);
-        other.m_winIDToGlyphAtlasTexture.clear();
         other.m_winIDToWinCallbackID.clear();
     }
 
 	void FontAsset::Cleanup() {
         if (!IsSDLQuit()) {
-            for (auto& [_, tex] : m_winIDToGlyphAtlasTexture)
-                SDL_DestroyTexture(tex);
+            for (auto& page : m_pages) {
+                for (auto& [_, tex] : page.textures)
+                    SDL_DestroyTexture(tex);
+            }
         }
 
         RemoveAllWindowCloseCB();
 
         m_charToGlyphMetrics.clear();
-        m_winIDToGlyphAtlasTexture.clear();
-
-        m_glyphAtlasSurf = TextureSurface();
+        m_failedGlyphs.clear();
+        m_advances.clear();
+        m_pages.clear();
         m_font = FontResource();
 
 		m_lastUseTick = 0;
 		m_fontSize = 0;
 	}
 
-    TextureSurface FontAsset::GenerateGlypeAtlas(TTF_Font* font, float size) {
+    void FontAsset::GenerateAtlas() {
+        TTF_Font* font = m_font.GetFont();
+        if (font && LoadAtlasCache()) {
+            m_state.store(State::READY, std::memory_order_release);
+            return;
+        }
+
+        if (font && GenerateGlypeAtlas(font)) {
+            SaveAtlasCache();
+            m_state.store(State::READY, std::memory_order_release);
+            return;
+        }
+
+        Log::Error("SDLCore::FontAsset: Font asset of font '{}' with size '{}' can not be used, glyph atlas was not generated",
+            (font) ? TTF_GetFontFamilyName(font) : "", m_fontSize);
+        m_state.store(State::FAILED, std::memory_order_release);
+    }
+
+    bool FontAsset::GenerateGlypeAtlas(TTF_Font* font) {
         if (TTF_GetFontDirection(font) != TTF_DIRECTION_LTR && TTF_GetFontDirection(font) != TTF_DIRECTION_INVALID) {
             Log::Error("SDLCore::FontAsset::GenerateGlypeAtlas: Could not generate glyph atlas of font '{}', current font system only supports left-to-right fonts!",
                 TTF_GetFontFamilyName(font));
-            return nullptr;
+            return false;
         }
 
-        /*
-        * Current Atlas layout is horizontal (row) if more glyps are added
-        * the layout should be changed to quadrat becaus of texture size limits
-        */
         Uint32 firstChar = 32;
         Uint32 lastChar = 126;
-        SDL_Color white = { 255, 255, 255, 255 };
 
-        struct GlyphTemp {
-            Uint32 code;
-            SDL_Surface* surf;
-            GlyphMetrics metrics;
+        /*
+        * The page size is chosen so that the ASCII glyphs use at most half of the first page,
+        * the rest is left for glyphs that are rasterized on demand
+        */
+        int fontHeight = TTF_GetFontHeight(font);
+        long long asciiArea = 0;
+        for (Uint32 c = firstChar; c <= lastChar; ++c) {
+            int advance = 0;
+            if (TTF_GetGlyphMetrics(font, c, nullptr, nullptr, nullptr, nullptr, &advance))
+                asciiArea += static_cast<long long>(advance + GLYPH_PADDING) * (fontHeight + GLYPH_PADDING);
+        }
 
-            GlyphTemp(Uint32 _code, SDL_Surface* _surf, char _c) 
-                : code(_code), surf(_surf), metrics(GlyphMetrics{_c}) {
-            }
+        m_pageSize = MIN_GLYPH_ATLAS_PAGE_SIZE;
+        while (m_pageSize < MAX_GLYPH_ATLAS_PAGE_SIZE &&
+            static_cast<long long>(m_pageSize) * m_pageSize < asciiArea * 2)
+        {
+            m_pageSize *= 2;
+        }
+
+        if (!AddPage())
+            return false;
+
+        bool anyGlyph = false;
+        for (Uint32 c = firstChar; c <= lastChar; ++c) {
+            if (RasterizeGlyph(c, true))
+                anyGlyph = true;
+        }
+
+        if (!anyGlyph) {
+            Log::Error("SDLCore::FontAsset::GenerateGlypeAtlas: No glyphs generated for font '{}'", TTF_GetFontFamilyName(font));
+            m_pages.clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool FontAsset::LoadAtlasCache() {
+        if (m_atlasCacheFile.empty())
+            return false;
+
+        MappedFile file;
+        if (!file.Open(m_atlasCacheFile))
+            return false;
+
+        CacheReader reader(file.GetData(), file.GetSize());
+        AtlasCacheHeader header;
+        if (!reader.Read(header) ||
+            header.magic != ATLAS_CACHE_MAGIC ||
+            header.version != FontAtlasDiskCache::VERSION ||
+            header.id != m_atlasCacheID ||
+            header.size != m_fontSize ||
+            (header.sdf != 0) != m_sdf ||
+            header.pageSize < MIN_GLYPH_ATLAS_PAGE_SIZE || header.pageSize > MAX_GLYPH_ATLAS_PAGE_SIZE ||
+            header.pageCount == 0 || header.pageCount > MAX_GLYPH_ATLAS_PAGES ||
+            header.glyphCount > 256)// only the pinned ASCII glyphs are stored, bounds the allocation below
+        {
+            return false;
+        }
 
-            ~GlyphTemp() {
-                SDL_DestroySurface(surf);
-                surf = nullptr;
+        std::vector<AtlasCacheGlyph> glyphs(header.glyphCount);
+        if (!reader.ReadBytes(glyphs.data(), glyphs.size() * sizeof(AtlasCacheGlyph)))
+            return false;
+
+        m_pageSize = header.pageSize;
+        const size_t pixelCount = static_cast<size_t>(m_pageSize) * static_cast<size_t>(m_pageSize);
+
+        bool valid = true;
+        for (uint32_t i = 0; i < header.pageCount && valid; ++i) {
+            AtlasCachePage pageInfo;
+            valid = reader.Read(pageInfo) && pageInfo.shelfCount <= static_cast<uint32_t>(m_pageSize) && AddPage();
+            if (!valid)
+                break;
+
+            GlyphPage& page = m_pages.back();
+            page.shelfBottom = pageInfo.shelfBottom;
+            page.pinned = true;
+            page.shelves.resize(pageInfo.shelfCount);
+            for (auto& shelf : page.shelves) {
+                AtlasCacheShelf s;
+                if (!reader.Read(s)) {
+                    valid = false;
+                    break;
+                }
+                shelf = GlyphShelf{ s.y, s.height, s.cursorX };
             }
-        };
 
-        std::vector<GlyphTemp> glyphs;
-        glyphs.reserve(lastChar - firstChar + 1);
+            const uint8_t* alpha = (valid) ? reader.Skip(pixelCount) : nullptr;
+            if (!alpha) {
+                valid = false;
+                break;
+            }
 
-        int atlasWidth = 0;
-        int atlasHeight = 0;
-        int spacingX = 2;// horizontal spacing between glyphs
+            SDL_Surface* surf = page.surface.GetSurface();
+            for (int y = 0; y < m_pageSize; ++y) {
+                Uint8* row = static_cast<Uint8*>(surf->pixels) + y * surf->pitch;
+                const uint8_t* src = alpha + static_cast<size_t>(y) * m_pageSize;
+                for (int x = 0; x < m_pageSize; ++x) {
+                    Uint8* px = row + x * 4;
+                    px[0] = 255;
+                    px[1] = 255;
+                    px[2] = 255;
+                    px[3] = src[x];
+                }
+            }
+        }
 
-        for (Uint32 c = firstChar; c <= lastChar; ++c) {
-            SDL_Surface* glyphSurf = TTF_RenderGlyph_Blended(font, c, white);
-            if (!glyphSurf) {
-                Log::Error("SDLCore::FontAsset::GenerateGlypeAtlas: Could not render glyph '{}' for size '{}' of font '{}': {}",
-                    c, size, TTF_GetFontFamilyName(font), SDL_GetError());
-                continue;
+        for (const auto& g : glyphs) {
+            if (!valid)
+                break;
+            if (g.code >= 256 || g.atlasPage < 0 || g.atlasPage >= static_cast<int32_t>(m_pages.size())) {
+                valid = false;
+                break;
             }
 
-            glyphs.emplace_back(c, glyphSurf, static_cast<char>(c));
-            GlyphMetrics& gm = glyphs.back().metrics;
+            GlyphMetrics& gm = m_asciiGlyphs[g.code];
+            gm = GlyphMetrics{ g.code };
+            gm.minX = g.minX;
+            gm.maxX = g.maxX;
+            gm.minY = g.minY;
+            gm.maxY = g.maxY;
+            gm.advance = g.advance;
+            gm.atlasX = g.atlasX;
+            gm.atlasY = g.atlasY;
+            gm.atlasWidth = g.atlasWidth;
+            gm.atlasHeight = g.atlasHeight;
+            gm.atlasPage = g.atlasPage;
+            m_asciiPresent[g.code] = true;
+        }
+
+        if (!valid) {
+            Log::Warn("SDLCore::FontAsset::LoadAtlasCache: Atlas cache file '{}' is invalid, the atlas is generated again", m_atlasCacheFile);
+            m_pages.clear();
+            m_asciiGlyphs.fill({});
+            m_asciiPresent.fill(false);
+            m_pageSize = MIN_GLYPH_ATLAS_PAGE_SIZE;
+            return false;
+        }
+
+        m_ascent = header.ascent;
+        m_descent = header.descent;
+        m_lineSkip = header.lineSkip;
+        return true;
+    }
+
+    bool FontAsset::SaveAtlasCache() const {
+        if (m_atlasCacheFile.empty() || m_pages.empty())
+            return false;
+
+        std::error_code ec;
+        std::filesystem::create_directories(m_atlasCacheFile.parent_path(), ec);
 
-            if (!TTF_GetGlyphMetrics(font, c, &gm.minX, &gm.maxX, &gm.minY, &gm.maxY, &gm.advance)) {
-                Log::Error("SDLCore::FontAsset::GenerateGlypeAtlas: Could not get metrics for '{}' (size '{}', font '{}'): {}",
-                    c, size, TTF_GetFontFamilyName(font), SDL_GetError());
-                // delete the current faild glyph
-                glyphs.pop_back();
-                SDL_DestroySurface(glyphSurf);
+        // written to a temporary file first, a crash never leaves a half written cache file
+        SystemFilePath tempFile = m_atlasCacheFile;
+        tempFile += ".tmp";
+        SDL_IOStream* io = SDL_IOFromFile(tempFile.string().c_str(), "wb");
+        if (!io) {
+            Log::Warn("SDLCore::FontAsset::SaveAtlasCache: Could not write atlas cache '{}': {}", m_atlasCacheFile, SDL_GetError());
+            return false;
+        }
+
+        std::vector<AtlasCacheGlyph> glyphs;
+        for (uint32_t code = 0; code < 256; ++code) {
+            if (!m_asciiPresent[code])
                 continue;
+
+            const GlyphMetrics& gm = m_asciiGlyphs[code];
+            glyphs.push_back(AtlasCacheGlyph{ code,
+                gm.minX, gm.maxX, gm.minY, gm.maxY, gm.advance,
+                gm.atlasX, gm.atlasY, gm.atlasWidth, gm.atlasHeight, gm.atlasPage });
+        }
+
+        AtlasCacheHeader header{};
+        header.magic = ATLAS_CACHE_MAGIC;
+        header.version = FontAtlasDiskCache::VERSION;
+        header.id = m_atlasCacheID;
+        header.size = m_fontSize;
+        header.sdf = m_sdf ? 1 : 0;
+        header.ascent = m_ascent;
+        header.descent = m_descent;
+        header.lineSkip = m_lineSkip;
+        header.pageSize = m_pageSize;
+        header.pageCount = static_cast<uint32_t>(m_pages.size());
+        header.glyphCount = static_cast<uint32_t>(glyphs.size());
+
+        bool ok = SDL_WriteIO(io, &header, sizeof(header)) == sizeof(header);
+        ok = ok && SDL_WriteIO(io, glyphs.data(), glyphs.size() * sizeof(AtlasCacheGlyph)) == glyphs.size() * sizeof(AtlasCacheGlyph);
+
+        std::vector<uint8_t> alpha(static_cast<size_t>(m_pageSize) * static_cast<size_t>(m_pageSize));
+        for (const auto& page : m_pages) {
+            if (!ok)
+                break;
+
+            AtlasCachePage pageInfo{ page.shelfBottom, static_cast<uint32_t>(page.shelves.size()) };
+            ok = SDL_WriteIO(io, &pageInfo, sizeof(pageInfo)) == sizeof(pageInfo);
+            for (const auto& shelf : page.shelves) {
+                AtlasCacheShelf s{ shelf.y, shelf.height, shelf.cursorX };
+                ok = ok && SDL_WriteIO(io, &s, sizeof(s)) == sizeof(s);
             }
 
-            gm.atlasWidth = glyphSurf->w;
-            gm.atlasHeight = glyphSurf->h;
+            SDL_Surface* surf = page.surface.GetSurface();
+            for (int y = 0; y < m_pageSize; ++y) {
+                const Uint8* row = static_cast<const Uint8*>(surf->pixels) + y * surf->pitch;
+                uint8_t* dst = alpha.data() + static_cast<size_t>(y) * m_pageSize;
+                for (int x = 0; x < m_pageSize; ++x)
+                    dst[x] = row[x * 4 + 3];
+            }
+            ok = ok && SDL_WriteIO(io, alpha.data(), alpha.size()) == alpha.size();
+        }
 
-            // Calculates the alts size
-            atlasWidth += gm.atlasWidth + spacingX;
-            atlasHeight = std::max(atlasHeight, glyphSurf->h);
+        ok = SDL_CloseIO(io) && ok;
+        if (ok) {
+            std::filesystem::rename(tempFile, m_atlasCacheFile, ec);
+            ok = !ec;
         }
 
-        if (glyphs.empty()) {
-            Log::Error("SDLCore::FontAsset::GenerateGlypeAtlas: No glyphs generated for font '{}'", TTF_GetFontFamilyName(font));
+        if (!ok) {
+            Log::Warn("SDLCore::FontAsset::SaveAtlasCache: Could not write atlas cache '{}'", m_atlasCacheFile);
+            std::filesystem::remove(tempFile, ec);
+        }
+        return ok;
+    }
+
+    GlyphMetrics* FontAsset::RasterizeGlyph(Uint32 code, bool pinned) {
+        TTF_Font* font = m_font.GetFont();
+        if (!font)
+            return nullptr;
+
+        if (!pinned && !TTF_FontHasGlyph(font, code)) {
+            m_failedGlyphs[code] = true;
             return nullptr;
         }
-        //remove the last spacing
-        atlasWidth -= spacingX;
-        SDL_Surface* atlas = SDL_CreateSurface(atlasWidth, atlasHeight, SDL_PIXELFORMAT_RGBA32);
-        if (!atlas) {
-            Log::Error("SDLCore::FontAsset::GenerateGlypeAtlas: Failed to create atlas surface: {}", SDL_GetError());
+
+        GlyphMetrics gm{ code };
+        if (!TTF_GetGlyphMetrics(font, code, &gm.minX, &gm.maxX, &gm.minY, &gm.maxY, &gm.advance)) {
+            Log::Error("SDLCore::FontAsset::RasterizeGlyph: Could not get metrics for '{}' (size '{}', font '{}'): {}",
+                code, m_fontSize, TTF_GetFontFamilyName(font), SDL_GetError());
+            m_failedGlyphs[code] = true;
             return nullptr;
         }
 
-        int cursorX = 0;
-        for (auto& g : glyphs) {
-            if (!g.surf)
-                continue;
+        SDL_Color white = { 255, 255, 255, 255 };
+        SDL_Surface* glyphSurf = TTF_RenderGlyph_Blended(font, code, white);
+        if (!glyphSurf) {
+            Log::Error("SDLCore::FontAsset::RasterizeGlyph: Could not render glyph '{}' for size '{}' of font '{}': {}",
+                code, m_fontSize, TTF_GetFontFamilyName(font), SDL_GetError());
+            m_failedGlyphs[code] = true;
+            return nullptr;
+        }
 
-            SDL_Rect dst;
-            dst.x = cursorX;
-            dst.y = 0;
-            dst.w = g.surf->w;
-            dst.h = g.surf->h;
+        if (m_sdf) {
+            SDL_Surface* converted = ConvertSDFGlyph(glyphSurf);
+            SDL_DestroySurface(glyphSurf);
+            if (!converted) {
+                Log::Error("SDLCore::FontAsset::RasterizeGlyph: Could not convert SDF glyph '{}' of font '{}': {}",
+                    code, TTF_GetFontFamilyName(font), SDL_GetError());
+                m_failedGlyphs[code] = true;
+                return nullptr;
+            }
+            glyphSurf = converted;
+        }
 
-            SDL_BlitSurface(g.surf, nullptr, atlas, &dst);
+        int pageIndex = 0;
+        SDL_Rect slot{ 0, 0, 0, 0 };
+        if (!AllocateSlot(glyphSurf->w + GLYPH_PADDING, glyphSurf->h + GLYPH_PADDING, pageIndex, slot)) {
+            if (!m_atlasFullWarned) {
+                Log::Warn("SDLCore::FontAsset::RasterizeGlyph: Glyph atlas of font '{}' size '{}' is full, glyphs used in the current frame can not be evicted",
+                    TTF_GetFontFamilyName(font), m_fontSize);
+                m_atlasFullWarned = true;
+            }
+            SDL_DestroySurface(glyphSurf);
+            return nullptr;
+        }
+
+        GlyphPage& page = m_pages[pageIndex];
+        SDL_Surface* atlas = page.surface.GetSurface();
+
+        // the slot can contain an evicted glyph
+        SDL_FillSurfaceRect(atlas, &slot, 0);
+        SDL_Rect dst{ slot.x, slot.y, glyphSurf->w, glyphSurf->h };
+        SDL_SetSurfaceBlendMode(glyphSurf, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(glyphSurf, nullptr, atlas, &dst);
+        SDL_DestroySurface(glyphSurf);
+        MarkPageDirty(page, slot);
+
+        gm.atlasX = dst.x;
+        gm.atlasY = dst.y;
+        gm.atlasWidth = dst.w;
+        gm.atlasHeight = dst.h;
+        gm.atlasPage = pageIndex;
+
+        if (pinned) {
+            page.pinned = true;
+            if (code < 256) {
+                m_asciiGlyphs[code] = gm;
+                m_asciiPresent[code] = true;
+                return &m_asciiGlyphs[code];
+            }
+        }
+
+        CachedGlyph& glyph = m_charToGlyphMetrics[code];
+        glyph.metrics = gm;
+        glyph.slot = slot;
+        glyph.lastUseFrame = Time::GetFrameCount();
+        page.glyphCount++;
+        return &glyph.metrics;
+    }
+
+    bool FontAsset::AllocateSlot(int w, int h, int& outPage, SDL_Rect& outSlot) {
+        if (w > m_pageSize || h > m_pageSize)
+            return false;
 
-            g.metrics.atlasX = dst.x;
-            g.metrics.atlasY = dst.y;
+        for (size_t i = 0; i < m_pages.size(); ++i) {
+            if (AllocateInPage(m_pages[i], w, h, outSlot)) {
+                outPage = static_cast<int>(i);
+                return true;
+            }
+        }
 
-            m_charToGlyphMetrics[g.code] = g.metrics;
-            if (g.code < 256) {
-                m_asciiGlyphs[g.code] = g.metrics;
-                m_asciiPresent[g.code] = true;
+        if (static_cast<int>(m_pages.size()) < MAX_GLYPH_ATLAS_PAGES && AddPage()) {
+            if (AllocateInPage(m_pages.back(), w, h, outSlot)) {
+                outPage = static_cast<int>(m_pages.size()) - 1;
+                return true;
             }
+        }
+
+        return EvictGlyphs(w, h, outPage, outSlot);
+    }
+
+    bool FontAsset::AllocateInPage(GlyphPage& page, int w, int h, SDL_Rect& outSlot) {
+        // smallest slot of an evicted glyph that fits
+        int bestSlot = -1;
+        for (size_t i = 0; i < page.freeSlots.size(); ++i) {
+            const SDL_Rect& s = page.freeSlots[i];
+            if (s.w < w || s.h < h)
+                continue;
+            if (bestSlot < 0 || s.w * s.h < page.freeSlots[bestSlot].w * page.freeSlots[bestSlot].h)
+                bestSlot = static_cast<int>(i);
+        }
+
+        if (bestSlot >= 0) {
+            outSlot = page.freeSlots[bestSlot];
+            page.freeSlots[bestSlot] = page.freeSlots.back();
+            page.freeSlots.pop_back();
+            return true;
+        }
 
-            cursorX += g.surf->w + spacingX;
+        // shelf with the least wasted height
+        GlyphShelf* bestShelf = nullptr;
+        for (auto& shelf : page.shelves) {
+            if (shelf.height < h || m_pageSize - shelf.cursorX < w)
+                continue;
+            if (!bestShelf || shelf.height < bestShelf->height)
+                bestShelf = &shelf;
+        }
+
+        if (!bestShelf) {
+            if (m_pageSize - page.shelfBottom < h)
+                return false;
 
-            SDL_DestroySurface(g.surf);
-            g.surf = nullptr;
+            page.shelves.push_back(GlyphShelf{ page.shelfBottom, h, 0 });
+            page.shelfBottom += h;
+            bestShelf = &page.shelves.back();
         }
 
-        return TextureSurface(atlas);
+        outSlot = SDL_Rect{ bestShelf->cursorX, bestShelf->y, w, h };
+        bestShelf->cursorX += w;
+        return true;
     }
 
-    SDL_Texture* FontAsset::CreateTextureForWindow(WindowID winID) {
-        if (m_glyphAtlasSurf.IsInvalid())
+    bool FontAsset::AddPage() {
+        SDL_Surface* surf = SDL_CreateSurface(m_pageSize, m_pageSize, SDL_PIXELFORMAT_RGBA32);
+        if (!surf) {
+            Log::Error("SDLCore::FontAsset::AddPage: Failed to create atlas page surface: {}", SDL_GetError());
+            return false;
+        }
+        SDL_FillSurfaceRect(surf, nullptr, 0);
+
+        GlyphPage page;
+        page.surface = TextureSurface(surf);
+        m_pages.push_back(std::move(page));
+        return true;
+    }
+
+    bool FontAsset::EvictGlyphs(int w, int h, int& outPage, SDL_Rect& outSlot) {
+        // glyphs used in this frame can already be part of pending draw calls
+        const uint64_t frame = Time::GetFrameCount();
+
+        std::vector<std::pair<uint64_t, Uint32>> candidates;
+        for (const auto& [code, glyph] : m_charToGlyphMetrics) {
+            if (glyph.lastUseFrame < frame)
+                candidates.emplace_back(glyph.lastUseFrame, code);
+        }
+
+        if (candidates.empty())
+            return false;
+
+        std::sort(candidates.begin(), candidates.end());
+
+        for (const auto& [_, code] : candidates) {
+            auto it = m_charToGlyphMetrics.find(code);
+            const int pageIndex = it->second.metrics.atlasPage;
+            const SDL_Rect slot = it->second.slot;
+            GlyphPage& page = m_pages[pageIndex];
+
+            m_charToGlyphMetrics.erase(it);
+            page.glyphCount--;
+
+            if (slot.w >= w && slot.h >= h) {
+                outPage = pageIndex;
+                outSlot = slot;
+                return true;
+            }
+            page.freeSlots.push_back(slot);
+
+            // the slots are too small, an empty page is packed again from the start
+            if (page.glyphCount == 0 && !page.pinned) {
+                page.shelves.clear();
+                page.freeSlots.clear();
+                page.shelfBottom = 0;
+                if (AllocateInPage(page, w, h, outSlot)) {
+                    outPage = pageIndex;
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void FontAsset::MarkPageDirty(GlyphPage& page, const SDL_Rect& rect) {
+        for (auto& [winID, _] : page.textures) {
+            SDL_Rect& dirty = page.dirtyRects[winID];
+            if (dirty.w <= 0 || dirty.h <= 0) {
+                dirty = rect;
+            }
+            else {
+                SDL_Rect merged;
+                SDL_GetRectUnion(&dirty, &rect, &merged);
+                dirty = merged;
+            }
+        }
+    }
+
+    SDL_Texture* FontAsset::CreateTextureForWindow(WindowID winID, int page) {
+        if (page < 0 || page >= static_cast<int>(m_pages.size()))
+            return nullptr;
+
+        GlyphPage& glyphPage = m_pages[page];
+        if (glyphPage.surface.IsInvalid())
             return nullptr;
         
         auto* app = Application::GetInstance();
@@ -281,10 +893,12 @@ namespace SDLCore {
         if (!renderer)
             return nullptr;
 
-        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, m_glyphAtlasSurf.GetSurface());
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, glyphPage.surface.GetSurface());
         if (texture) {
-            m_winIDToGlyphAtlasTexture[winID] = texture;
-            m_winIDToWinCallbackID[winID] = win->AddOnSDLRendererDestroy([this, winID]() { FreeTextureForWindow(winID); });
+            glyphPage.textures[winID] = texture;
+            glyphPage.dirtyRects[winID] = SDL_Rect{ 0, 0, 0, 0 };
+            if (m_winIDToWinCallbackID.find(winID) == m_winIDToWinCallbackID.end())
+                m_winIDToWinCallbackID[winID] = win->AddOnSDLRendererDestroy([this, winID]() { FreeTextureForWindow(winID); });
         }
 
         return texture;
@@ -303,10 +917,13 @@ namespace SDLCore {
         if (!win)
             return;
 
-        auto itAtlas = m_winIDToGlyphAtlasTexture.find(winID);
-        if (itAtlas != m_winIDToGlyphAtlasTexture.end()) {
-            SDL_DestroyTexture(itAtlas->second);
-            m_winIDToGlyphAtlasTexture.erase(itAtlas);
+        for (auto& page : m_pages) {
+            auto itAtlas = page.textures.find(winID);
+            if (itAtlas != page.textures.end()) {
+                SDL_DestroyTexture(itAtlas->second);
+                page.textures.erase(itAtlas);
+            }
+            page.dirtyRects.erase(winID);
         }
 
         auto itCallback = m_winIDToWinCallbackID.find(winID);
@@ -3,7 +3,7 @@
 
 namespace SDLCore {
 
-    GlyphMetrics::GlyphMetrics(char ch)
+    GlyphMetrics::GlyphMetrics(uint32_t ch)
         : code(ch)
     {
         // Constructor intentionally empty.
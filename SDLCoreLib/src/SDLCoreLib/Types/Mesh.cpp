@@ -0,0 +1,288 @@
+#include <algorithm>
+
+#include "SDLCoreRenderer.h"
+#include "SDLCoreError.h"
+#include "Internal/RenderBatch.h"
+#include "Internal/RenderStateCache.h"
+#include "Internal/LayerRegistry.h"
+#include "Internal/VertexConverter.h"
+#include "Types/Texture.h"
+#include "Types/Mesh.h"
+
+namespace SDLCore {
+
+    Mesh::Mesh(const Vertex* vertices, size_t vertexCount, const int* indices, size_t indexCount) {
+        SetVertices(vertices, vertexCount);
+        SetIndices(indices, indexCount);
+    }
+
+    Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<int>& indices) {
+        SetVertices(vertices);
+        SetIndices(indices);
+    }
+
+    Mesh* Mesh::SetVertices(const Vertex* vertices, size_t count) {
+        if (!vertices)
+            count = 0;
+
+        m_vertices.resize(count);
+        m_drawVertices.resize(count);
+        VertexConverter::Convert(m_vertices.data(), vertices, count, 0.0f, 0.0f, 1.0f, 1.0f);
+
+        MarkAllDirty();
+        m_boundsDirty = true;
+        return this;
+    }
+
+    Mesh* Mesh::SetVertices(const std::vector<Vertex>& vertices) {
+        return SetVertices(vertices.data(), vertices.size());
+    }
+
+    bool Mesh::UpdateVertices(size_t offset, const Vertex* vertices, size_t count) {
+        if (!vertices || count == 0)
+            return true;
+
+        if (offset > m_vertices.size() || count > m_vertices.size() - offset) {
+            SetErrorF("SDLCore::Mesh::UpdateVertices: Range ({}, {}) is out of bounds, mesh has {} vertices!",
+                offset, count, m_vertices.size());
+            return false;
+        }
+
+        VertexConverter::Convert(m_vertices.data() + offset, vertices, count, 0.0f, 0.0f, 1.0f, 1.0f);
+
+        MarkDirty(offset, offset + count);
+        m_boundsDirty = true;
+        return true;
+    }
+
+    Mesh* Mesh::SetIndices(const int* indices, size_t count) {
+        if (!indices)
+            count = 0;
+        m_indices.assign(indices, indices + count);
+        return this;
+    }
+
+    Mesh* Mesh::SetIndices(const std::vector<int>& indices) {
+        m_indices = indices;
+        return this;
+    }
+
+    bool Mesh::UpdateIndices(size_t offset, const int* indices, size_t count) {
+        if (!indices || count == 0)
+            return true;
+
+        if (offset > m_indices.size() || count > m_indices.size() - offset) {
+            SetErrorF("SDLCore::Mesh::UpdateIndices: Range ({}, {}) is out of bounds, mesh has {} indices!",
+                offset, count, m_indices.size());
+            return false;
+        }
+
+        std::copy(indices, indices + count, m_indices.begin() + offset);
+        return true;
+    }
+
+    Mesh* Mesh::Clear() {
+        m_vertices.clear();
+        m_drawVertices.clear();
+        m_indices.clear();
+        m_dirtyBegin = 0;
+        m_dirtyEnd = 0;
+        m_boundsDirty = true;
+        return this;
+    }
+
+    Mesh* Mesh::SetTexture(Texture* texture) {
+        // textured and untextured meshes use different vertex colors
+        if ((m_texture == nullptr) != (texture == nullptr)) {
+            m_drawColorApplied = false;
+            MarkAllDirty();
+        }
+        m_texture = texture;
+        return this;
+    }
+
+    Mesh* Mesh::SetPosition(float x, float y) {
+        if (m_position.x != x || m_position.y != y) {
+            m_position.x = x;
+            m_position.y = y;
+            MarkAllDirty();
+        }
+        return this;
+    }
+
+    Mesh* Mesh::SetPosition(const Vector2& position) {
+        return SetPosition(position.x, position.y);
+    }
+
+    Mesh* Mesh::SetScale(float x, float y) {
+        if (m_scale.x != x || m_scale.y != y) {
+            m_scale.x = x;
+            m_scale.y = y;
+            MarkAllDirty();
+        }
+        return this;
+    }
+
+    Mesh* Mesh::SetScale(float scale) {
+        return SetScale(scale, scale);
+    }
+
+    Mesh* Mesh::SetScale(const Vector2& scale) {
+        return SetScale(scale.x, scale.y);
+    }
+
+    Texture* Mesh::GetTexture() const {
+        return m_texture;
+    }
+
+    Vector2 Mesh::GetPosition() const {
+        return m_position;
+    }
+
+    Vector2 Mesh::GetScale() const {
+        return m_scale;
+    }
+
+    size_t Mesh::GetVertexCount() const {
+        return m_vertices.size();
+    }
+
+    size_t Mesh::GetIndexCount() const {
+        return m_indices.size();
+    }
+
+    FRect Mesh::GetLocalBounds() {
+        UpdateBounds();
+        return m_localBounds;
+    }
+
+    bool Mesh::Render() {
+        SDL_Renderer* renderer = Render::GetActiveRenderer();
+        if (!renderer) {
+            SetError("SDLCore::Mesh::Render: No active renderer!");
+            return false;
+        }
+        Render::CompositePendingBackground();
+
+        if (m_vertices.empty())
+            return true;
+
+        if (Render::IsCullingEnabled()) {
+            UpdateBounds();
+            float x0 = m_position.x + m_localBounds.x * m_scale.x;
+            float x1 = m_position.x + (m_localBounds.x + m_localBounds.w) * m_scale.x;
+            float y0 = m_position.y + m_localBounds.y * m_scale.y;
+            float y1 = m_position.y + (m_localBounds.y + m_localBounds.h) * m_scale.y;
+            if (Render::IsCulled(std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1)))
+                return true;
+        }
+
+        SDL_Texture* tex = nullptr;
+        if (m_texture) {
+            tex = m_texture->GetSDLTexture(Render::GetActiveWindowID());
+            if (!tex) {
+                SetError("SDLCore::Mesh::Render: SDL texture of the mesh is nullptr!");
+                return false;
+            }
+        }
+        else {
+            Vector4 active = Render::GetActiveColor();
+            SDL_FColor color{ active.x / 255.0f, active.y / 255.0f, active.z / 255.0f, active.w / 255.0f };
+            if (!m_drawColorApplied ||
+                color.r != m_drawColor.r ||
+                color.g != m_drawColor.g ||
+                color.b != m_drawColor.b ||
+                color.a != m_drawColor.a)
+            {
+                m_drawColor = color;
+                m_drawColorApplied = true;
+                MarkAllDirty();
+            }
+        }
+
+        UpdateDrawVertices(m_texture == nullptr);
+
+        const int* idx = (m_indices.empty()) ? nullptr : m_indices.data();
+
+        if (RenderBatch* batch = Render::GetActiveRenderBatch()) {
+            batch->AddGeometry(renderer, tex, m_drawVertices.data(), m_drawVertices.size(), idx, m_indices.size());
+            return true;
+        }
+
+        if (!SDL_RenderGeometry(renderer,
+            tex,
+            m_drawVertices.data(),
+            static_cast<int>(m_drawVertices.size()),
+            idx,
+            static_cast<int>(m_indices.size())))
+        {
+            SetErrorF("SDLCore::Mesh::Render: Failed to draw mesh (vertices={}, indices={}): {}",
+                m_drawVertices.size(), m_indices.size(), SDL_GetError());
+            return false;
+        }
+
+        return true;
+    }
+
+    void Mesh::MarkDirty(size_t begin, size_t end) {
+        if (m_dirtyBegin >= m_dirtyEnd) {
+            m_dirtyBegin = begin;
+            m_dirtyEnd = end;
+            return;
+        }
+        m_dirtyBegin = std::min(m_dirtyBegin, begin);
+        m_dirtyEnd = std::max(m_dirtyEnd, end);
+    }
+
+    void Mesh::MarkAllDirty() {
+        m_dirtyBegin = 0;
+        m_dirtyEnd = m_vertices.size();
+    }
+
+    void Mesh::UpdateDrawVertices(bool overrideColor) {
+        if (m_dirtyBegin >= m_dirtyEnd)
+            return;
+
+        const float sx = m_scale.x;
+        const float sy = m_scale.y;
+        const float ox = m_position.x;
+        const float oy = m_position.y;
+
+        for (size_t i = m_dirtyBegin; i < m_dirtyEnd; i++) {
+            const SDL_Vertex& src = m_vertices[i];
+            SDL_Vertex& dst = m_drawVertices[i];
+            dst.position.x = ox + src.position.x * sx;
+            dst.position.y = oy + src.position.y * sy;
+            dst.color = (overrideColor) ? m_drawColor : src.color;
+            dst.tex_coord = src.tex_coord;
+        }
+
+        m_dirtyBegin = 0;
+        m_dirtyEnd = 0;
+    }
+
+    void Mesh::UpdateBounds() {
+        if (!m_boundsDirty)
+            return;
+        m_boundsDirty = false;
+
+        if (m_vertices.empty()) {
+            m_localBounds = FRect{ 0.0f, 0.0f, 0.0f, 0.0f };
+            return;
+        }
+
+        float minX = m_vertices[0].position.x;
+        float minY = m_vertices[0].position.y;
+        float maxX = minX;
+        float maxY = minY;
+        for (const SDL_Vertex& v : m_vertices) {
+            minX = std::min(minX, v.position.x);
+            minY = std::min(minY, v.position.y);
+            maxX = std::max(maxX, v.position.x);
+            maxY = std::max(maxY, v.position.y);
+        }
+
+        m_localBounds = FRect{ minX, minY, maxX - minX, maxY - minY };
+    }
+
+}
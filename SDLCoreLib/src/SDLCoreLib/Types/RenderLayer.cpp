@@ -0,0 +1,345 @@
+#include <vector>
+#include <algorithm>
+#include <CoreLib/Log.h>
+
+#include "Application.h"
+#include "SDLCoreRenderer.h"
+#include "Internal/RenderStateCache.h"
+#include "Internal/LayerRegistry.h"
+#include "Types/RenderLayer.h"
+
+namespace SDLCore::Render {
+
+    namespace {
+        std::vector<Layer*> s_layers;
+        bool s_layersSorted = true;
+        std::vector<SDL_Renderer*> s_pendingBackgrounds;// renderers that were cleared, but not got their background yet
+    }
+
+    void RegisterLayer(Layer* layer) {
+        s_layers.push_back(layer);
+        s_layersSorted = false;
+    }
+
+    void UnregisterLayer(Layer* layer) {
+        auto it = std::find(s_layers.begin(), s_layers.end(), layer);
+        if (it != s_layers.end())
+            s_layers.erase(it);
+    }
+
+    void InvalidateLayerOrder() {
+        s_layersSorted = false;
+    }
+
+    void CompositeLayers(bool background) {
+        if (s_layers.empty() || !GetActiveRenderer())
+            return;
+
+        if (!s_layersSorted) {
+            // stable, layers with the same z order keep their creation order
+            std::stable_sort(s_layers.begin(), s_layers.end(), [](const Layer* a, const Layer* b) {
+                return a->m_zOrder < b->m_zOrder;
+            });
+            s_layersSorted = true;
+        }
+
+        for (Layer* layer : s_layers) {
+            if (!layer->m_autoComposite || !layer->m_visible)
+                continue;
+            if ((layer->m_zOrder < 0) != background)
+                continue;
+            layer->Draw();
+        }
+    }
+
+    void RequestBackgroundComposite() {
+        SDL_Renderer* renderer = GetActiveRenderer();
+        if (!renderer || s_layers.empty())
+            return;
+
+        if (std::find(s_pendingBackgrounds.begin(), s_pendingBackgrounds.end(), renderer) == s_pendingBackgrounds.end())
+            s_pendingBackgrounds.push_back(renderer);
+    }
+
+    void CompositePendingBackground() {
+        if (s_pendingBackgrounds.empty())
+            return;
+
+        SDL_Renderer* renderer = GetActiveRenderer();
+        auto it = std::find(s_pendingBackgrounds.begin(), s_pendingBackgrounds.end(), renderer);
+        if (it == s_pendingBackgrounds.end())
+            return;
+
+        // draws into a layer or texture do not cover the background
+        if (SDL_GetRenderTarget(renderer))
+            return;
+
+        s_pendingBackgrounds.erase(it);
+        CompositeLayers(true);
+    }
+
+    Layer::Layer(int zOrder)
+        : m_zOrder(zOrder) {
+        RegisterLayer(this);
+    }
+
+    Layer::~Layer() {
+        if (m_recording)
+            End();
+
+        Application* app = Application::GetInstance();
+        for (auto& [winID, target] : m_targets) {
+            Window* win = (app) ? app->GetWindow(winID) : nullptr;
+            if (win && target.rendererDestroyCallback.value != SDLCORE_INVALID_ID)
+                win->RemoveOnSDLRendererDestroy(target.rendererDestroyCallback);
+            if (target.texture)
+                SDL_DestroyTexture(target.texture);
+        }
+        m_targets.clear();
+
+        UnregisterLayer(this);
+    }
+
+    bool Layer::Begin() {
+        if (m_recording) {
+            Log::Warn("SDLCore::Render::Layer::Begin: Layer is already recording, End() was not called!");
+            return false;
+        }
+
+        SDL_Renderer* renderer = GetActiveRenderer();
+        if (!renderer)
+            return false;
+
+        Target* target = GetTarget(renderer, GetActiveWindowID());
+        if (!target || !target->texture)
+            return false;
+
+        if (!target->fullDirty && !target->partialDirty)
+            return false;
+
+        // pending draws belong to the previous target
+        FlushBatch();
+
+        m_prevTarget = SDL_GetRenderTarget(renderer);
+        if (!SDL_SetRenderTarget(renderer, target->texture)) {
+            Log::Error("SDLCore::Render::Layer::Begin: Failed to set render target: {}", SDL_GetError());
+            return false;
+        }
+
+        Uint8 r = 0, g = 0, b = 0, a = 0;
+        SDL_BlendMode blendMode = SDL_BLENDMODE_NONE;
+        SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+        SDL_GetRenderDrawBlendMode(renderer, &blendMode);
+
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+        if (target->fullDirty) {
+            SDL_SetRenderClipRect(renderer, nullptr);
+            SDL_RenderClear(renderer);
+        }
+        else {
+            // only the dirty area is cleared and redrawn, the rest of the layer is kept
+            SDL_FRect area = ToFRect(target->dirtyRect);
+            SDL_SetRenderClipRect(renderer, &target->dirtyRect);
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+            SDL_RenderFillRect(renderer, &area);
+        }
+
+        SDL_SetRenderDrawColor(renderer, r, g, b, a);
+        SDL_SetRenderDrawBlendMode(renderer, blendMode);
+
+        // viewport and clip rect are stored per render target
+        InvalidateActiveRenderState();
+
+        target->fullDirty = false;
+        target->partialDirty = false;
+        m_recording = true;
+        return true;
+    }
+
+    void Layer::End() {
+        if (!m_recording)
+            return;
+        m_recording = false;
+
+        SDL_Renderer* renderer = GetActiveRenderer();
+        if (!renderer)
+            return;
+
+        FlushBatch();
+        SDL_SetRenderClipRect(renderer, nullptr);
+        if (!SDL_SetRenderTarget(renderer, m_prevTarget)) {
+            Log::Error("SDLCore::Render::Layer::End: Failed to restore render target: {}", SDL_GetError());
+        }
+        m_prevTarget = nullptr;
+
+        InvalidateActiveRenderState();
+    }
+
+    void Layer::MarkDirty() {
+        for (auto& [_, target] : m_targets) {
+            target.fullDirty = true;
+            target.partialDirty = false;
+        }
+    }
+
+    void Layer::MarkDirty(const SDLCore::Rect& rect) {
+        if (rect.w <= 0 || rect.h <= 0)
+            return;
+
+        for (auto& [_, target] : m_targets) {
+            if (target.fullDirty)
+                continue;
+
+            if (target.partialDirty) {
+                SDLCore::Rect merged;
+                SDL_GetRectUnion(&target.dirtyRect, &rect, &merged);
+                target.dirtyRect = merged;
+            }
+            else {
+                target.dirtyRect = rect;
+                target.partialDirty = true;
+            }
+        }
+    }
+
+    bool Layer::IsDirty() const {
+        auto it = m_targets.find(GetActiveWindowID());
+        if (it == m_targets.end())
+            return true;
+        return it->second.fullDirty || it->second.partialDirty;
+    }
+
+    void Layer::Draw() {
+        SDL_Renderer* renderer = GetActiveRenderer();
+        if (!renderer)
+            return;
+
+        auto it = m_targets.find(GetActiveWindowID());
+        if (it == m_targets.end() || !it->second.texture)
+            return;
+
+        if (m_recording) {
+            Log::Warn("SDLCore::Render::Layer::Draw: Can not draw a layer into itself!");
+            return;
+        }
+
+        SDL_Texture* texture = it->second.texture;
+        CompositePendingBackground();
+
+        // keeps the draw order with batched draws
+        FlushBatch();
+        // the content is premultiplied, the opacity has to scale the color as well
+        SDL_SetTextureColorMod(texture, m_opacity, m_opacity, m_opacity);
+        SDL_SetTextureAlphaMod(texture, m_opacity);
+        if (!SDL_RenderTexture(renderer, texture, nullptr, nullptr)) {
+            Log::Error("SDLCore::Render::Layer::Draw: Failed to draw layer: {}", SDL_GetError());
+        }
+    }
+
+    Layer* Layer::SetZOrder(int zOrder) {
+        if (m_zOrder != zOrder) {
+            m_zOrder = zOrder;
+            InvalidateLayerOrder();
+        }
+        return this;
+    }
+
+    Layer* Layer::SetVisible(bool value) {
+        m_visible = value;
+        return this;
+    }
+
+    Layer* Layer::SetOpacity(Uint8 alpha) {
+        m_opacity = alpha;
+        return this;
+    }
+
+    Layer* Layer::SetAutoComposite(bool value) {
+        m_autoComposite = value;
+        return this;
+    }
+
+    int Layer::GetZOrder() const {
+        return m_zOrder;
+    }
+
+    bool Layer::IsVisible() const {
+        return m_visible;
+    }
+
+    Uint8 Layer::GetOpacity() const {
+        return m_opacity;
+    }
+
+    bool Layer::IsAutoComposite() const {
+        return m_autoComposite;
+    }
+
+    Layer::Target* Layer::GetTarget(SDL_Renderer* renderer, WindowID winID) {
+        if (winID.value == SDLCORE_INVALID_ID)
+            return nullptr;
+
+        int width = 0, height = 0;
+        if (!SDL_GetRenderOutputSize(renderer, &width, &height) || width <= 0 || height <= 0) {
+            Log::Error("SDLCore::Render::Layer::GetTarget: Failed to get render output size: {}", SDL_GetError());
+            return nullptr;
+        }
+
+        Target& target = m_targets[winID];
+
+        if (target.rendererDestroyCallback.value == SDLCORE_INVALID_ID) {
+            Application* app = Application::GetInstance();
+            Window* win = (app) ? app->GetWindow(winID) : nullptr;
+            if (win) {
+                target.rendererDestroyCallback = win->AddOnSDLRendererDestroy([this, winID]() {
+                    FreeTarget(winID);
+                });
+            }
+        }
+
+        if (target.texture && target.width == width && target.height == height)
+            return &target;
+
+        if (target.texture)
+            SDL_DestroyTexture(target.texture);
+
+        target.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+        if (!target.texture) {
+            Log::Error("SDLCore::Render::Layer::GetTarget: Failed to create layer texture: {}", SDL_GetError());
+            return nullptr;
+        }
+
+        // draws blended into the cleared (transparent) target store premultiplied colors (rgb * a, a),
+        // a second multiply with alpha would darken translucent and anti-aliased content
+        SDL_SetTextureBlendMode(target.texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        target.width = width;
+        target.height = height;
+        target.fullDirty = true;
+        target.partialDirty = false;
+        return &target;
+    }
+
+    void Layer::FreeTarget(WindowID winID) {
+        auto it = m_targets.find(winID);
+        if (it == m_targets.end())
+            return;
+
+        Target& target = it->second;
+        Application* app = Application::GetInstance();
+        Window* win = (app) ? app->GetWindow(winID) : nullptr;
+        if (win && target.rendererDestroyCallback.value != SDLCORE_INVALID_ID)
+            win->RemoveOnSDLRendererDestroy(target.rendererDestroyCallback);
+
+        // called before the renderer is destroyed, the texture is still valid
+        if (target.texture)
+            SDL_DestroyTexture(target.texture);
+
+        if (m_recording && GetActiveWindowID() == winID) {
+            m_recording = false;
+            m_prevTarget = nullptr;
+        }
+
+        m_targets.erase(it);
+    }
+
+}
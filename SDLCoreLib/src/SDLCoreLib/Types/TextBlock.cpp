@@ -0,0 +1,337 @@
+#include <algorithm>
+#include <SDL3/SDL.h>
+
+#include "Application.h"
+#include "Types/Font/FontAsset.h"
+#include "Types/TextBlock.h"
+
+namespace SDLCore {
+
+    namespace {
+        // copies a line of a layout that was built from the text starting at textOffset
+        void AssignLine(const TextLayout& layout, const TextLayoutLine& src, size_t textOffset,
+            size_t& outStart, float& outWidth, std::vector<TextLayoutGlyph>& outGlyphs)
+        {
+            outStart = src.textStart + textOffset;
+            outWidth = src.width;
+            outGlyphs.assign(layout.glyphs.begin() + src.firstGlyph,
+                layout.glyphs.begin() + src.firstGlyph + src.glyphCount);
+            for (auto& g : outGlyphs)
+                g.byteOffset -= static_cast<Uint32>(src.textStart);
+        }
+
+        bool HasSameGlyphs(const TextLayout& layout, const TextLayoutLine& src, float width, const std::vector<TextLayoutGlyph>& glyphs) {
+            if (src.width != width || src.glyphCount != glyphs.size())
+                return false;
+
+            const TextLayoutGlyph* newGlyphs = layout.glyphs.data() + src.firstGlyph;
+            for (size_t i = 0; i < glyphs.size(); ++i) {
+                if (newGlyphs[i].code != glyphs[i].code || newGlyphs[i].x != glyphs[i].x)
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    TextBlock::TextBlock(const std::string& text)
+        : m_text(text) {
+    }
+
+    TextBlock::~TextBlock() {
+        FreeTexture();
+    }
+
+    TextBlock::TextBlock(const TextBlock& other)
+        : m_text(other.m_text), m_textureCache(other.m_textureCache) {
+    }
+
+    TextBlock& TextBlock::operator=(const TextBlock& other) {
+        if (this == &other)
+            return *this;
+
+        FreeTexture();
+        SetText(other.m_text);
+        m_textureCache = other.m_textureCache;
+        return *this;
+    }
+
+    TextBlock::TextBlock(TextBlock&& other) noexcept
+        : m_text(std::move(other.m_text)), m_textureCache(other.m_textureCache) {
+        // the texture callback is bound to the other block, the texture is rendered again
+        other.FreeTexture();
+        other.SetText("");
+    }
+
+    TextBlock& TextBlock::operator=(TextBlock&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        FreeTexture();
+        m_text = std::move(other.m_text);
+        m_layoutValid = false;
+        m_editStart = NO_EDIT;
+        m_editEnd = 0;
+        m_textureCache = other.m_textureCache;
+        other.FreeTexture();
+        other.SetText("");
+        return *this;
+    }
+
+    void TextBlock::SetText(const std::string& text) {
+        m_text = text;
+        m_layoutValid = false;
+        m_editStart = NO_EDIT;
+        m_editEnd = 0;
+    }
+
+    void TextBlock::Insert(size_t pos, std::string_view text) {
+        if (text.empty())
+            return;
+
+        pos = std::min(pos, m_text.size());
+        m_text.insert(pos, text.data(), text.size());
+        if (!m_layoutValid)
+            return;
+
+        const size_t count = text.size();
+        auto it = std::upper_bound(m_lines.begin(), m_lines.end(), pos,
+            [](size_t value, const Line& line) { return value < line.textStart; });
+        for (; it != m_lines.end(); ++it)
+            it->textStart += count;
+
+        if (m_editStart != NO_EDIT) {
+            if (m_editStart > pos)
+                m_editStart += count;
+            if (m_editEnd > pos)
+                m_editEnd += count;
+        }
+        MarkEdited(pos, pos + count);
+    }
+
+    void TextBlock::Append(std::string_view text) {
+        Insert(m_text.size(), text);
+    }
+
+    void TextBlock::Erase(size_t pos, size_t count) {
+        if (pos >= m_text.size() || count == 0)
+            return;
+
+        count = std::min(count, m_text.size() - pos);
+        m_text.erase(pos, count);
+        if (!m_layoutValid)
+            return;
+
+        // positions inside the erased range collapse to pos
+        const size_t end = pos + count;
+        auto shift = [pos, end, count](size_t value) {
+            return (value >= end) ? value - count : std::min(value, pos);
+        };
+
+        auto it = std::upper_bound(m_lines.begin(), m_lines.end(), pos,
+            [](size_t value, const Line& line) { return value < line.textStart; });
+        for (; it != m_lines.end(); ++it)
+            it->textStart = shift(it->textStart);
+
+        if (m_editStart != NO_EDIT) {
+            m_editStart = shift(m_editStart);
+            m_editEnd = shift(m_editEnd);
+        }
+        MarkEdited(pos, pos);
+    }
+
+    void TextBlock::Clear() {
+        SetText("");
+    }
+
+    void TextBlock::SetTextureCache(bool value) {
+        m_textureCache = value;
+        if (!value)
+            FreeTexture();
+    }
+
+    const std::string& TextBlock::GetText() const {
+        return m_text;
+    }
+
+    bool TextBlock::IsTextureCacheEnabled() const {
+        return m_textureCache;
+    }
+
+    size_t TextBlock::GetLineCount() const {
+        return m_lines.size();
+    }
+
+    float TextBlock::GetWidth() const {
+        return m_blockWidth;
+    }
+
+    size_t TextBlock::GetLastRelayoutLineCount() const {
+        return m_lastRelayoutLineCount;
+    }
+
+    void TextBlock::UpdateLayout(FontAsset* asset, const TextLayoutParams& params) {
+        m_lastRelayoutLineCount = 0;
+        if (!asset)
+            return;
+
+        if (!m_layoutValid || m_layoutAssetID != asset->GetID() || !(m_layoutParams == params)) {
+            m_layoutAssetID = asset->GetID();
+            m_layoutParams = params;
+            RelayoutAll(asset);
+            return;
+        }
+
+        if (m_editStart != NO_EDIT)
+            RelayoutEdit(asset);
+    }
+
+    void TextBlock::RelayoutAll(FontAsset* asset) {
+        BuildTextLayout(asset, m_text, m_layoutParams, m_scratch);
+
+        const size_t oldCount = m_lines.size();
+        m_lines.resize(m_scratch.lines.size());
+        for (size_t i = 0; i < m_lines.size(); ++i) {
+            Line& line = m_lines[i];
+            AssignLine(m_scratch, m_scratch.lines[i], 0, line.textStart, line.width, line.glyphs);
+        }
+
+        m_blockWidth = m_scratch.blockWidth;
+        m_layoutValid = true;
+        m_editStart = NO_EDIT;
+        m_editEnd = 0;
+        m_lastRelayoutLineCount = m_lines.size();
+        MarkLinesDirty(0, std::max(oldCount, m_lines.size()));
+    }
+
+    void TextBlock::RelayoutEdit(FontAsset* asset) {
+        const size_t editStart = std::min(m_editStart, m_text.size());
+        const size_t editEnd = std::min(std::max(m_editEnd, editStart), m_text.size());
+        m_editStart = NO_EDIT;
+        m_editEnd = 0;
+
+        auto startsBefore = [](const Line& line, size_t pos) { return line.textStart < pos; };
+
+        // the last line that starts before the edit changes, the first word of it can
+        // get shorter and move up, so the layout starts one line earlier
+        const size_t editLine = std::lower_bound(m_lines.begin(), m_lines.end(), editStart, startsBefore) - m_lines.begin();
+        const size_t first = (editLine >= 2) ? editLine - 2 : 0;
+        const size_t regionStart = (first == 0) ? 0 : m_lines[first].textStart;
+
+        // lines never continue over '\n', the lines behind the edited paragraph do not change
+        const size_t newline = m_text.find('\n', editEnd);
+        const size_t regionEnd = (newline == std::string::npos) ? m_text.size() : newline + 1;
+        // lines of erased text at the end collapse onto m_text.size(), an edit that reaches the end replaces all of them
+        const size_t last = (regionEnd == m_text.size()) ? m_lines.size() :
+            std::lower_bound(m_lines.begin() + first, m_lines.end(), regionEnd, startsBefore) - m_lines.begin();
+
+        BuildTextLayout(asset, std::string_view(m_text).substr(regionStart, regionEnd - regionStart), m_layoutParams, m_scratch);
+
+        const size_t oldTotal = m_lines.size();
+        const size_t oldCount = last - first;
+        const size_t newCount = m_scratch.lines.size();
+        const size_t common = std::min(oldCount, newCount);
+
+        size_t changedBegin = NO_EDIT;
+        size_t changedEnd = 0;
+        for (size_t i = 0; i < common; ++i) {
+            Line& line = m_lines[first + i];
+            const TextLayoutLine& src = m_scratch.lines[i];
+            if (!HasSameGlyphs(m_scratch, src, line.width, line.glyphs)) {
+                changedBegin = std::min(changedBegin, first + i);
+                changedEnd = first + i + 1;
+            }
+            AssignLine(m_scratch, src, regionStart, line.textStart, line.width, line.glyphs);
+        }
+
+        if (newCount > oldCount) {
+            m_lines.insert(m_lines.begin() + first + common, newCount - oldCount, Line{});
+            for (size_t i = common; i < newCount; ++i) {
+                Line& line = m_lines[first + i];
+                AssignLine(m_scratch, m_scratch.lines[i], regionStart, line.textStart, line.width, line.glyphs);
+            }
+        }
+        else if (newCount < oldCount) {
+            m_lines.erase(m_lines.begin() + first + common, m_lines.begin() + first + oldCount);
+        }
+
+        // a changed number of lines moves every line below
+        if (newCount != oldCount) {
+            changedBegin = std::min(changedBegin, first + common);
+            changedEnd = std::max(oldTotal, m_lines.size());
+        }
+
+        if (changedBegin != NO_EDIT)
+            MarkLinesDirty(changedBegin, changedEnd);
+
+        m_blockWidth = 0.0f;
+        for (const auto& line : m_lines)
+            m_blockWidth = std::max(m_blockWidth, line.width);
+        m_lastRelayoutLineCount = newCount;
+    }
+
+    void TextBlock::MarkEdited(size_t start, size_t end) {
+        if (m_editStart == NO_EDIT) {
+            m_editStart = start;
+            m_editEnd = end;
+            return;
+        }
+
+        m_editStart = std::min(m_editStart, start);
+        m_editEnd = std::max(m_editEnd, end);
+    }
+
+    void TextBlock::MarkLinesDirty(size_t begin, size_t end) {
+        if (begin >= end)
+            return;
+
+        if (m_dirtyLineBegin >= m_dirtyLineEnd) {
+            m_dirtyLineBegin = begin;
+            m_dirtyLineEnd = end;
+            return;
+        }
+
+        m_dirtyLineBegin = std::min(m_dirtyLineBegin, begin);
+        m_dirtyLineEnd = std::max(m_dirtyLineEnd, end);
+    }
+
+    void TextBlock::SetTexture(SDL_Texture* texture, WindowID winID, int width, int height) {
+        FreeTexture();
+        if (!texture)
+            return;
+
+        auto* app = Application::GetInstance();
+        auto* win = (app) ? app->GetWindow(winID) : nullptr;
+        if (!win) {
+            SDL_DestroyTexture(texture);
+            return;
+        }
+
+        m_texture = texture;
+        m_textureWinID = winID;
+        m_textureWidth = width;
+        m_textureHeight = height;
+        m_textureColor = SDL_Color{ 255, 255, 255, 255 };
+        m_textureCallbackID = win->AddOnSDLRendererDestroy([this]() { FreeTexture(); });
+    }
+
+    void TextBlock::FreeTexture() {
+        if (!m_texture)
+            return;
+
+        // prevents from calling sdl funcs if app is closing
+        if (!IsSDLQuit()) {
+            SDL_DestroyTexture(m_texture);
+
+            auto* app = Application::GetInstance();
+            if (auto* win = (app) ? app->GetWindow(m_textureWinID) : nullptr)
+                win->RemoveOnSDLRendererDestroy(m_textureCallbackID);
+        }
+
+        m_texture = nullptr;
+        m_textureWinID.value = SDLCORE_INVALID_ID;
+        m_textureCallbackID.value = SDLCORE_INVALID_ID;
+        m_textureWidth = 0;
+        m_textureHeight = 0;
+    }
+
+}
@@ -1,4 +1,7 @@
 #include <memory>
+#include <vector>
+#include <cmath>
+#include <algorithm>
 #include <SDL3_image/SDL_image.h>
 #include <CoreLib/Log.h>
 
@@ -6,6 +9,10 @@
 #include "SDLCoreRenderer.h"
 #include "SDLCoreError.h"
 #include "Internal/TextureManager.h"
+#include "Internal/RenderBatch.h"
+#include "Internal/RenderStateCache.h"
+#include "Internal/LayerRegistry.h"
+#include "Types/AssetPack.h"
 #include "types/Texture.h"
 
 namespace SDLCore {
@@ -77,6 +84,40 @@ namespace SDLCore {
         : Texture(path.string().c_str(), type) {
     }
 
+    Texture::Texture(const AssetPack& pack, std::string_view path, Type type)
+        : m_type(type) {
+
+        SDL_IOStream* io = pack.OpenIO(path);
+        if (!io) {
+            Log::Warn("SDLCore::Texture: {}, using fallback texture", GetError());
+            LoadFallback();
+            return;
+        }
+
+        SDL_Surface* surface = IMG_Load_IO(io, true);
+        if (!surface) {
+            Log::Error("SDLCore::Texture: Failed to load '{}' from asset pack: {}", std::string(path), SDL_GetError());
+            return;
+        }
+
+        m_width = surface->w;
+        m_height = surface->h;
+        m_textureSurface = TextureSurface(surface);
+    }
+
+    Texture::Texture(const TextureSurface& surface, Type type)
+        : m_textureSurface(surface), m_type(type) {
+        SDL_Surface* sdlSurface = m_textureSurface.GetSurface();
+        if (!sdlSurface) {
+            Log::Warn("SDLCore::Texture: Surface is invalid, using fallback texture");
+            LoadFallback();
+            return;
+        }
+
+        m_width = sdlSurface->w;
+        m_height = sdlSurface->h;
+    }
+
     Texture::~Texture() {
         if (!IsSDLQuit())
             Cleanup();
@@ -173,12 +214,20 @@ namespace SDLCore {
             SetErrorF("SDLCore::Texture::Render: Renderer is nullptr for window '{}'", currentWinID);
             return false;
         }
+        Render::CompositePendingBackground();
 
         if (w <= 0) 
             w = static_cast<float>(m_width);
         if (h <= 0) 
             h = static_cast<float>(m_height);
 
+        if (Render::IsCullingEnabled() && IsCulled(x, y, w, h))
+            return true;
+
+        if (RenderBatch* batch = Render::GetActiveRenderBatch()) {
+            return RenderBatched(batch, renderer, texture, x, y, w, h, src);
+        }
+
         bool result = true;
         std::string errorBuffer;
 
@@ -187,34 +236,49 @@ namespace SDLCore {
         Uint8 b = static_cast<Uint8>(m_colorTint.z);
         Uint8 a = static_cast<Uint8>(m_colorTint.w);
 
-        if (texture->lastR != r || texture->lastG != g || texture->lastB != b || texture->lastA != a) {
+        if (texture->lastR != r || texture->lastG != g || texture->lastB != b) {
             texture->lastR = r;
             texture->lastG = g;
             texture->lastB = b;
-            texture->lastA = a;
 
+            RenderStateCache::CountIssued();
             if (!SDL_SetTextureColorMod(texture->tex, r, g, b)) {
                 if (!errorBuffer.empty()) errorBuffer += ", ";
                 errorBuffer += FormatUtils::formatString("Failed to set color: {}", SDL_GetError());
                 result = false;
             }
+        }
+        else {
+            RenderStateCache::CountSkipped();
+        }
 
+        if (texture->lastA != a) {
+            texture->lastA = a;
+
+            RenderStateCache::CountIssued();
             if (!SDL_SetTextureAlphaMod(texture->tex, a)) {
                 if (!errorBuffer.empty()) errorBuffer += ", ";
                 errorBuffer += FormatUtils::formatString("Failed to set alpha: {}", SDL_GetError());
                 result = false;
             }
         }
+        else {
+            RenderStateCache::CountSkipped();
+        }
 
         SDL_ScaleMode scaleMode = static_cast<SDL_ScaleMode>(m_scaleMode);
         if (texture->scaleMode != scaleMode) {
             texture->scaleMode = scaleMode;
+            RenderStateCache::CountIssued();
             if (!SDL_SetTextureScaleMode(texture->tex, scaleMode)) {
                 if (!errorBuffer.empty()) errorBuffer += ", ";
                 errorBuffer += FormatUtils::formatString("Failed to set scale mode: {}", SDL_GetError());
                 result = false;
             }
         }
+        else {
+            RenderStateCache::CountSkipped();
+        }
 
         SDL_FRect dst{ x, y, w, h };
         SDL_FPoint center{
@@ -236,6 +300,90 @@ namespace SDLCore {
         return result;
     }
 
+    bool Texture::IsCulled(float x, float y, float w, float h) const {
+        if (m_rotation == 0.0f)
+            return Render::IsCulled(x, y, x + w, y + h);
+
+        // same pivot as RenderBatched, the circle through the farthest corner contains every rotation
+        float cx = x + m_center.x * w;
+        float cy = y + m_center.y * h;
+        float pivotX = x + cx;
+        float pivotY = y + cy;
+        float dx = std::max(std::abs(cx), std::abs(w - cx));
+        float dy = std::max(std::abs(cy), std::abs(h - cy));
+        float r = std::sqrt(dx * dx + dy * dy);
+        return Render::IsCulled(pivotX - r, pivotY - r, pivotX + r, pivotY + r);
+    }
+
+    bool Texture::RenderBatched(RenderBatch* batch, SDL_Renderer* renderer, SDLTexture* texture,
+        float x, float y, float w, float h, const FRect* src) 
+    {
+        // geometry ignores the color mod of the texture, the tint is stored in the vertices instead
+        SDL_ScaleMode scaleMode = static_cast<SDL_ScaleMode>(m_scaleMode);
+        if (texture->scaleMode != scaleMode) {
+            texture->scaleMode = scaleMode;
+            RenderStateCache::CountIssued();
+            if (!SDL_SetTextureScaleMode(texture->tex, scaleMode)) {
+                SetErrorF("SDLCore::Texture::Render: Failed to set scale mode: {}", SDL_GetError());
+                return false;
+            }
+        }
+        else {
+            RenderStateCache::CountSkipped();
+        }
+
+        float texW = static_cast<float>(m_width);
+        float texH = static_cast<float>(m_height);
+        if (texW <= 0 || texH <= 0)
+            return true;
+
+        FRect srcRect = (src) ? *src : FRect{ 0, 0, texW, texH };
+        float minU = srcRect.x / texW;
+        float maxU = (srcRect.x + srcRect.w) / texW;
+        float minV = srcRect.y / texH;
+        float maxV = (srcRect.y + srcRect.h) / texH;
+
+        int flip = static_cast<int>(m_flip);
+        if (flip & SDL_FLIP_HORIZONTAL)
+            std::swap(minU, maxU);
+        if (flip & SDL_FLIP_VERTICAL)
+            std::swap(minV, maxV);
+
+        // same center as the immediate path, which passes it to SDL_RenderTextureRotated (relative to dst)
+        float cx = x + m_center.x * w;
+        float cy = y + m_center.y * h;
+
+        float minX = -cx;
+        float maxX = w - cx;
+        float minY = -cy;
+        float maxY = h - cy;
+
+        float rad = m_rotation * (SDL_PI_F / 180.0f);
+        float s = std::sin(rad);
+        float c = std::cos(rad);
+
+        float pivotX = x + cx;
+        float pivotY = y + cy;
+
+        SDL_FColor color{
+            m_colorTint.x / 255.0f,
+            m_colorTint.y / 255.0f,
+            m_colorTint.z / 255.0f,
+            m_colorTint.w / 255.0f
+        };
+
+        SDL_Vertex quad[4] = {
+            { { c * minX - s * minY + pivotX, s * minX + c * minY + pivotY }, color, { minU, minV } },// top left
+            { { c * maxX - s * minY + pivotX, s * maxX + c * minY + pivotY }, color, { maxU, minV } },// top right
+            { { c * maxX - s * maxY + pivotX, s * maxX + c * maxY + pivotY }, color, { maxU, maxV } },// bottom right
+            { { c * minX - s * maxY + pivotX, s * minX + c * maxY + pivotY }, color, { minU, maxV } } // bottom left
+        };
+
+        const int indices[6] = { 0, 1, 2, 0, 2, 3 };
+        batch->AddGeometry(renderer, texture->tex, quad, 4, indices, 6);
+        return true;
+    }
+
     bool Texture::Render(const Vector2& pos, const Vector2& size, const FRect* src) {
         return Render(pos.x, pos.y, size.x, size.y, src);
     }
@@ -268,6 +416,66 @@ namespace SDLCore {
         return true;
     }
 
+    bool Texture::UpdateFromSurface(const Rect* rect) {
+        SDL_Surface* surface = m_textureSurface.GetSurface();
+        if (!surface) {
+            SetError("SDLCore::Texture::UpdateFromSurface: Surface is nullptr!");
+            return false;
+        }
+
+        Rect area = (rect) ? *rect : Rect{ 0, 0, surface->w, surface->h };
+        if (area.w <= 0 || area.h <= 0)
+            return true;
+
+        if (!SDL_LockSurface(surface)) {
+            SetErrorF("SDLCore::Texture::UpdateFromSurface: Failed to lock surface: {}", SDL_GetError());
+            return false;
+        }
+
+        const int bytesPerPixel = SDL_BYTESPERPIXEL(surface->format);
+        const Uint8* pixels = static_cast<const Uint8*>(surface->pixels) + 
+            area.y * surface->pitch + area.x * bytesPerPixel;
+
+        // SDL_CreateTextureFromSurface can pick another native format (e.g. ARGB8888 for an RGBA32 surface),
+        // the area is converted once per format that differs from the surface
+        std::vector<Uint8> converted;
+        SDL_PixelFormat convertedFormat = SDL_PIXELFORMAT_UNKNOWN;
+
+        bool result = true;
+        for (auto& [winID, texture] : m_textures) {
+            if (!texture.tex)
+                continue;
+
+            const void* uploadPixels = pixels;
+            int uploadPitch = surface->pitch;
+            const SDL_PixelFormat textureFormat = texture.tex->format;
+            if (textureFormat != surface->format) {
+                const int convertedPitch = area.w * SDL_BYTESPERPIXEL(textureFormat);
+                if (convertedFormat != textureFormat) {
+                    converted.resize(static_cast<size_t>(convertedPitch) * area.h);
+                    if (!SDL_ConvertPixels(area.w, area.h, surface->format, pixels, surface->pitch,
+                        textureFormat, converted.data(), convertedPitch)) {
+                        SetErrorF("SDLCore::Texture::UpdateFromSurface: Failed to convert pixels for window {}: {}", winID, SDL_GetError());
+                        convertedFormat = SDL_PIXELFORMAT_UNKNOWN;
+                        result = false;
+                        continue;
+                    }
+                    convertedFormat = textureFormat;
+                }
+                uploadPixels = converted.data();
+                uploadPitch = convertedPitch;
+            }
+
+            if (!SDL_UpdateTexture(texture.tex, &area, uploadPixels, uploadPitch)) {
+                SetErrorF("SDLCore::Texture::UpdateFromSurface: Failed to update texture for window {}: {}", winID, SDL_GetError());
+                result = false;
+            }
+        }
+
+        SDL_UnlockSurface(surface);
+        return result;
+    }
+
     void Texture::FreeForWindow(WindowID windowID) {
         auto it = m_textures.find(windowID);
         if (it != m_textures.end()) {
@@ -0,0 +1,368 @@
+#include <limits>
+#include <algorithm>
+#include <cstring>
+#include <SDL3_image/SDL_image.h>
+#include <CoreLib/Log.h>
+
+#include "SDLCoreError.h"
+#include "Types/TextureAtlas.h"
+
+namespace SDLCore {
+
+    #pragma region SubTexture
+
+    SubTexture::SubTexture(std::shared_ptr<Entry> entry)
+        : m_entry(std::move(entry)) {
+    }
+
+    bool SubTexture::IsValid() const {
+        return m_entry && m_entry->page;
+    }
+
+    Texture* SubTexture::GetTexture() const {
+        return (m_entry) ? m_entry->page.get() : nullptr;
+    }
+
+    FRect SubTexture::GetSourceRect() const {
+        return (m_entry) ? m_entry->rect : FRect{ 0, 0, 0, 0 };
+    }
+
+    int SubTexture::GetWidth() const {
+        return (m_entry) ? static_cast<int>(m_entry->rect.w) : 0;
+    }
+
+    int SubTexture::GetHeight() const {
+        return (m_entry) ? static_cast<int>(m_entry->rect.h) : 0;
+    }
+
+    bool SubTexture::Render(float x, float y, float w, float h) const {
+        if (!IsValid()) {
+            SetError("SDLCore::SubTexture::Render: Sub texture is invalid!");
+            return false;
+        }
+
+        const FRect& src = m_entry->rect;
+        if (w <= 0)
+            w = src.w;
+        if (h <= 0)
+            h = src.h;
+
+        return m_entry->page->Render(x, y, w, h, &src);
+    }
+
+    #pragma endregion
+
+    #pragma region TextureAtlas
+
+    TextureAtlas::TextureAtlas(int pageSize, int padding, bool bleed)
+        : m_pageSize((pageSize > 0) ? pageSize : 2048),
+        m_padding((padding > 0) ? padding : 0),
+        m_bleed(bleed) {
+    }
+
+    SubTexture TextureAtlas::Add(const SystemFilePath& path) {
+        std::string name = path.string();
+        auto it = m_entries.find(name);
+        if (it != m_entries.end())
+            return SubTexture(it->second);
+
+        SDL_Surface* surface = IMG_Load(name.c_str());
+        if (!surface) {
+            SetErrorF("SDLCore::TextureAtlas::Add: Failed to load '{}': {}", name, SDL_GetError());
+            return SubTexture();
+        }
+
+        return Add(name, TextureSurface(surface));
+    }
+
+    SubTexture TextureAtlas::Add(const std::string& name, const TextureSurface& surface) {
+        auto it = m_entries.find(name);
+        if (it != m_entries.end())
+            return SubTexture(it->second);
+
+        SDL_Surface* src = surface.GetSurface();
+        if (!src) {
+            SetErrorF("SDLCore::TextureAtlas::Add: Surface of '{}' is invalid!", name);
+            return SubTexture();
+        }
+
+        // all pages use RGBA32, a converted copy is kept for repacking
+        SDL_Surface* converted = SDL_ConvertSurface(src, SDL_PIXELFORMAT_RGBA32);
+        if (!converted) {
+            SetErrorF("SDLCore::TextureAtlas::Add: Failed to convert surface of '{}': {}", name, SDL_GetError());
+            return SubTexture();
+        }
+
+        auto entry = std::make_shared<SubTexture::Entry>();
+        entry->source = TextureSurface(converted);
+
+        if (!Insert(*entry, true)) {
+            AddError(FormatUtils::formatString(" (image '{}')", name));
+            return SubTexture();
+        }
+
+        m_entries[name] = entry;
+        return SubTexture(entry);
+    }
+
+    SubTexture TextureAtlas::Get(const std::string& name) const {
+        auto it = m_entries.find(name);
+        if (it == m_entries.end())
+            return SubTexture();
+        return SubTexture(it->second);
+    }
+
+    bool TextureAtlas::Contains(const std::string& name) const {
+        return m_entries.find(name) != m_entries.end();
+    }
+
+    bool TextureAtlas::Repack() {
+        std::vector<SubTexture::Entry*> entries;
+        entries.reserve(m_entries.size());
+        for (auto& [_, entry] : m_entries)
+            entries.push_back(entry.get());
+
+        // tallest first gives the skyline the flattest profile
+        std::sort(entries.begin(), entries.end(), [](const SubTexture::Entry* a, const SubTexture::Entry* b) {
+            SDL_Surface* sa = a->source.GetSurface();
+            SDL_Surface* sb = b->source.GetSurface();
+            int ha = (sa) ? sa->h : 0;
+            int hb = (sb) ? sb->h : 0;
+            if (ha != hb)
+                return ha > hb;
+            return ((sa) ? sa->w : 0) > ((sb) ? sb->w : 0);
+        });
+
+        m_pages.clear();
+
+        bool result = true;
+        for (auto* entry : entries) {
+            // new pages have no GPU textures yet, they are created from the surface on first use
+            if (!Insert(*entry, false))
+                result = false;
+        }
+
+        return result;
+    }
+
+    void TextureAtlas::Clear() {
+        for (auto& [_, entry] : m_entries) {
+            entry->page.reset();
+            entry->rect = FRect{ 0, 0, 0, 0 };
+        }
+        m_entries.clear();
+        m_pages.clear();
+    }
+
+    size_t TextureAtlas::GetPageCount() const {
+        return m_pages.size();
+    }
+
+    Texture* TextureAtlas::GetPage(size_t index) const {
+        if (index >= m_pages.size())
+            return nullptr;
+        return m_pages[index].texture.get();
+    }
+
+    size_t TextureAtlas::GetImageCount() const {
+        return m_entries.size();
+    }
+
+    float TextureAtlas::GetOccupancy() const {
+        if (m_pages.empty())
+            return 0.0f;
+
+        size_t used = 0;
+        for (auto& page : m_pages)
+            used += page.usedArea;
+
+        double total = static_cast<double>(m_pages.size()) * m_pageSize * m_pageSize;
+        return static_cast<float>(used / total);
+    }
+
+    bool TextureAtlas::Insert(SubTexture::Entry& entry, bool upload) {
+        SDL_Surface* src = entry.source.GetSurface();
+        if (!src) {
+            SetError("SDLCore::TextureAtlas::Insert: Source surface is invalid!");
+            return false;
+        }
+
+        if (src->w <= 0 || src->h <= 0) {
+            SetError("SDLCore::TextureAtlas::Insert: Image is empty!");
+            return false;
+        }
+
+        int w = src->w + m_padding * 2;
+        int h = src->h + m_padding * 2;
+        if (w > m_pageSize || h > m_pageSize) {
+            SetErrorF("SDLCore::TextureAtlas::Insert: Image of size {}x{} does not fit into a page of size {}",
+                src->w, src->h, m_pageSize);
+            return false;
+        }
+
+        size_t pageIndex = m_pages.size();
+        int x = 0, y = 0;
+        size_t node = 0;
+
+        for (size_t i = 0; i < m_pages.size(); i++) {
+            if (FindPosition(m_pages[i], w, h, x, y, node)) {
+                pageIndex = i;
+                break;
+            }
+        }
+
+        if (pageIndex == m_pages.size()) {
+            if (!CreatePage())
+                return false;
+            if (!FindPosition(m_pages.back(), w, h, x, y, node)) {
+                SetError("SDLCore::TextureAtlas::Insert: Failed to place image in a new page!");
+                return false;
+            }
+        }
+
+        Page& page = m_pages[pageIndex];
+        AddSkylineLevel(page, node, x, y, w, h);
+        page.usedArea += static_cast<size_t>(w) * h;
+
+        CopyPixels(page, src, x + m_padding, y + m_padding);
+
+        entry.page = page.texture;
+        entry.pageIndex = pageIndex;
+        entry.rect = FRect{
+            static_cast<float>(x + m_padding),
+            static_cast<float>(y + m_padding),
+            static_cast<float>(src->w),
+            static_cast<float>(src->h)
+        };
+
+        if (upload) {
+            Rect area{ x, y, w, h };
+            if (!page.texture->UpdateFromSurface(&area))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool TextureAtlas::FindPosition(const Page& page, int w, int h, int& outX, int& outY, size_t& outNode) const {
+        int bestBottom = std::numeric_limits<int>::max();
+        int bestWidth = std::numeric_limits<int>::max();
+        bool found = false;
+
+        const auto& skyline = page.skyline;
+        for (size_t i = 0; i < skyline.size(); i++) {
+            int x = skyline[i].x;
+            if (x + w > m_pageSize)
+                break;
+
+            // highest level under the rect decides the y position
+            int y = skyline[i].y;
+            int widthLeft = w;
+            size_t j = i;
+            while (widthLeft > 0 && j < skyline.size()) {
+                y = std::max(y, skyline[j].y);
+                widthLeft -= skyline[j].w;
+                j++;
+            }
+
+            if (widthLeft > 0 || y + h > m_pageSize)
+                continue;
+
+            int bottom = y + h;
+            if (bottom < bestBottom || (bottom == bestBottom && skyline[i].w < bestWidth)) {
+                bestBottom = bottom;
+                bestWidth = skyline[i].w;
+                outX = x;
+                outY = y;
+                outNode = i;
+                found = true;
+            }
+        }
+
+        return found;
+    }
+
+    void TextureAtlas::AddSkylineLevel(Page& page, size_t nodeIndex, int x, int y, int w, int h) {
+        auto& skyline = page.skyline;
+        skyline.insert(skyline.begin() + nodeIndex, SkylineNode{ x, y + h, w });
+
+        // shrink or remove the nodes covered by the new level
+        for (size_t i = nodeIndex + 1; i < skyline.size(); ) {
+            const SkylineNode& prev = skyline[i - 1];
+            SkylineNode& node = skyline[i];
+
+            int prevRight = prev.x + prev.w;
+            if (node.x >= prevRight)
+                break;
+
+            int shrink = prevRight - node.x;
+            node.x += shrink;
+            node.w -= shrink;
+
+            if (node.w > 0)
+                break;
+            skyline.erase(skyline.begin() + i);
+        }
+
+        // merge neighbours on the same level
+        for (size_t i = 0; i + 1 < skyline.size(); ) {
+            if (skyline[i].y == skyline[i + 1].y) {
+                skyline[i].w += skyline[i + 1].w;
+                skyline.erase(skyline.begin() + i + 1);
+            }
+            else {
+                i++;
+            }
+        }
+    }
+
+    bool TextureAtlas::CreatePage() {
+        SDL_Surface* surface = SDL_CreateSurface(m_pageSize, m_pageSize, SDL_PIXELFORMAT_RGBA32);
+        if (!surface) {
+            SetErrorF("SDLCore::TextureAtlas::CreatePage: Failed to create page surface: {}", SDL_GetError());
+            return false;
+        }
+        // new surfaces are zero initialized, fully transparent
+
+        Page page;
+        page.surface = surface;
+        page.texture = std::make_shared<Texture>(TextureSurface(surface));
+        page.skyline.push_back(SkylineNode{ 0, 0, m_pageSize });
+        m_pages.push_back(std::move(page));
+        return true;
+    }
+
+    void TextureAtlas::CopyPixels(Page& page, SDL_Surface* src, int x, int y) {
+        SDL_Surface* dst = page.surface;
+        if (!SDL_LockSurface(dst))
+            return;
+        if (!SDL_LockSurface(src)) {
+            SDL_UnlockSurface(dst);
+            return;
+        }
+
+        constexpr int BPP = 4;// RGBA32
+        const int w = src->w;
+        const int h = src->h;
+        const int bleed = (m_bleed) ? m_padding : 0;
+
+        for (int row = -bleed; row < h + bleed; row++) {
+            int srcRow = std::clamp(row, 0, h - 1);
+            const Uint8* srcLine = static_cast<const Uint8*>(src->pixels) + srcRow * src->pitch;
+            Uint8* dstLine = static_cast<Uint8*>(dst->pixels) + (y + row) * dst->pitch + x * BPP;
+
+            std::memcpy(dstLine, srcLine, static_cast<size_t>(w) * BPP);
+
+            for (int i = 1; i <= bleed; i++) {
+                std::memcpy(dstLine - i * BPP, srcLine, BPP);
+                std::memcpy(dstLine + (w - 1 + i) * BPP, srcLine + (w - 1) * BPP, BPP);
+            }
+        }
+
+        SDL_UnlockSurface(src);
+        SDL_UnlockSurface(dst);
+    }
+
+    #pragma endregion
+
+}
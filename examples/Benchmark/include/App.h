@@ -0,0 +1,53 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <SDLCoreLib/SDLCore.h>
+
+#include "BenchmarkScenes.h"
+
+struct BenchmarkOptions {
+	int frames = 300;
+	int warmupFrames = 30;
+	int width = 1280;
+	int height = 720;
+	std::string scene;		// empty = all scenes
+	std::string goldenDir;	// empty = no golden images
+	std::string csvPath;	// empty = no csv output
+	bool windowed = false;
+	bool batching = false;
+	bool culling = false;
+
+	/**
+	* @brief Parses the command line, unknown arguments are reported and ignored.
+	*/
+	static BenchmarkOptions Parse(int argc, char* argv[]);
+	static void PrintUsage();
+};
+
+class App : public SDLCore::Application {
+public:
+	App(const BenchmarkOptions& options);
+
+	void OnStart() override;
+	void OnUpdate() override;
+	void OnQuit() override;
+
+private:
+	struct SceneResult {
+		std::string name;
+		std::vector<uint64_t> frameTimesNS;
+	};
+
+	BenchmarkOptions m_options;
+	SDLCore::WindowID m_winID;
+
+	std::vector<std::unique_ptr<BenchmarkScene>> m_scenes;
+	std::vector<SceneResult> m_results;
+	size_t m_sceneIndex = 0;
+	int m_frame = 0;
+
+	void FinishScene();
+	void PrintResults() const;
+	void WriteCSV() const;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <SDLCoreLib/SDLCore.h>
+
+/**
+* @brief Fixed workload that is drawn once per benchmark frame.
+*
+* Scenes are deterministic (fixed seed, animation only depends on the frame index),
+* so the same frame always produces the same image.
+*/
+class BenchmarkScene {
+public:
+	virtual ~BenchmarkScene() = default;
+
+	virtual const char* GetName() const = 0;
+
+	/**
+	* @brief Creates the scene data, called once before the first frame.
+	*/
+	virtual void Init(int width, int height) = 0;
+
+	/**
+	* @brief Draws the scene to the active window renderer.
+	*/
+	virtual void Draw(uint64_t frame) = 0;
+};
+
+/**
+* @brief Creates all benchmark scenes in their default order.
+*/
+std::vector<std::unique_ptr<BenchmarkScene>> CreateBenchmarkScenes();
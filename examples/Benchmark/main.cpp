@@ -0,0 +1,24 @@
+#include <CoreLib/Log.h>
+#include <SDLCoreLib/SDLCore.h>
+#include <SDL3/SDL_main.h>
+
+#include "App.h"
+
+int main(int argc, char* argv[]) {
+	BenchmarkOptions options = BenchmarkOptions::Parse(argc, argv);
+
+	// has to be set before the application initializes SDL
+	SDLCore::Application::SetHeadless(!options.windowed);
+
+	App* app = new App(options);
+	SDLCore::ApplicationResult result = app->Start();
+
+	std::string msg = SDLCore::GetError(result);
+	if(result == 0)
+		Log::Info(msg);
+	else
+		Log::Error(msg);
+
+	delete app;
+	return result;
+}
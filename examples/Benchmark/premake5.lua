@@ -0,0 +1,44 @@
+project "Benchmark"
+    language "C++"
+    cppdialect "C++17"
+    staticruntime "On"
+
+    SetTargetAndObjDirs("%{prj.name}")
+
+    files {
+        "src/**.cpp",
+        "src/**.c",
+        "include/**.h",
+        "include/**.hpp",
+        "main.cpp"
+    }
+
+    includedirs {
+        "include",
+        "include/%{prj.name}",
+        "%{wks.location}/SDLCoreLib/include",
+        "%{wks.location}/CoreLib/include"
+    }
+
+    links {
+        "CoreLib",
+        "SDLCoreLib"
+    }
+    
+    IncludeSDLCoreLib()
+    -- copys the SDL DLLs in to the build path of this project
+    CopySDLDLLs()
+
+    ApplyCommonConfigs()
+
+    filter "configurations:Debug"
+        kind "ConsoleApp"
+
+    filter "configurations:Release"
+        kind "ConsoleApp"
+
+    -- results are printed to the console in every configuration
+    filter "configurations:Distribution"
+        kind "ConsoleApp"
+
+    filter {}
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <SDL3/SDL.h>
+#include <CoreLib/Log.h>
+#include "App.h"
+
+// ========== Options ==========
+
+static bool ReadIntArg(int argc, char* argv[], int& i, int& out) {
+    if (i + 1 >= argc)
+        return false;
+    out = std::atoi(argv[++i]);
+    return true;
+}
+
+static bool ReadStringArg(int argc, char* argv[], int& i, std::string& out) {
+    if (i + 1 >= argc)
+        return false;
+    out = argv[++i];
+    return true;
+}
+
+BenchmarkOptions BenchmarkOptions::Parse(int argc, char* argv[]) {
+    BenchmarkOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool ok = true;
+
+        if (std::strcmp(arg, "--frames") == 0)
+            ok = ReadIntArg(argc, argv, i, options.frames);
+        else if (std::strcmp(arg, "--warmup") == 0)
+            ok = ReadIntArg(argc, argv, i, options.warmupFrames);
+        else if (std::strcmp(arg, "--width") == 0)
+            ok = ReadIntArg(argc, argv, i, options.width);
+        else if (std::strcmp(arg, "--height") == 0)
+            ok = ReadIntArg(argc, argv, i, options.height);
+        else if (std::strcmp(arg, "--scene") == 0)
+            ok = ReadStringArg(argc, argv, i, options.scene);
+        else if (std::strcmp(arg, "--golden") == 0)
+            ok = ReadStringArg(argc, argv, i, options.goldenDir);
+        else if (std::strcmp(arg, "--csv") == 0)
+            ok = ReadStringArg(argc, argv, i, options.csvPath);
+        else if (std::strcmp(arg, "--windowed") == 0)
+            options.windowed = true;
+        else if (std::strcmp(arg, "--batch") == 0)
+            options.batching = true;
+        else if (std::strcmp(arg, "--cull") == 0)
+            options.culling = true;
+        else if (std::strcmp(arg, "--help") == 0) {
+            PrintUsage();
+            std::exit(0);
+        }
+        else
+            Log::Warn("Benchmark: Unknown argument '{}' is ignored", arg);
+
+        if (!ok)
+            Log::Warn("Benchmark: Missing value for argument '{}'", arg);
+    }
+
+    options.frames = std::max(options.frames, 1);
+    options.warmupFrames = std::max(options.warmupFrames, 0);
+    options.width = std::max(options.width, 1);
+    options.height = std::max(options.height, 1);
+    return options;
+}
+
+void BenchmarkOptions::PrintUsage() {
+    Log::Print("Usage: Benchmark [options]");
+    Log::Print("  --frames N      measured frames per scene (default 300)");
+    Log::Print("  --warmup N      frames drawn before measuring (default 30)");
+    Log::Print("  --width N       window width (default 1280)");
+    Log::Print("  --height N      window height (default 720)");
+    Log::Print("  --scene NAME    only run this scene (rects, sprites, text, lines, polygons)");
+    Log::Print("  --golden DIR    saves the last frame of every scene as DIR/<scene>.png");
+    Log::Print("  --csv FILE      writes the results as csv");
+    Log::Print("  --windowed      uses a real window and the default renderer instead of the headless mode");
+    Log::Print("  --batch         enables the batched render mode");
+    Log::Print("  --cull          enables viewport culling");
+}
+
+// ========== App ==========
+
+App::App(const BenchmarkOptions& options)
+    : Application("Benchmark", SDLCore::Version(1, 0)), m_options(options) {
+}
+
+void App::OnStart() {
+    SetFPSCap(APPLICATION_FPS_UNCAPPED);
+    SDLCore::Window* win = CreateWindow(&m_winID, "Benchmark", m_options.width, m_options.height);
+    if (!win || !win->HasRenderer()) {
+        Log::Error("Benchmark: Failed to create window: {}", SDLCore::GetError());
+        Quit();
+        return;
+    }
+
+    namespace RE = SDLCore::Render;
+    RE::SetWindowRenderer(m_winID);
+    RE::SetBatchingEnabled(m_options.batching);
+    RE::SetCullingEnabled(m_options.culling);
+
+    for (auto& scene : CreateBenchmarkScenes()) {
+        if (!m_options.scene.empty() && m_options.scene != scene->GetName())
+            continue;
+        scene->Init(m_options.width, m_options.height);
+        m_scenes.push_back(std::move(scene));
+    }
+
+    if (m_scenes.empty()) {
+        Log::Error("Benchmark: No scene named '{}'", m_options.scene);
+        Quit();
+        return;
+    }
+
+    Log::Info("Benchmark: {} scene(s), {} warmup + {} measured frames, {}x{}, driver '{}'{}{}",
+        m_scenes.size(), m_options.warmupFrames, m_options.frames, m_options.width, m_options.height,
+        SDL_GetRendererName(RE::GetActiveRenderer()),
+        (m_options.batching) ? ", batched" : "",
+        (m_options.culling) ? ", culled" : "");
+}
+
+void App::OnUpdate() {
+    if (m_winID.IsInvalid() || m_sceneIndex >= m_scenes.size()) {
+        Quit();
+        return;
+    }
+
+    namespace RE = SDLCore::Render;
+    BenchmarkScene& scene = *m_scenes[m_sceneIndex];
+
+    const int totalFrames = m_options.warmupFrames + m_options.frames;
+    const bool measured = m_frame >= m_options.warmupFrames;
+    const bool lastFrame = m_frame + 1 >= totalFrames;
+
+    if (m_results.size() <= m_sceneIndex) {
+        SceneResult result;
+        result.name = scene.GetName();
+        result.frameTimesNS.reserve(m_options.frames);
+        m_results.push_back(std::move(result));
+    }
+
+    uint64_t start = SDL_GetTicksNS();
+    RE::SetWindowRenderer(m_winID);
+    RE::SetColor(0);
+    RE::Clear();
+    scene.Draw(static_cast<uint64_t>(m_frame));
+    RE::FlushBatch();
+    uint64_t drawTime = SDL_GetTicksNS() - start;
+
+    // reading back the frame is not part of the measurement
+    if (lastFrame && !m_options.goldenDir.empty()) {
+        std::string path = m_options.goldenDir + "/" + scene.GetName() + ".png";
+        if (!RE::SaveFrame(path))
+            Log::Error("Benchmark: {}", SDLCore::GetError());
+    }
+
+    start = SDL_GetTicksNS();
+    RE::Present();
+    uint64_t presentTime = SDL_GetTicksNS() - start;
+
+    if (measured)
+        m_results[m_sceneIndex].frameTimesNS.push_back(drawTime + presentTime);
+
+    m_frame++;
+    if (lastFrame)
+        FinishScene();
+}
+
+void App::OnQuit() {
+    PrintResults();
+    WriteCSV();
+}
+
+void App::FinishScene() {
+    m_frame = 0;
+    m_sceneIndex++;
+    if (m_sceneIndex >= m_scenes.size())
+        Quit();
+}
+
+struct FrameStats {
+    double avg = 0, min = 0, p50 = 0, p90 = 0, p95 = 0, p99 = 0, max = 0;
+};
+
+static double Percentile(const std::vector<uint64_t>& sorted, double p) {
+    if (sorted.empty())
+        return 0;
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)] / 1'000'000.0;
+}
+
+static FrameStats CalculateStats(std::vector<uint64_t> times) {
+    FrameStats stats;
+    if (times.empty())
+        return stats;
+
+    std::sort(times.begin(), times.end());
+    double sum = std::accumulate(times.begin(), times.end(), 0.0);
+    stats.avg = sum / times.size() / 1'000'000.0;
+    stats.min = times.front() / 1'000'000.0;
+    stats.p50 = Percentile(times, 0.50);
+    stats.p90 = Percentile(times, 0.90);
+    stats.p95 = Percentile(times, 0.95);
+    stats.p99 = Percentile(times, 0.99);
+    stats.max = times.back() / 1'000'000.0;
+    return stats;
+}
+
+void App::PrintResults() const {
+    if (m_results.empty())
+        return;
+
+    char line[256];
+    Log::Print("");
+    Log::Print("CPU frame time in ms ({} measured frames)", m_options.frames);
+    std::snprintf(line, sizeof(line), "%-10s %9s %9s %9s %9s %9s %9s %9s",
+        "scene", "avg", "min", "p50", "p90", "p95", "p99", "max");
+    Log::Print(line);
+
+    for (const auto& result : m_results) {
+        FrameStats s = CalculateStats(result.frameTimesNS);
+        std::snprintf(line, sizeof(line), "%-10s %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f",
+            result.name.c_str(), s.avg, s.min, s.p50, s.p90, s.p95, s.p99, s.max);
+        Log::Print(line);
+    }
+}
+
+void App::WriteCSV() const {
+    if (m_options.csvPath.empty() || m_results.empty())
+        return;
+
+    std::ofstream file(m_options.csvPath);
+    if (!file) {
+        Log::Error("Benchmark: Failed to open '{}'", m_options.csvPath);
+        return;
+    }
+
+    file << "scene,frames,avg_ms,min_ms,p50_ms,p90_ms,p95_ms,p99_ms,max_ms\n";
+    for (const auto& result : m_results) {
+        FrameStats s = CalculateStats(result.frameTimesNS);
+        file << result.name << ',' << result.frameTimesNS.size() << ','
+            << s.avg << ',' << s.min << ',' << s.p50 << ',' << s.p90 << ','
+            << s.p95 << ',' << s.p99 << ',' << s.max << '\n';
+    }
+}
@@ -0,0 +1,317 @@
+#include <cmath>
+#include <cstdio>
+#include <SDL3/SDL.h>
+#include <CoreLib/Math/Vector2.h>
+#include <CoreLib/Math/Vector4.h>
+#include "BenchmarkScenes.h"
+
+namespace RE = SDLCore::Render;
+
+namespace {
+
+    constexpr float PI = 3.14159265f;
+
+    // small deterministic generator, the same seed gives the same scene on every platform
+    class Random {
+    public:
+        Random(uint32_t seed) : m_state(seed ? seed : 1) {}
+
+        uint32_t Next() {
+            m_state ^= m_state << 13;
+            m_state ^= m_state >> 17;
+            m_state ^= m_state << 5;
+            return m_state;
+        }
+
+        float Range(float min, float max) {
+            return min + (Next() & 0xFFFFFF) / static_cast<float>(0xFFFFFF) * (max - min);
+        }
+
+        Uint8 Byte() {
+            return static_cast<Uint8>(Next() & 0xFF);
+        }
+
+    private:
+        uint32_t m_state;
+    };
+
+    struct ColoredRect {
+        Vector4 rect;
+        Vector2 velocity;
+        SDL_Color color;
+    };
+
+    // moves back and forth inside [0, size - extent], only depends on the frame index
+    float Bounce(float start, float velocity, uint64_t frame, float size, float extent) {
+        float range = std::max(size - extent, 1.0f);
+        float pos = std::fmod(start + velocity * static_cast<float>(frame), range * 2.0f);
+        if (pos < 0)
+            pos += range * 2.0f;
+        return (pos > range) ? range * 2.0f - pos : pos;
+    }
+
+    // ========== 10k filled rects ==========
+
+    class RectScene : public BenchmarkScene {
+    public:
+        const char* GetName() const override { return "rects"; }
+
+        void Init(int width, int height) override {
+            m_width = static_cast<float>(width);
+            m_height = static_cast<float>(height);
+
+            Random random(1);
+            m_rects.resize(10000);
+            for (auto& r : m_rects) {
+                float w = random.Range(4, 32);
+                float h = random.Range(4, 32);
+                r.rect = Vector4(random.Range(0, m_width - w), random.Range(0, m_height - h), w, h);
+                r.velocity = Vector2(random.Range(-3, 3), random.Range(-3, 3));
+                r.color = SDL_Color{ random.Byte(), random.Byte(), random.Byte(), 255 };
+            }
+        }
+
+        void Draw(uint64_t frame) override {
+            for (const auto& r : m_rects) {
+                RE::SetColor(r.color.r, r.color.g, r.color.b, r.color.a);
+                RE::FillRect(
+                    Bounce(r.rect.x, r.velocity.x, frame, m_width, r.rect.z),
+                    Bounce(r.rect.y, r.velocity.y, frame, m_height, r.rect.w),
+                    r.rect.z, r.rect.w);
+            }
+        }
+
+    private:
+        float m_width = 0;
+        float m_height = 0;
+        std::vector<ColoredRect> m_rects;
+    };
+
+    // ========== 5k textured sprites ==========
+
+    class SpriteScene : public BenchmarkScene {
+    public:
+        const char* GetName() const override { return "sprites"; }
+
+        void Init(int width, int height) override {
+            m_width = static_cast<float>(width);
+            m_height = static_cast<float>(height);
+
+            // procedural checker texture, the benchmark does not depend on asset files
+            constexpr int SIZE = 32;
+            SDL_Surface* surface = SDL_CreateSurface(SIZE, SIZE, SDL_PIXELFORMAT_RGBA32);
+            if (surface) {
+                const SDL_PixelFormatDetails* format = SDL_GetPixelFormatDetails(surface->format);
+                for (int y = 0; y < SIZE; y++) {
+                    Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + y * surface->pitch);
+                    for (int x = 0; x < SIZE; x++) {
+                        bool checker = ((x / 8) + (y / 8)) % 2 == 0;
+                        Uint8 a = (x == 0 || y == 0 || x == SIZE - 1 || y == SIZE - 1) ? 128 : 255;
+                        row[x] = (checker)
+                            ? SDL_MapRGBA(format, nullptr, 240, 200, 60, a)
+                            : SDL_MapRGBA(format, nullptr, 60, 120, 240, a);
+                    }
+                }
+                m_texture = std::make_unique<SDLCore::Texture>(SDLCore::TextureSurface(surface));
+            }
+
+            Random random(2);
+            m_sprites.resize(5000);
+            for (auto& s : m_sprites) {
+                float size = random.Range(12, 48);
+                s.rect = Vector4(random.Range(0, m_width - size), random.Range(0, m_height - size), size, size);
+                s.velocity = Vector2(random.Range(-2, 2), random.Range(-2, 2));
+            }
+        }
+
+        void Draw(uint64_t frame) override {
+            if (!m_texture)
+                return;
+
+            for (const auto& s : m_sprites) {
+                RE::Texture(*m_texture,
+                    Bounce(s.rect.x, s.velocity.x, frame, m_width, s.rect.z),
+                    Bounce(s.rect.y, s.velocity.y, frame, m_height, s.rect.w),
+                    s.rect.z, s.rect.w);
+            }
+        }
+
+    private:
+        float m_width = 0;
+        float m_height = 0;
+        std::unique_ptr<SDLCore::Texture> m_texture;
+        std::vector<ColoredRect> m_sprites;
+    };
+
+    // ========== 2k text lines ==========
+
+    class TextScene : public BenchmarkScene {
+    public:
+        const char* GetName() const override { return "text"; }
+
+        void Init(int width, int height) override {
+            m_width = static_cast<float>(width);
+            m_height = static_cast<float>(height);
+
+            static const char* words[] = {
+                "render", "batch", "glyph", "atlas", "frame", "layer", "vertex", "texture",
+                "quick", "brown", "fox", "jumps", "over", "the", "lazy", "dog"
+            };
+
+            Random random(3);
+            m_lines.resize(2000);
+            for (size_t i = 0; i < m_lines.size(); i++) {
+                char prefix[16];
+                std::snprintf(prefix, sizeof(prefix), "%04zu ", i);
+                std::string line = prefix;
+                int wordCount = 3 + static_cast<int>(random.Next() % 6);
+                for (int w = 0; w < wordCount; w++) {
+                    line += words[random.Next() % (sizeof(words) / sizeof(words[0]))];
+                    line += ' ';
+                }
+                m_lines[i] = line;
+            }
+        }
+
+        void Draw(uint64_t frame) override {
+            constexpr float LINE_HEIGHT = 16.0f;
+            constexpr float COLUMN_WIDTH = 320.0f;
+
+            RE::SetTextSize(14);
+            RE::SetColor(230, 230, 230, 255);
+
+            int columns = std::max(static_cast<int>(m_width / COLUMN_WIDTH), 1);
+            int rows = std::max(static_cast<int>(m_height / LINE_HEIGHT), 1);
+            float scroll = static_cast<float>(frame % static_cast<uint64_t>(rows));
+
+            for (size_t i = 0; i < m_lines.size(); i++) {
+                int column = static_cast<int>(i) % columns;
+                int row = (static_cast<int>(i) / columns + static_cast<int>(scroll)) % rows;
+                RE::Text(m_lines[i], column * COLUMN_WIDTH + 4.0f, row * LINE_HEIGHT);
+            }
+        }
+
+    private:
+        float m_width = 0;
+        float m_height = 0;
+        std::vector<std::string> m_lines;
+    };
+
+    // ========== thick lines and polylines ==========
+
+    class LineScene : public BenchmarkScene {
+    public:
+        const char* GetName() const override { return "lines"; }
+
+        void Init(int width, int height) override {
+            m_width = static_cast<float>(width);
+            m_height = static_cast<float>(height);
+
+            Random random(4);
+            m_lines.resize(2000);
+            for (auto& l : m_lines) {
+                l.rect = Vector4(random.Range(0, m_width), random.Range(0, m_height),
+                    random.Range(0, m_width), random.Range(0, m_height));
+                l.velocity = Vector2(random.Range(-2, 2), random.Range(-2, 2));
+                l.color = SDL_Color{ random.Byte(), random.Byte(), random.Byte(), 255 };
+            }
+
+            m_polylines.resize(200);
+            for (auto& points : m_polylines) {
+                Vector2 p(random.Range(0, m_width), random.Range(0, m_height));
+                points.resize(10);
+                for (auto& point : points) {
+                    point = p;
+                    p.x += random.Range(-40, 40);
+                    p.y += random.Range(-40, 40);
+                }
+            }
+        }
+
+        void Draw(uint64_t frame) override {
+            RE::SetStrokeWidth(4);
+            for (const auto& l : m_lines) {
+                float offset = std::sin(static_cast<float>(frame) * 0.05f) * 20.0f;
+                RE::SetColor(l.color.r, l.color.g, l.color.b, l.color.a);
+                RE::Line(l.rect.x + l.velocity.x * offset, l.rect.y + l.velocity.y * offset, l.rect.z, l.rect.w);
+            }
+
+            RE::SetStrokeWidth(3);
+            RE::SetLineJoin(RE::LineJoin::MITER);
+            RE::SetColor(255, 255, 255, 255);
+            for (size_t i = 0; i < m_polylines.size(); i++)
+                RE::Polyline(m_polylines[i], (i % 4) == 0);
+
+            RE::SetStrokeWidth(1);
+        }
+
+    private:
+        float m_width = 0;
+        float m_height = 0;
+        std::vector<ColoredRect> m_lines;
+        std::vector<std::vector<Vector2>> m_polylines;
+    };
+
+    // ========== indexed polygons ==========
+
+    class PolygonScene : public BenchmarkScene {
+    public:
+        const char* GetName() const override { return "polygons"; }
+
+        void Init(int width, int height) override {
+            m_width = static_cast<float>(width);
+            m_height = static_cast<float>(height);
+
+            // hexagon fan around the origin
+            constexpr int SIDES = 6;
+            constexpr float RADIUS = 12.0f;
+            m_vertices.emplace_back(0.0f, 0.0f, 255.0f, 255.0f, 255.0f, 255.0f);
+            for (int i = 0; i < SIDES; i++) {
+                float angle = i * 2.0f * PI / SIDES;
+                m_vertices.emplace_back(std::cos(angle) * RADIUS, std::sin(angle) * RADIUS, 255.0f, 255.0f, 255.0f, 255.0f);
+                m_indices.push_back(0);
+                m_indices.push_back(1 + i);
+                m_indices.push_back(1 + (i + 1) % SIDES);
+            }
+
+            Random random(5);
+            m_polygons.resize(2000);
+            for (auto& p : m_polygons) {
+                float scale = random.Range(0.5f, 2.0f);
+                p.rect = Vector4(random.Range(0, m_width), random.Range(0, m_height), scale, scale);
+                p.velocity = Vector2(random.Range(-2, 2), random.Range(-2, 2));
+                p.color = SDL_Color{ random.Byte(), random.Byte(), random.Byte(), 200 };
+            }
+        }
+
+        void Draw(uint64_t frame) override {
+            RE::SetBlendMode(true);
+            for (const auto& p : m_polygons) {
+                RE::SetColor(p.color.r, p.color.g, p.color.b, p.color.a);
+                RE::Polygon(m_vertices.data(), m_vertices.size(), nullptr,
+                    m_indices.data(), m_indices.size(),
+                    Bounce(p.rect.x, p.velocity.x, frame, m_width, 0),
+                    Bounce(p.rect.y, p.velocity.y, frame, m_height, 0),
+                    p.rect.z, p.rect.w);
+            }
+        }
+
+    private:
+        float m_width = 0;
+        float m_height = 0;
+        std::vector<SDLCore::Vertex> m_vertices;
+        std::vector<int> m_indices;
+        std::vector<ColoredRect> m_polygons;
+    };
+
+}
+
+std::vector<std::unique_ptr<BenchmarkScene>> CreateBenchmarkScenes() {
+    std::vector<std::unique_ptr<BenchmarkScene>> scenes;
+    scenes.push_back(std::make_unique<RectScene>());
+    scenes.push_back(std::make_unique<SpriteScene>());
+    scenes.push_back(std::make_unique<TextScene>());
+    scenes.push_back(std::make_unique<LineScene>());
+    scenes.push_back(std::make_unique<PolygonScene>());
+    return scenes;
+}
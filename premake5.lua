@@ -74,6 +74,13 @@ group "Examples"
     include "examples/Tetris"
     include "examples/Pong"
     include "examples/Template"
+    include "examples/Benchmark"
+
+------------------------------------
+-- Tools Includes
+------------------------------------
+group "Tools"
+    include "tools/AssetPacker"
 
 -- Restore default group
 group ""
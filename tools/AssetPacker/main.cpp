@@ -0,0 +1,95 @@
+#include <cstring>
+#include <string>
+#include <CoreLib/Log.h>
+#include <SDLCoreLib/SDLCore.h>
+#include <SDL3/SDL_main.h>
+
+/*
+* Packs a directory into a single asset pack that can be opened with SDLCore::AssetPack.
+* Entry names are the file paths relative to the input directory
+*/
+
+static void PrintUsage() {
+	Log::Print("Usage: AssetPacker <input dir> <output pack> [options]");
+	Log::Print("  --compress      compresses entries that get smaller (text, shaders, raw data, ...)");
+	Log::Print("  --verify        opens the written pack and checks every entry");
+	Log::Print("  --list          prints every entry of the written pack");
+	Log::Print("  --help          prints this message");
+}
+
+int main(int argc, char* argv[]) {
+	std::string inputDir;
+	std::string outputPath;
+	bool compress = false;
+	bool verify = false;
+	bool list = false;
+
+	for (int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+
+		if (std::strcmp(arg, "--compress") == 0)
+			compress = true;
+		else if (std::strcmp(arg, "--verify") == 0)
+			verify = true;
+		else if (std::strcmp(arg, "--list") == 0)
+			list = true;
+		else if (std::strcmp(arg, "--help") == 0) {
+			PrintUsage();
+			return 0;
+		}
+		else if (arg[0] == '-')
+			Log::Warn("AssetPacker: Unknown argument '{}' is ignored", arg);
+		else if (inputDir.empty())
+			inputDir = arg;
+		else if (outputPath.empty())
+			outputPath = arg;
+		else
+			Log::Warn("AssetPacker: Argument '{}' is ignored", arg);
+	}
+
+	if (inputDir.empty() || outputPath.empty()) {
+		PrintUsage();
+		return 1;
+	}
+
+	SDLCore::AssetPackWriter writer;
+	if (!writer.AddDirectory(inputDir, compress)) {
+		Log::Error("AssetPacker: {}", SDLCore::GetError());
+		return 1;
+	}
+
+	if (!writer.Write(outputPath)) {
+		Log::Error("AssetPacker: {}", SDLCore::GetError());
+		return 1;
+	}
+
+	Log::Info("AssetPacker: Wrote {} entries to '{}' ({} bytes stored, {} bytes original)",
+		writer.GetEntryCount(), outputPath, writer.GetStoredSize(), writer.GetOriginalSize());
+
+	if (!verify && !list)
+		return 0;
+
+	SDLCore::AssetPack pack;
+	if (!pack.Open(outputPath)) {
+		Log::Error("AssetPacker: {}", SDLCore::GetError());
+		return 1;
+	}
+
+	if (list) {
+		for (size_t i = 0; i < pack.GetEntryCount(); i++) {
+			std::string path(pack.GetEntryPath(i));
+			Log::Print("  {} ({} bytes{})", path, pack.GetEntrySize(path),
+				(pack.IsCompressed(path)) ? ", compressed" : "");
+		}
+	}
+
+	if (verify) {
+		if (!pack.VerifyAll()) {
+			Log::Error("AssetPacker: '{}' is corrupted", outputPath);
+			return 1;
+		}
+		Log::Info("AssetPacker: Verified {} entries", pack.GetEntryCount());
+	}
+
+	return 0;
+}